@@ -0,0 +1,46 @@
+#pragma once
+
+#include "youtube-chat-client.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+enum class AmountModel {
+    Tiers,      // Weighted Super Chat price tiers (most donations are small)
+    LogNormal   // Continuous, median ~500 JPY with a long tail
+};
+
+struct StormOptions {
+    double durationSeconds = 30.0;
+    double eventsPerSecond = 20.0;      // Poisson base rate
+    double raidEverySeconds = 0.0;      // 0 = no raids
+    double raidMultiplier = 10.0;       // Rate multiplier while a raid lasts
+    double raidSeconds = 3.0;
+    double stickerRatio = 0.1;          // Fraction of events that are Super Stickers
+    AmountModel amountModel = AmountModel::Tiers;
+    uint64_t seed = 1;
+};
+
+struct StormArrival {
+    double atSeconds;   // Offset from the start of the run
+    DonationEvent event;
+};
+
+// Produces a reproducible donation schedule for a given seed: a Poisson process whose
+// rate steps up during periodic raids, with realistic amounts.
+class DonationStormGenerator {
+public:
+    explicit DonationStormGenerator(const StormOptions& options);
+
+    std::vector<StormArrival> Generate();
+
+    // Rate in effect at time t (base rate, or base * multiplier inside a raid)
+    double RateAt(double seconds) const;
+
+private:
+    double NextAmount();
+    bool InRaid(double seconds) const;
+
+    StormOptions m_options;
+    std::mt19937_64 m_randomEngine;
+};
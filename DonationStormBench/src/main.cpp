@@ -0,0 +1,724 @@
+#include "storm-generator.hpp"
+#include "chat-ingestion-hub.hpp"
+#include "mock-youtube-server.hpp"
+#include "obstruction-manager.hpp"
+#include "effect-config.hpp"
+#include "free-chat-sampler.hpp"
+#include "keyword-trigger.hpp"
+#include "latency-histogram.hpp"
+#include "obs-stub.hpp"
+#include "obs-call-scope.hpp"
+#include "plugin-log.hpp"
+#include "plugin-metrics.hpp"
+#include "tween.hpp"
+#include <util/platform.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+#include "obs-call-profiler.hpp"     // Keep last
+
+static const char* MAIN_SOURCE_NAME = "Game Capture";
+
+// Keyword benchmark: keywords are spread over configurations of this size
+static const int KEYWORDS_PER_CONFIG = 100;
+static const double KEYWORD_MESSAGE_RATIO = 0.05;   // Messages that contain a keyword
+
+// Tween benchmark: frames timed per tween count, and how many tweens are retargeted per frame
+static const int TWEEN_BENCH_FRAMES = 600;
+static const double TWEEN_RETARGET_RATIO = 0.01;
+
+// Sampler benchmark: kept positions are reported per tenth of a page
+static const size_t SAMPLER_POSITION_BINS = 10;
+
+// Times every timer event except the arrival pump: effect frames, tweens, fades and expiry
+class BenchApplication : public QCoreApplication {
+public:
+    BenchApplication(int& argc, char** argv) : QCoreApplication(argc, argv) {}
+
+    bool notify(QObject* receiver, QEvent* event) override {
+        if (event->type() != QEvent::Timer || receiver == pumpTimer) {
+            return QCoreApplication::notify(receiver, event);
+        }
+
+        uint64_t start = os_gettime_ns();
+        bool result = QCoreApplication::notify(receiver, event);
+        uint64_t cost = os_gettime_ns() - start;
+        tickCost.Record(cost);
+        busyNs += cost;
+        return result;
+    }
+
+    QObject* pumpTimer = nullptr;
+    LatencyHistogram tickCost;
+    uint64_t busyNs = 0;
+};
+
+struct BenchSettings {
+    EffectConfigList configs;
+    double obstructionIntensity = 1.0;
+    double recoveryIntensity = 1.0;
+};
+
+// Same decisions as OnDonationReceived() in plugin-main.cpp
+static void DispatchDonation(ObstructionManager& manager, const BenchSettings& settings, const DonationEvent& event) {
+    if (event.type != DonationType::SuperSticker) {
+        EffectSettings config = settings.configs.FindConfigForAmount(event.amount);
+        if (config.amount.IsPositive()) {
+            manager.ApplyConfiguredEffect(config);
+        } else {
+            manager.ApplyObstruction(event.amount.ToUnits() * settings.obstructionIntensity);
+        }
+    } else {
+        manager.ApplyRecovery(event.amount.ToUnits() * settings.recoveryIntensity);
+    }
+}
+
+static bool LoadEffectConfigs(const QString& path, EffectConfigList& configs) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "Cannot open %s\n", path.toUtf8().constData());
+        return false;
+    }
+
+    // Same format as the EffectConfigurations value in the OBS global config
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isArray()) {
+        std::fprintf(stderr, "%s is not a JSON array of effect configurations\n", path.toUtf8().constData());
+        return false;
+    }
+    configs.FromVariantList(doc.array().toVariantList());
+    return true;
+}
+
+static QJsonObject HistogramToJson(const LatencyHistogram& histogram) {
+    QJsonObject obj;
+    obj["count"] = static_cast<double>(histogram.GetCount());
+    obj["meanUs"] = histogram.GetMean() / 1000.0;
+    obj["p50Us"] = histogram.GetPercentile(50.0) / 1000.0;
+    obj["p99Us"] = histogram.GetPercentile(99.0) / 1000.0;
+    obj["p999Us"] = histogram.GetPercentile(99.9) / 1000.0;
+    obj["maxUs"] = histogram.GetMax() / 1000.0;
+    return obj;
+}
+
+static QJsonArray CallCountsToJson(const std::vector<ObsStub::CallCount>& counts) {
+    QJsonArray array;
+    for (const ObsStub::CallCount& count : counts) {
+        QJsonObject obj;
+        obj["api"] = QString::fromStdString(count.api);
+        obj["scope"] = QString::fromStdString(count.scope);
+        obj["calls"] = static_cast<double>(count.calls);
+        array.append(obj);
+    }
+    return array;
+}
+
+static void PrintHistogram(const char* label, const LatencyHistogram& histogram) {
+    std::printf("%-22s n=%-8llu p50=%9.3f ms  p99=%9.3f ms  p999=%9.3f ms  max=%9.3f ms\n", label,
+                static_cast<unsigned long long>(histogram.GetCount()),
+                histogram.GetPercentile(50.0) / 1e6, histogram.GetPercentile(99.0) / 1e6,
+                histogram.GetPercentile(99.9) / 1e6, histogram.GetMax() / 1e6);
+}
+
+static QString RandomWord(std::mt19937_64& rng, bool japanese) {
+    QString word;
+    if (japanese) {
+        int length = 2 + static_cast<int>(rng() % 4);
+        for (int i = 0; i < length; i++) {
+            word.append(QChar(static_cast<char16_t>(0x3041 + rng() % 83)));   // Hiragana
+        }
+    } else {
+        int length = 3 + static_cast<int>(rng() % 6);
+        for (int i = 0; i < length; i++) {
+            word.append(QChar('a' + static_cast<int>(rng() % 26)));
+        }
+    }
+    return word;
+}
+
+// Commands, emoji codes, Japanese phrases and Latin words in equal parts
+static EffectConfigList MakeKeywordConfigs(int keywordCount, std::mt19937_64& rng, std::vector<QString>& keywords) {
+    EffectConfigList configs;
+    EffectSettings config;
+    for (int i = 0; i < keywordCount; i++) {
+        QString keyword;
+        switch (i % 4) {
+        case 0:  keyword = "!" + RandomWord(rng, false); break;
+        case 1:  keyword = ":" + RandomWord(rng, false) + ":"; break;
+        case 2:  keyword = RandomWord(rng, true) + RandomWord(rng, true); break;
+        default: keyword = RandomWord(rng, false) + " " + RandomWord(rng, false); break;
+        }
+        keywords.push_back(keyword);
+        config.keywords.append(keyword);
+
+        if (config.keywords.size() == KEYWORDS_PER_CONFIG || i == keywordCount - 1) {
+            config.action = static_cast<EffectAction>(1 + configs.GetCount() % 12);
+            configs.AddConfig(config);
+            config.keywords.clear();
+        }
+    }
+    return configs;
+}
+
+// Japanese or Latin chat; some messages carry a keyword, half of those in full-width upper case
+static std::vector<std::string> MakeChatMessages(size_t count, const std::vector<QString>& keywords, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    for (size_t n = 0; n < count; n++) {
+        bool japanese = rng() % 2 == 0;
+        int words = 3 + static_cast<int>(rng() % 10);
+        QString text;
+        for (int i = 0; i < words; i++) {
+            if (i > 0) text.append(' ');
+            text.append(RandomWord(rng, japanese));
+        }
+
+        if (!keywords.empty() && unit(rng) < KEYWORD_MESSAGE_RATIO) {
+            QString keyword = keywords[rng() % keywords.size()];
+            if (rng() % 2 == 0) {
+                QString wide;
+                for (QChar c : keyword.toUpper()) {
+                    wide.append(c.unicode() > 0x20 && c.unicode() < 0x7F ? QChar(c.unicode() + 0xFEE0) : c);
+                }
+                keyword = wide;
+            }
+            text.append(' ').append(keyword);
+        }
+        messages.push_back(text.toStdString());
+    }
+    return messages;
+}
+
+// Scans duration * rate messages back to back and reports the cost of one second of chat
+static int RunKeywordBench(int keywordCount, double chatRate, double durationSeconds, uint64_t seed, bool json) {
+    std::mt19937_64 rng(seed);
+    std::vector<QString> keywords;
+    EffectConfigList configs = MakeKeywordConfigs(keywordCount, rng, keywords);
+    std::vector<std::string> messages =
+        MakeChatMessages(static_cast<size_t>(std::max(1.0, chatRate * durationSeconds)), keywords, rng);
+
+    KeywordTriggerEngine engine;
+    uint64_t compileStart = os_gettime_ns();
+    engine.Compile(configs);
+    uint64_t compileNs = os_gettime_ns() - compileStart;
+
+    LatencyHistogram scanCost;
+    uint64_t totalNs = 0;
+    size_t matchedMessages = 0;
+    size_t triggeredEffects = 0;
+    for (const std::string& message : messages) {
+        uint64_t start = os_gettime_ns();
+        std::vector<EffectSettings> effects = engine.Match(message);
+        uint64_t cost = os_gettime_ns() - start;
+        scanCost.Record(cost);
+        totalNs += cost;
+        matchedMessages += effects.empty() ? 0 : 1;
+        triggeredEffects += effects.size();
+    }
+
+    // Share of one core spent scanning at the configured chat rate
+    double corePercent = totalNs / (messages.size() / chatRate * 1e9) * 100.0;
+
+    if (json) {
+        QJsonObject report;
+        report["keywords"] = static_cast<double>(engine.GetPatternCount());
+        report["states"] = static_cast<double>(engine.GetStateCount());
+        report["memoryBytes"] = static_cast<double>(engine.MemoryBytes());
+        report["compileMs"] = compileNs / 1e6;
+        report["messages"] = static_cast<double>(messages.size());
+        report["matchedMessages"] = static_cast<double>(matchedMessages);
+        report["triggeredEffects"] = static_cast<double>(triggeredEffects);
+        report["scanCost"] = HistogramToJson(scanCost);
+        report["corePercent"] = corePercent;
+        std::printf("%s\n", QJsonDocument(report).toJson(QJsonDocument::Indented).constData());
+    } else {
+        std::printf("Keyword triggers: %zu keywords, %zu states, %.1f KB, compiled in %.1f ms\n",
+                    engine.GetPatternCount(), engine.GetStateCount(), engine.MemoryBytes() / 1024.0, compileNs / 1e6);
+        std::printf("Messages scanned:      %zu (%zu matched, %zu effects)\n",
+                    messages.size(), matchedMessages, triggeredEffects);
+        PrintHistogram("Scan cost per message", scanCost);
+        std::printf("CPU at %.0f msgs/s:    %.2f%% of one core\n", chatRate, corePercent);
+    }
+    return 0;
+}
+
+// Times TweenEngine::Tick with 1, 10, 100, ... concurrent tweens up to maxTweens. A flat
+// cost per tween means the frame cost grows linearly and never worse.
+static int RunTweenBench(int maxTweens, uint64_t seed, bool json) {
+    std::vector<int> counts;
+    for (int count = 1; count < maxTweens; count *= 10) {
+        counts.push_back(count);
+    }
+    counts.push_back(std::max(1, maxTweens));
+
+    std::mt19937_64 rng(seed);
+    QJsonArray rows;
+    if (!json) {
+        std::printf("Tween engine: %d frames per run, %.0f%% of tweens retargeted per frame\n",
+                    TWEEN_BENCH_FRAMES, TWEEN_RETARGET_RATIO * 100.0);
+        std::printf("%10s %14s %14s %14s %14s\n", "tweens", "p50 tick us", "p99 tick us", "max tick us", "ns per tween");
+    }
+
+    for (int count : counts) {
+        TweenEngine engine;
+        std::vector<double> values(count, 0.0);
+        auto applyTo = [&values](int id) { return [&values, id](double value) { values[id] = value; }; };
+
+        // Long enough that no tween finishes during the run; every frame updates all of them
+        for (int id = 0; id < count; id++) {
+            EasingCurve curve = static_cast<EasingCurve>(id % static_cast<int>(EasingCurve::Count));
+            engine.AnimateTo(id, 0.0, 1.0, 3600.0, curve, applyTo(id));
+        }
+
+        int retargetsPerFrame = std::max(1, static_cast<int>(count * TWEEN_RETARGET_RATIO));
+        LatencyHistogram tickCost;
+        uint64_t totalNs = 0;
+        for (int frame = 0; frame < TWEEN_BENCH_FRAMES; frame++) {
+            // Donations arriving mid-animation blend from the current value
+            for (int i = 0; i < retargetsPerFrame; i++) {
+                int id = static_cast<int>(rng() % count);
+                engine.AnimateTo(id, 0.0, (rng() % 100) / 100.0, 3600.0, EasingCurve::EaseOut, applyTo(id));
+            }
+
+            uint64_t start = os_gettime_ns();
+            engine.Tick(start);
+            uint64_t cost = os_gettime_ns() - start;
+            tickCost.Record(cost);
+            totalNs += cost;
+        }
+
+        double nsPerTween = static_cast<double>(totalNs) / TWEEN_BENCH_FRAMES / count;
+        if (json) {
+            QJsonObject row;
+            row["tweens"] = count;
+            row["activeAfterRun"] = static_cast<double>(engine.GetActiveCount());
+            row["tickCost"] = HistogramToJson(tickCost);
+            row["nsPerTween"] = nsPerTween;
+            rows.append(row);
+        } else {
+            std::printf("%10d %14.3f %14.3f %14.3f %14.1f\n", count, tickCost.GetPercentile(50.0) / 1000.0,
+                        tickCost.GetPercentile(99.0) / 1000.0, tickCost.GetMax() / 1000.0, nsPerTween);
+        }
+    }
+
+    if (json) {
+        QJsonObject report;
+        report["frames"] = TWEEN_BENCH_FRAMES;
+        report["runs"] = rows;
+        std::printf("%s\n", QJsonDocument(report).toJson(QJsonDocument::Indented).constData());
+    }
+    return 0;
+}
+
+// Feeds FreeChatSampler full chat pages on a simulated clock and reports how many messages
+// per second it keeps and where in the page they sit. Uniform sampling keeps every tenth of
+// a page equally often.
+static int RunSamplerBench(double maxPerSecond, int pageSize, int pollIntervalMs, double durationSeconds, bool json) {
+    FreeChatSampler sampler(maxPerSecond);
+    size_t count = static_cast<size_t>(std::max(1, pageSize));
+    uint64_t intervalNs = static_cast<uint64_t>(std::max(1, pollIntervalMs)) * 1000000;
+    uint64_t endNs = static_cast<uint64_t>(durationSeconds * 1e9);
+
+    std::vector<bool> keep;
+    std::array<uint64_t, SAMPLER_POSITION_BINS> bins{};
+    uint64_t pages = 0;
+    uint64_t kept = 0;
+    for (uint64_t nowNs = intervalNs; nowNs <= endNs; nowNs += intervalNs) {
+        sampler.SampleBatch(count, nowNs, keep);
+        pages++;
+        for (size_t i = 0; i < count; i++) {
+            if (!keep[i]) continue;
+            kept++;
+            bins[i * SAMPLER_POSITION_BINS / count]++;
+        }
+    }
+
+    double seconds = std::max(1e-9, durationSeconds);
+    double worstShare = 0.0;
+    QJsonArray shares;
+    for (uint64_t bin : bins) {
+        double share = kept > 0 ? static_cast<double>(bin) / kept : 0.0;
+        worstShare = std::max(worstShare, std::abs(share * SAMPLER_POSITION_BINS - 1.0));
+        shares.append(share);
+    }
+
+    if (json) {
+        QJsonObject report;
+        report["maxPerSecond"] = maxPerSecond;
+        report["pageSize"] = pageSize;
+        report["pollIntervalMs"] = pollIntervalMs;
+        report["pages"] = static_cast<double>(pages);
+        report["kept"] = static_cast<double>(kept);
+        report["keptPerSecond"] = kept / seconds;
+        report["estimatedRate"] = sampler.GetArrivalRate();
+        report["positionShares"] = shares;
+        report["maxPositionDeviation"] = worstShare;
+        std::printf("%s\n", QJsonDocument(report).toJson(QJsonDocument::Indented).constData());
+    } else {
+        std::printf("Free chat sampler: K = %.1f/s, %d messages every %d ms, %llu pages\n",
+                    maxPerSecond, pageSize, pollIntervalMs, static_cast<unsigned long long>(pages));
+        std::printf("Kept:                  %llu (%.3f/s, estimated arrival %.1f/s)\n",
+                    static_cast<unsigned long long>(kept), kept / seconds, sampler.GetArrivalRate());
+        std::printf("Share per page tenth: ");
+        for (const QJsonValue& share : shares) {
+            std::printf(" %.3f", share.toDouble());
+        }
+        std::printf("\nWorst tenth:           %.1f%% off uniform\n", worstShare * 100.0);
+    }
+    return 0;
+}
+
+// Polls an in-process MockYouTubeServer through ChatIngestionHub, exactly as the plugin does
+// with "API Base URL" pointed at the mock, and reports the time from a message's publishedAt
+// (its emission time on the server) to the donation callback.
+static int RunMockServerBench(const MockServerOptions& serverOptions, double durationSeconds, double drainSeconds,
+                              const QString& maxP99Ms, bool json) {
+    MockYouTubeServer server(serverOptions);
+    if (!server.Start()) {
+        return 1;
+    }
+
+    // Every message counts: no per-viewer limits, sampling or quota pacing
+    ChatIngestionHub hub;
+    hub.SetApiKey("mock-key");
+    hub.SetApiBaseUrl(QString("http://127.0.0.1:%1").arg(server.GetPort()).toStdString());
+    hub.SetDailyQuota(std::numeric_limits<int>::max() / 2);
+    hub.SetSkipBacklog(true);
+    hub.SetViewerRateLimits(0, 0);
+    hub.SetFreeChatSampleRate(0);
+
+    LatencyHistogram latency;
+    std::array<uint64_t, PluginMetrics::DONATION_TYPE_COUNT> received{};
+    hub.SetDonationCallback([&](const DonationEvent& event) {
+        if (event.publishedAtMs > 0) {
+            int64_t ageMs = std::max<int64_t>(0, QDateTime::currentMSecsSinceEpoch() - event.publishedAtMs);
+            latency.Record(static_cast<uint64_t>(ageMs) * 1000000ULL);
+        }
+        received[static_cast<size_t>(event.type)]++;
+    });
+    hub.SetVideoIds({"mock-video"});
+
+    QTimer::singleShot(static_cast<int>(durationSeconds * 1000.0), &hub, &ChatIngestionHub::Stop);
+    QTimer::singleShot(static_cast<int>((durationSeconds + drainSeconds) * 1000.0), QCoreApplication::instance(),
+                       &QCoreApplication::quit);
+    hub.Start();
+    QCoreApplication::exec();
+    server.Stop();
+
+    uint64_t requests = g_metrics.apiRequests.load(std::memory_order_relaxed);
+    uint64_t errors = g_metrics.apiErrors.load(std::memory_order_relaxed);
+
+    if (json) {
+        QJsonObject report;
+        report["messagesPerSecond"] = serverOptions.messagesPerSecond;
+        report["pollingIntervalMillis"] = serverOptions.pollingIntervalMillis;
+        report["latency"] = HistogramToJson(latency);
+        QJsonObject counts;
+        for (size_t i = 0; i < received.size(); i++) {
+            counts[DonationTypeName(static_cast<DonationType>(i))] = static_cast<double>(received[i]);
+        }
+        report["received"] = counts;
+        report["apiRequests"] = static_cast<double>(requests);
+        report["apiErrors"] = static_cast<double>(errors);
+        std::printf("%s\n", QJsonDocument(report).toJson(QJsonDocument::Indented).constData());
+    } else {
+        std::printf("Mock server: %.1f msgs/s, pollingIntervalMillis %d, page size %d, +%d ms, %.0f%% errors\n",
+                    serverOptions.messagesPerSecond, serverOptions.pollingIntervalMillis, serverOptions.maxResults,
+                    serverOptions.latencyMs, serverOptions.errorRate * 100.0);
+        PrintHistogram("Emission -> callback", latency);
+        for (size_t i = 0; i < received.size(); i++) {
+            std::printf("Received %-13s %llu\n", DonationTypeName(static_cast<DonationType>(i)),
+                        static_cast<unsigned long long>(received[i]));
+        }
+        std::printf("API requests:          %llu (%llu failed)\n", static_cast<unsigned long long>(requests),
+                    static_cast<unsigned long long>(errors));
+    }
+
+    if (!maxP99Ms.isEmpty()) {
+        double p99Ms = latency.GetPercentile(99.0) / 1e6;
+        if (p99Ms > maxP99Ms.toDouble()) {
+            std::fprintf(stderr, "p99 latency %.3f ms exceeds the %.3f ms budget\n", p99Ms, maxP99Ms.toDouble());
+            return 2;
+        }
+    }
+    return latency.GetCount() > 0 ? 0 : 4;
+}
+
+int main(int argc, char* argv[]) {
+    BenchApplication app(argc, argv);
+    QCoreApplication::setApplicationName("DonationStormBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Drives ObstructionManager/EffectManager with a synthetic donation storm over the headless\n"
+        "libobs stub and reports latency from donation to the first scene item transform write.");
+    parser.addHelpOption();
+
+    QCommandLineOption durationOption("duration", "Length of the storm.", "seconds", "30");
+    QCommandLineOption rateOption("rate", "Poisson arrival rate.", "per-second", "20");
+    QCommandLineOption raidEveryOption("raid-every", "Start a raid every N seconds (0 = never).", "seconds", "0");
+    QCommandLineOption raidMultiplierOption("raid-multiplier", "Rate multiplier during a raid.", "factor", "10");
+    QCommandLineOption raidLengthOption("raid-length", "Length of each raid.", "seconds", "3");
+    QCommandLineOption stickerOption("sticker-ratio", "Fraction of Super Stickers.", "ratio", "0.1");
+    QCommandLineOption amountsOption("amounts", "Amount distribution: tiers or lognormal.", "model", "tiers");
+    QCommandLineOption seedOption("seed", "Random seed.", "seed", "1");
+    QCommandLineOption drainOption("drain", "Keep running after the last arrival.", "seconds", "5");
+    QCommandLineOption configsOption("configs", "Effect configurations (JSON array as stored by the plugin).", "file");
+    QCommandLineOption maxOverlaysOption("max-overlays", "Overlay cap (0 = unlimited).", "count", "20");
+    QCommandLineOption lifetimeOption("overlay-lifetime", "Overlay lifetime.", "seconds", "10");
+    QCommandLineOption jsonOption("json", "Print the report as JSON.");
+    QCommandLineOption maxP99Option("max-p99-ms", "Exit with status 2 when p99 latency exceeds this.", "ms");
+    QCommandLineOption callsOption("calls", "Number of (API, effect) call counts to print.", "count", "15");
+    QCommandLineOption verboseOption("verbose", "Print plugin log output.");
+    QCommandLineOption keywordsOption("keywords", "Benchmark chat keyword triggers with this many keywords instead.", "count");
+    QCommandLineOption chatRateOption("chat-rate", "Chat messages per second for --keywords.", "per-second", "1000");
+    QCommandLineOption mockServerOption("mock-server",
+                                        "Measure emission to callback latency against a local mock chat server instead.");
+    QCommandLineOption pollIntervalOption("poll-interval", "pollingIntervalMillis for --mock-server.", "ms", "1000");
+    QCommandLineOption pageSizeOption("page-size", "Items per page for --mock-server (1-2000).", "count", "200");
+    QCommandLineOption serverLatencyOption("server-latency", "Delay before every --mock-server response.", "ms", "0");
+    QCommandLineOption errorRateOption("error-rate", "Share of --mock-server responses that fail.", "ratio", "0");
+    QCommandLineOption samplerOption("sampler",
+                                     "Check free chat sampling at this many messages per second instead "
+                                     "(pages of --page-size every --poll-interval).", "per-second");
+    QCommandLineOption tweensOption("tweens", "Benchmark tween ticks for up to this many concurrent tweens instead.",
+                                    "count");
+
+    parser.addOptions({durationOption, rateOption, raidEveryOption, raidMultiplierOption, raidLengthOption,
+                       stickerOption, amountsOption, seedOption, drainOption, configsOption, maxOverlaysOption,
+                       lifetimeOption, jsonOption, maxP99Option, callsOption, verboseOption, keywordsOption,
+                       chatRateOption, mockServerOption, pollIntervalOption, pageSizeOption, serverLatencyOption,
+                       errorRateOption, samplerOption, tweensOption});
+    parser.process(app);
+
+    if (parser.isSet(keywordsOption)) {
+        ObsStub::SetLogLevel(parser.isSet(verboseOption) ? LOG_DEBUG : LOG_WARNING);
+        return RunKeywordBench(parser.value(keywordsOption).toInt(), parser.value(chatRateOption).toDouble(),
+                               parser.value(durationOption).toDouble(), parser.value(seedOption).toULongLong(),
+                               parser.isSet(jsonOption));
+    }
+
+    if (parser.isSet(tweensOption)) {
+        ObsStub::SetLogLevel(parser.isSet(verboseOption) ? LOG_DEBUG : LOG_WARNING);
+        return RunTweenBench(parser.value(tweensOption).toInt(), parser.value(seedOption).toULongLong(),
+                             parser.isSet(jsonOption));
+    }
+
+    if (parser.isSet(samplerOption)) {
+        return RunSamplerBench(parser.value(samplerOption).toDouble(), parser.value(pageSizeOption).toInt(),
+                               parser.value(pollIntervalOption).toInt(), parser.value(durationOption).toDouble(),
+                               parser.isSet(jsonOption));
+    }
+
+    if (parser.isSet(mockServerOption)) {
+        ObsStub::SetLogLevel(parser.isSet(verboseOption) ? LOG_DEBUG : LOG_WARNING);
+        MockServerOptions serverOptions;
+        serverOptions.port = 0;     // Any free port
+        serverOptions.messagesPerSecond = std::max(0.001, parser.value(rateOption).toDouble());
+        serverOptions.superStickerRatio = parser.value(stickerOption).toDouble();
+        serverOptions.pollingIntervalMillis = parser.value(pollIntervalOption).toInt();
+        serverOptions.maxResults = parser.value(pageSizeOption).toInt();
+        serverOptions.latencyMs = parser.value(serverLatencyOption).toInt();
+        serverOptions.errorRate = parser.value(errorRateOption).toDouble();
+        return RunMockServerBench(serverOptions, parser.value(durationOption).toDouble(),
+                                  parser.value(drainOption).toDouble(),
+                                  parser.isSet(maxP99Option) ? parser.value(maxP99Option) : QString(),
+                                  parser.isSet(jsonOption));
+    }
+
+    StormOptions options;
+    options.durationSeconds = parser.value(durationOption).toDouble();
+    options.eventsPerSecond = parser.value(rateOption).toDouble();
+    options.raidEverySeconds = parser.value(raidEveryOption).toDouble();
+    options.raidMultiplier = parser.value(raidMultiplierOption).toDouble();
+    options.raidSeconds = parser.value(raidLengthOption).toDouble();
+    options.stickerRatio = parser.value(stickerOption).toDouble();
+    options.amountModel = parser.value(amountsOption) == "lognormal" ? AmountModel::LogNormal : AmountModel::Tiers;
+    options.seed = parser.value(seedOption).toULongLong();
+
+    ObsStub::Reset();
+    ObsStub::SetLogLevel(parser.isSet(verboseOption) ? LOG_DEBUG : LOG_WARNING);
+    ObsStub::SetScopeProvider(&ObsCallScope::Current);
+    ObsStub::AddSceneSource("game_capture", MAIN_SOURCE_NAME, 1920, 1080);
+    PluginLog::Instance().Start();     // Dispatch logs through the async ring, as in OBS
+    size_t baselineObjects = ObsStub::GetLiveObjects().size();
+
+    BenchSettings settings;
+    if (parser.isSet(configsOption) && !LoadEffectConfigs(parser.value(configsOption), settings.configs)) {
+        return 1;
+    }
+
+    std::vector<StormArrival> arrivals = DonationStormGenerator(options).Generate();
+
+    auto manager = std::make_unique<ObstructionManager>();
+    manager->SetMainSourceName(MAIN_SOURCE_NAME);
+    manager->SetMaxOverlays(parser.value(maxOverlaysOption).toInt());
+    manager->SetOverlayLifetime(parser.value(lifetimeOption).toDouble());
+
+    LatencyHistogram latency;
+    LatencyHistogram dispatchCost;
+
+    // A write made while an event is dispatched belongs to that event. Events whose effect
+    // only starts moving on a later frame (tweens) take the next write of any kind.
+    bool probing = false;
+    uint64_t probeHitNs = 0;
+    std::vector<uint64_t> waiting;
+    ObsStub::SetTransformWriteHook([&](obs_sceneitem_t*, uint64_t timeNs) {
+        if (probing && probeHitNs == 0) {
+            probeHitNs = timeNs;
+        }
+        for (uint64_t createdNs : waiting) {
+            latency.Record(timeNs - createdNs);
+        }
+        waiting.clear();
+    });
+
+    QTimer pump;
+    pump.setTimerType(Qt::PreciseTimer);
+    pump.setInterval(1);
+    app.pumpTimer = &pump;
+
+    size_t next = 0;
+    uint64_t startNs = os_gettime_ns();
+    QObject::connect(&pump, &QTimer::timeout, [&]() {
+        uint64_t now = os_gettime_ns();
+        while (next < arrivals.size()) {
+            // The event is created at its scheduled time; a late pump counts as queueing delay
+            uint64_t createdNs = startNs + static_cast<uint64_t>(arrivals[next].atSeconds * 1e9);
+            if (createdNs > now) break;
+
+            probing = true;
+            probeHitNs = 0;
+            uint64_t dispatchStart = os_gettime_ns();
+            DispatchDonation(*manager, settings, arrivals[next].event);
+            dispatchCost.Record(os_gettime_ns() - dispatchStart);
+            probing = false;
+
+            if (probeHitNs != 0) {
+                latency.Record(probeHitNs - createdNs);
+            } else {
+                waiting.push_back(createdNs);
+            }
+            next++;
+        }
+        if (next == arrivals.size()) {
+            pump.stop();
+        }
+    });
+
+    double runSeconds = options.durationSeconds + parser.value(drainOption).toDouble();
+    QTimer::singleShot(static_cast<int>(runSeconds * 1000.0), &app, &QCoreApplication::quit);
+
+    pump.start();
+    app.exec();
+
+    uint64_t wallNs = os_gettime_ns() - startNs;
+    size_t peakSources = ObsStub::GetPeakLiveSourceCount();
+    size_t peakItems = ObsStub::GetPeakLiveSceneItemCount();
+    uint64_t transformWrites = ObsStub::GetTransformWriteCount();
+    size_t unresolved = waiting.size();
+
+    ObsStub::SetTransformWriteHook(nullptr);
+    manager.reset();
+    PluginLog::Instance().Stop();
+
+    // The scene and main source set up above stay alive; anything else outlived the manager.
+    // Objects created inside an OBS_CALL_SCOPE name the effect that leaked them.
+    std::vector<ObsStub::LiveObject> live = ObsStub::GetLiveObjects();
+    size_t leakedObjects = live.size() > baselineObjects ? live.size() - baselineObjects : 0;
+    std::vector<ObsStub::LiveObject> attributedLeaks;
+    for (const ObsStub::LiveObject& object : live) {
+        if (!object.createdBy.empty()) attributedLeaks.push_back(object);
+    }
+    uint64_t invalidReleases = ObsStub::GetInvalidReleaseCount();
+
+    std::vector<ObsStub::CallCount> calls = ObsStub::GetCallCounts();
+    size_t callLimit = std::min(calls.size(), static_cast<size_t>(std::max(0, parser.value(callsOption).toInt())));
+    calls.resize(callLimit);
+
+    double busyPercent = wallNs ? app.busyNs * 100.0 / wallNs : 0.0;
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject report;
+        report["events"] = static_cast<double>(arrivals.size());
+        report["dispatched"] = static_cast<double>(next);
+        report["latency"] = HistogramToJson(latency);
+        report["unresolved"] = static_cast<double>(unresolved);
+        report["dispatchCost"] = HistogramToJson(dispatchCost);
+        report["frameTickCost"] = HistogramToJson(app.tickCost);
+        report["frameBusyPercent"] = busyPercent;
+        report["peakLiveSources"] = static_cast<double>(peakSources);
+        report["peakSceneItems"] = static_cast<double>(peakItems);
+        report["transformWrites"] = static_cast<double>(transformWrites);
+        report["leakedObjects"] = static_cast<double>(leakedObjects);
+        report["invalidReleases"] = static_cast<double>(invalidReleases);
+        QJsonArray leaks;
+        for (const ObsStub::LiveObject& object : attributedLeaks) {
+            QJsonObject obj;
+            obj["kind"] = QString::fromStdString(object.kind);
+            obj["name"] = QString::fromStdString(object.name);
+            obj["refs"] = object.refs;
+            obj["createdBy"] = QString::fromStdString(object.createdBy);
+            leaks.append(obj);
+        }
+        report["leaks"] = leaks;
+        report["calls"] = CallCountsToJson(calls);
+        std::printf("%s\n", QJsonDocument(report).toJson(QJsonDocument::Indented).constData());
+    } else {
+        std::printf("Donation storm: %zu events in %.1f s (seed %llu)\n", arrivals.size(), options.durationSeconds,
+                    static_cast<unsigned long long>(options.seed));
+        PrintHistogram("Event -> first write", latency);
+        PrintHistogram("Dispatch cost", dispatchCost);
+        PrintHistogram("Frame tick cost", app.tickCost);
+        std::printf("Frame ticks busy:      %.2f%% of wall time\n", busyPercent);
+        std::printf("Peak live sources:     %zu (scene items: %zu)\n", peakSources, peakItems);
+        std::printf("Transform writes:      %llu\n", static_cast<unsigned long long>(transformWrites));
+        std::printf("Events without write:  %zu\n", unresolved);
+        std::printf("Leaked objects:        %zu\n", leakedObjects);
+        for (const ObsStub::LiveObject& object : attributedLeaks) {
+            std::printf("  %-10s %-28s refs=%d  created by %s\n", object.kind.c_str(), object.name.c_str(),
+                        object.refs, object.createdBy.c_str());
+        }
+        std::printf("Invalid releases:      %llu\n", static_cast<unsigned long long>(invalidReleases));
+
+        std::printf("\nlibobs calls by effect (top %zu):\n", calls.size());
+        for (const ObsStub::CallCount& count : calls) {
+            std::printf("  %-34s %-24s %10llu\n", count.api.c_str(),
+                        count.scope.empty() ? "(no scope)" : count.scope.c_str(),
+                        static_cast<unsigned long long>(count.calls));
+        }
+    }
+
+#ifdef OBS_CALL_PROFILING
+    if (!parser.isSet(jsonOption)) {
+        std::printf("\n");
+        for (const std::string& line : ObsCallProfiler::Instance().FormatReport(callLimit)) {
+            std::printf("%s\n", line.c_str());
+        }
+    }
+#endif
+
+    if (parser.isSet(maxP99Option)) {
+        double p99Ms = latency.GetPercentile(99.0) / 1e6;
+        if (p99Ms > parser.value(maxP99Option).toDouble()) {
+            std::fprintf(stderr, "p99 latency %.3f ms exceeds the %.3f ms budget\n",
+                         p99Ms, parser.value(maxP99Option).toDouble());
+            return 2;
+        }
+    }
+    return leakedObjects == 0 && invalidReleases == 0 ? 0 : 3;
+}
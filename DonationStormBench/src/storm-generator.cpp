@@ -0,0 +1,74 @@
+#include "storm-generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Super Chat price tiers (JPY) and how often each one shows up in a typical stream
+static const double AMOUNT_TIERS[] = {100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000};
+static const double TIER_WEIGHTS[] = {0.32, 0.18, 0.20, 0.15, 0.06, 0.05, 0.03, 0.007, 0.003};
+
+// Super Chat limits in JPY
+static const double MIN_AMOUNT = 100.0;
+static const double MAX_AMOUNT = 50000.0;
+
+DonationStormGenerator::DonationStormGenerator(const StormOptions& options)
+    : m_options(options)
+    , m_randomEngine(options.seed)
+{
+}
+
+bool DonationStormGenerator::InRaid(double seconds) const {
+    if (m_options.raidEverySeconds <= 0.0 || seconds < m_options.raidEverySeconds) return false;
+    return std::fmod(seconds, m_options.raidEverySeconds) < m_options.raidSeconds;
+}
+
+double DonationStormGenerator::RateAt(double seconds) const {
+    return InRaid(seconds) ? m_options.eventsPerSecond * m_options.raidMultiplier : m_options.eventsPerSecond;
+}
+
+double DonationStormGenerator::NextAmount() {
+    if (m_options.amountModel == AmountModel::LogNormal) {
+        std::lognormal_distribution<double> dist(std::log(500.0), 1.2);
+        double amount = std::clamp(dist(m_randomEngine), MIN_AMOUNT, MAX_AMOUNT);
+        return std::round(amount / 10.0) * 10.0;
+    }
+
+    std::discrete_distribution<size_t> tier(std::begin(TIER_WEIGHTS), std::end(TIER_WEIGHTS));
+    return AMOUNT_TIERS[tier(m_randomEngine)];
+}
+
+std::vector<StormArrival> DonationStormGenerator::Generate() {
+    std::vector<StormArrival> arrivals;
+    if (m_options.eventsPerSecond <= 0.0 || m_options.durationSeconds <= 0.0) return arrivals;
+
+    // Thinning: draw at the peak rate, keep each candidate with probability rate(t) / peak
+    double peakRate = m_options.eventsPerSecond *
+                      (m_options.raidEverySeconds > 0.0 ? std::max(1.0, m_options.raidMultiplier) : 1.0);
+    std::exponential_distribution<double> gap(peakRate);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    arrivals.reserve(static_cast<size_t>(m_options.eventsPerSecond * m_options.durationSeconds * 1.2));
+
+    uint64_t sequence = 0;
+    double t = gap(m_randomEngine);
+    while (t < m_options.durationSeconds) {
+        if (unit(m_randomEngine) * peakRate < RateAt(t)) {
+            StormArrival arrival;
+            arrival.atSeconds = t;
+
+            DonationEvent& event = arrival.event;
+            event.type = unit(m_randomEngine) < m_options.stickerRatio ? DonationType::SuperSticker
+                                                                        : DonationType::SuperChat;
+            event.amount = Money::FromUnits(NextAmount());
+            event.originalAmount = event.amount;
+            event.currency = "JPY";
+            event.displayName = "viewer" + std::to_string(sequence++);
+            event.sourceId = "storm";
+
+            arrivals.push_back(std::move(arrival));
+        }
+        t += gap(m_randomEngine);
+    }
+
+    return arrivals;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QElapsedTimer>
+#include <QHash>
+#include <random>
+
+// Behaviour of the simulated live chat
+struct MockServerOptions {
+    quint16 port = 8089;
+    int pollingIntervalMillis = 1000;   // Returned in every messages page
+    int maxResults = 200;               // Items per page (the real API caps at 2,000)
+    double messagesPerSecond = 20.0;    // Rate at which chat messages are "emitted"
+    double superChatRatio = 0.1;        // Fraction of messages that are Super Chats
+    double superStickerRatio = 0.02;    // Fraction of messages that are Super Stickers
+    int latencyMs = 0;                  // Added before every response
+    double errorRate = 0.0;             // Probability of answering with an error
+    bool quotaErrors = false;           // Inject 403 quotaExceeded instead of 503
+};
+
+// Minimal HTTP/1.1 server that answers the two YouTube Data API v3 endpoints the plugin uses:
+//   GET /youtube/v3/videos              -> liveStreamingDetails.activeLiveChatId
+//   GET /youtube/v3/liveChat/messages   -> scripted message pages
+// Messages are generated at a fixed rate from the server start time. pageToken is the sequence
+// number of the next message, and publishedAt is the emission time, so a client can measure
+// end-to-end latency from emission to handling.
+class MockYouTubeServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MockYouTubeServer(const MockServerOptions& options, QObject* parent = nullptr);
+    ~MockYouTubeServer();
+
+    bool Start();
+    void Stop();
+
+    // Actual listen port; differs from the option when it was 0
+    quint16 GetPort() const { return m_server->serverPort(); }
+
+private slots:
+    void OnNewConnection();
+    void OnReadyRead();
+
+private:
+    void HandleRequest(QTcpSocket* client, const QByteArray& method, const QByteArray& target);
+    void SendResponse(QTcpSocket* client, int status, const QByteArray& body);
+    QByteArray BuildVideosResponse() const;
+    QByteArray BuildMessagesResponse(qint64 pageToken);
+    QByteArray BuildErrorBody(int status) const;
+    qint64 EmittedMessageCount() const;
+
+    MockServerOptions m_options;
+    QTcpServer* m_server;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+    QElapsedTimer m_clock;
+    qint64 m_startEpochMs;
+    std::mt19937 m_randomEngine;
+    quint64 m_requestCount;
+};
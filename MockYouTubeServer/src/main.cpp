@@ -0,0 +1,47 @@
+#include "mock-youtube-server.hpp"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <algorithm>
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("MockYouTubeServer");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Local stand-in for the YouTube Live Chat API.\n"
+        "Point the plugin's \"API Base URL\" setting at http://127.0.0.1:<port>.");
+    parser.addHelpOption();
+
+    QCommandLineOption portOption("port", "Listen port.", "port", "8089");
+    QCommandLineOption intervalOption("poll-interval", "pollingIntervalMillis returned to the client.", "ms", "1000");
+    QCommandLineOption pageSizeOption("page-size", "Maximum items per page (1-2000).", "count", "200");
+    QCommandLineOption rateOption("rate", "Chat messages emitted per second.", "per-second", "20");
+    QCommandLineOption superChatOption("superchat-ratio", "Fraction of messages that are Super Chats.", "ratio", "0.1");
+    QCommandLineOption stickerOption("sticker-ratio", "Fraction of messages that are Super Stickers.", "ratio", "0.02");
+    QCommandLineOption latencyOption("latency", "Delay added before every response.", "ms", "0");
+    QCommandLineOption errorRateOption("error-rate", "Probability of answering with an error.", "ratio", "0");
+    QCommandLineOption quotaOption("quota-errors", "Inject 403 quotaExceeded instead of 503.");
+
+    parser.addOptions({portOption, intervalOption, pageSizeOption, rateOption, superChatOption,
+                       stickerOption, latencyOption, errorRateOption, quotaOption});
+    parser.process(app);
+
+    MockServerOptions options;
+    options.port = static_cast<quint16>(parser.value(portOption).toUInt());
+    options.pollingIntervalMillis = parser.value(intervalOption).toInt();
+    options.maxResults = parser.value(pageSizeOption).toInt();
+    options.messagesPerSecond = std::max(0.001, parser.value(rateOption).toDouble());
+    options.superChatRatio = parser.value(superChatOption).toDouble();
+    options.superStickerRatio = parser.value(stickerOption).toDouble();
+    options.latencyMs = parser.value(latencyOption).toInt();
+    options.errorRate = parser.value(errorRateOption).toDouble();
+    options.quotaErrors = parser.isSet(quotaOption);
+
+    MockYouTubeServer server(options);
+    if (!server.Start()) {
+        return 1;
+    }
+
+    return app.exec();
+}
@@ -0,0 +1,307 @@
+#include "mock-youtube-server.hpp"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+#include <algorithm>
+
+static const char* MOCK_LIVE_CHAT_ID = "mock-live-chat";
+
+// Stateless per-message randomness so that re-fetching a page returns the same content
+static quint64 SplitMix64(quint64 x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static double UnitFromHash(quint64 hash) {
+    return static_cast<double>(hash >> 11) / static_cast<double>(1ULL << 53);
+}
+
+MockYouTubeServer::MockYouTubeServer(const MockServerOptions& options, QObject* parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_server(new QTcpServer(this))
+    , m_startEpochMs(0)
+    , m_randomEngine(std::random_device{}())
+    , m_requestCount(0)
+{
+    m_options.maxResults = std::clamp(m_options.maxResults, 1, 2000);
+    connect(m_server, &QTcpServer::newConnection, this, &MockYouTubeServer::OnNewConnection);
+}
+
+MockYouTubeServer::~MockYouTubeServer() {
+    Stop();
+}
+
+bool MockYouTubeServer::Start() {
+    if (m_server->isListening()) {
+        return true;
+    }
+
+    if (!m_server->listen(QHostAddress::LocalHost, m_options.port)) {
+        qWarning() << "[MockServer] Failed to listen:" << m_server->errorString();
+        return false;
+    }
+
+    m_clock.start();
+    m_startEpochMs = QDateTime::currentMSecsSinceEpoch();
+
+    qInfo() << "[MockServer] Listening on http://127.0.0.1:" << m_server->serverPort()
+            << "rate" << m_options.messagesPerSecond << "msg/s, page size" << m_options.maxResults;
+    return true;
+}
+
+void MockYouTubeServer::Stop() {
+    if (m_server->isListening()) {
+        m_server->close();
+    }
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it) {
+        it.key()->disconnectFromHost();
+        it.key()->deleteLater();
+    }
+    m_buffers.clear();
+}
+
+void MockYouTubeServer::OnNewConnection() {
+    while (QTcpSocket* client = m_server->nextPendingConnection()) {
+        connect(client, &QTcpSocket::readyRead, this, &MockYouTubeServer::OnReadyRead);
+        connect(client, &QTcpSocket::disconnected, this, [this, client]() {
+            m_buffers.remove(client);
+            client->deleteLater();
+        });
+        m_buffers.insert(client, QByteArray());
+    }
+}
+
+void MockYouTubeServer::OnReadyRead() {
+    QTcpSocket* client = qobject_cast<QTcpSocket*>(sender());
+    if (!client) {
+        return;
+    }
+
+    QByteArray& buffer = m_buffers[client];
+    buffer += client->readAll();
+
+    // GET requests have no body, so the header terminator ends the request
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return;
+    }
+
+    QByteArray requestLine = buffer.left(buffer.indexOf("\r\n"));
+    buffer.clear();
+
+    QList<QByteArray> parts = requestLine.split(' ');
+    if (parts.size() < 2) {
+        SendResponse(client, 400, BuildErrorBody(400));
+        return;
+    }
+
+    QByteArray method = parts[0];
+    QByteArray target = parts[1];
+
+    if (m_options.latencyMs > 0) {
+        QTimer::singleShot(m_options.latencyMs, this, [this, client, method, target]() {
+            if (m_buffers.contains(client)) {
+                HandleRequest(client, method, target);
+            }
+        });
+    } else {
+        HandleRequest(client, method, target);
+    }
+}
+
+void MockYouTubeServer::HandleRequest(QTcpSocket* client, const QByteArray& method, const QByteArray& target) {
+    ++m_requestCount;
+
+    if (method != "GET") {
+        SendResponse(client, 405, BuildErrorBody(405));
+        return;
+    }
+
+    if (m_options.errorRate > 0.0) {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        if (dist(m_randomEngine) < m_options.errorRate) {
+            int status = m_options.quotaErrors ? 403 : 503;
+            SendResponse(client, status, BuildErrorBody(status));
+            return;
+        }
+    }
+
+    QUrl url(QString::fromLatin1(target));
+    QUrlQuery query(url);
+
+    if (url.path() == "/youtube/v3/videos") {
+        SendResponse(client, 200, BuildVideosResponse());
+    } else if (url.path() == "/youtube/v3/liveChat/messages") {
+        bool ok = false;
+        qint64 pageToken = query.queryItemValue("pageToken").toLongLong(&ok);
+        SendResponse(client, 200, BuildMessagesResponse(ok ? pageToken : -1));
+    } else {
+        SendResponse(client, 404, BuildErrorBody(404));
+    }
+}
+
+void MockYouTubeServer::SendResponse(QTcpSocket* client, int status, const QByteArray& body) {
+    const char* reason = status == 200 ? "OK" :
+                         status == 400 ? "Bad Request" :
+                         status == 403 ? "Forbidden" :
+                         status == 404 ? "Not Found" :
+                         status == 405 ? "Method Not Allowed" : "Service Unavailable";
+
+    QByteArray response;
+    response += "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n";
+    response += "Content-Type: application/json; charset=UTF-8\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+
+    client->write(response);
+    client->disconnectFromHost();
+}
+
+QByteArray MockYouTubeServer::BuildVideosResponse() const {
+    QJsonObject liveDetails;
+    liveDetails["activeLiveChatId"] = MOCK_LIVE_CHAT_ID;
+    liveDetails["actualStartTime"] = QDateTime::fromMSecsSinceEpoch(m_startEpochMs, Qt::UTC).toString(Qt::ISODateWithMs);
+
+    QJsonObject item;
+    item["kind"] = "youtube#video";
+    item["id"] = "mock-video";
+    item["liveStreamingDetails"] = liveDetails;
+
+    QJsonObject root;
+    root["kind"] = "youtube#videoListResponse";
+    root["items"] = QJsonArray{item};
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+qint64 MockYouTubeServer::EmittedMessageCount() const {
+    return static_cast<qint64>(m_clock.elapsed() * m_options.messagesPerSecond / 1000.0);
+}
+
+QByteArray MockYouTubeServer::BuildMessagesResponse(qint64 pageToken) {
+    qint64 emitted = EmittedMessageCount();
+
+    // Without a token the real API returns recent backlog; mimic that with one page
+    qint64 first = pageToken >= 0 ? pageToken : std::max<qint64>(0, emitted - m_options.maxResults);
+    // A token ahead of the emitted count (server restarted) is handed back unchanged, never rewound
+    qint64 last = std::max<qint64>(first, std::min<qint64>(emitted, first + m_options.maxResults));
+
+    QJsonArray items;
+    for (qint64 seq = first; seq < last; ++seq) {
+        quint64 hash = SplitMix64(static_cast<quint64>(seq));
+        double roll = UnitFromHash(hash);
+        int viewer = static_cast<int>((hash >> 8) % 5000);
+
+        qint64 publishedMs = m_startEpochMs + static_cast<qint64>(seq * 1000.0 / m_options.messagesPerSecond);
+        QString displayName = QString("Viewer %1").arg(viewer);
+        QString channelId = QString("UCmockviewer%1").arg(viewer, 6, 10, QChar('0'));
+
+        QJsonObject snippet;
+        snippet["liveChatId"] = MOCK_LIVE_CHAT_ID;
+        snippet["authorChannelId"] = channelId;
+        snippet["publishedAt"] = QDateTime::fromMSecsSinceEpoch(publishedMs, Qt::UTC).toString(Qt::ISODateWithMs);
+        snippet["hasDisplayContent"] = true;
+
+        if (roll < m_options.superChatRatio) {
+            // 100 to 50,000 JPY in 100 JPY steps
+            qint64 amount = 100 + static_cast<qint64>((hash >> 20) % 500) * 100;
+            QString comment = QString("mock super chat #%1").arg(seq);
+
+            QJsonObject details;
+            details["amountMicros"] = QString::number(amount * 1000000);
+            details["currency"] = "JPY";
+            details["amountDisplayString"] = QString("¥%1").arg(amount);
+            details["userComment"] = comment;
+            details["tier"] = 1 + static_cast<int>((hash >> 40) % 7);
+
+            snippet["type"] = "superChatEvent";
+            snippet["displayMessage"] = comment;
+            snippet["superChatDetails"] = details;
+        } else if (roll < m_options.superChatRatio + m_options.superStickerRatio) {
+            qint64 amount = 200 + static_cast<qint64>((hash >> 20) % 50) * 100;
+
+            QJsonObject sticker;
+            sticker["stickerId"] = "mock-sticker";
+            sticker["altText"] = "mock sticker";
+            sticker["language"] = "ja";
+
+            QJsonObject details;
+            details["superStickerMetadata"] = sticker;
+            details["amountMicros"] = QString::number(amount * 1000000);
+            details["currency"] = "JPY";
+            details["amountDisplayString"] = QString("¥%1").arg(amount);
+            details["tier"] = 1;
+
+            snippet["type"] = "superStickerEvent";
+            snippet["displayMessage"] = QString("Super Sticker ¥%1").arg(amount);
+            snippet["superStickerDetails"] = details;
+        } else {
+            QString text = QString("mock message #%1").arg(seq);
+
+            QJsonObject details;
+            details["messageText"] = text;
+
+            snippet["type"] = "textMessageEvent";
+            snippet["displayMessage"] = text;
+            snippet["textMessageDetails"] = details;
+        }
+
+        QJsonObject author;
+        author["channelId"] = channelId;
+        author["channelUrl"] = "http://www.youtube.com/channel/" + channelId;
+        author["displayName"] = displayName;
+        author["profileImageUrl"] = "https://yt3.ggpht.com/mock/photo.jpg";
+        author["isVerified"] = false;
+        author["isChatOwner"] = false;
+        author["isChatSponsor"] = false;
+        author["isChatModerator"] = false;
+
+        QJsonObject item;
+        item["kind"] = "youtube#liveChatMessage";
+        item["id"] = QString("mock-%1").arg(seq);
+        item["snippet"] = snippet;
+        item["authorDetails"] = author;
+        items.append(item);
+    }
+
+    QJsonObject pageInfo;
+    pageInfo["totalResults"] = static_cast<int>(items.size());
+    pageInfo["resultsPerPage"] = static_cast<int>(items.size());
+
+    QJsonObject root;
+    root["kind"] = "youtube#liveChatMessageListResponse";
+    root["nextPageToken"] = QString::number(last);
+    root["pollingIntervalMillis"] = m_options.pollingIntervalMillis;
+    root["pageInfo"] = pageInfo;
+    root["items"] = items;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+QByteArray MockYouTubeServer::BuildErrorBody(int status) const {
+    QJsonObject error;
+    error["code"] = status;
+
+    if (status == 403) {
+        QJsonObject detail;
+        detail["domain"] = "youtube.quota";
+        detail["reason"] = "quotaExceeded";
+        detail["message"] = "The request cannot be completed because you have exceeded your quota.";
+        error["errors"] = QJsonArray{detail};
+        error["message"] = detail["message"];
+    } else {
+        error["message"] = status == 503 ? "Backend Error (injected)" : "Mock server error";
+    }
+
+    QJsonObject root;
+    root["error"] = error;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
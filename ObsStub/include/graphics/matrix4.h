@@ -0,0 +1,7 @@
+#pragma once
+
+#include "vec3.h"
+
+struct matrix4 {
+    struct vec3 x, y, z, t;
+};
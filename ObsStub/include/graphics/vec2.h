@@ -0,0 +1,15 @@
+#pragma once
+
+struct vec2 {
+    float x, y;
+};
+
+static inline void vec2_zero(struct vec2* dst) {
+    dst->x = 0.0f;
+    dst->y = 0.0f;
+}
+
+static inline void vec2_set(struct vec2* dst, float x, float y) {
+    dst->x = x;
+    dst->y = y;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+struct vec3 {
+    float x, y, z, w;
+};
+
+static inline void vec3_zero(struct vec3* dst) {
+    dst->x = dst->y = dst->z = dst->w = 0.0f;
+}
+
+static inline void vec3_set(struct vec3* dst, float x, float y, float z) {
+    dst->x = x;
+    dst->y = y;
+    dst->z = z;
+    dst->w = 0.0f;
+}
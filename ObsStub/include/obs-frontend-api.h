@@ -0,0 +1,24 @@
+#pragma once
+
+#include "obs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct obs_frontend_source_list {
+    struct {
+        obs_source_t** array;
+        size_t num;
+        size_t capacity;
+    } sources;
+};
+
+void obs_frontend_source_list_free(struct obs_frontend_source_list* source_list);
+obs_source_t* obs_frontend_get_current_scene(void);
+void obs_frontend_set_current_scene(obs_source_t* scene);
+void obs_frontend_get_scenes(struct obs_frontend_source_list* sources);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "obs.h"
+
+#define OBS_DECLARE_MODULE()
+#define OBS_MODULE_USE_DEFAULT_LOCALE(module_name, default_locale)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+char* obs_module_config_path(const char* file);
+char* obs_module_file(const char* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "obs.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// In-memory implementation of the libobs / obs-frontend-api subset used by the plugin.
+// Sources, scenes and scene items are plain objects with reference counts; nothing is
+// rendered. Benchmarks and tests link against it instead of OBS.
+//
+// Every API call is counted and attributed to the scope reported by the scope provider
+// (the plugin's OBS_CALL_SCOPE, see src/obs-call-scope.hpp). Releasing an object that is
+// not alive is logged and counted instead of crashing.
+namespace ObsStub {
+
+// Drop every object and start over with an empty current scene named "Scene"
+void Reset(uint32_t baseWidth = 1920, uint32_t baseHeight = 1080, uint32_t fps = 60);
+
+// Add an input (e.g. the main game capture) of the given size to the current scene
+obs_source_t* AddSceneSource(const char* id, const char* name, uint32_t width, uint32_t height);
+
+// Messages below this level are dropped (default LOG_WARNING)
+void SetLogLevel(int maxLevel);
+
+// Sources and scene items currently alive, and the highest count seen since Reset()
+size_t GetLiveSourceCount();
+size_t GetPeakLiveSourceCount();
+size_t GetLiveSceneItemCount();
+size_t GetPeakLiveSceneItemCount();
+
+// Called for every position/scale/rotation write to a scene item
+using TransformWriteHook = std::function<void(obs_sceneitem_t* item, uint64_t timeNs)>;
+void SetTransformWriteHook(TransformWriteHook hook);
+uint64_t GetTransformWriteCount();
+
+// Returns the name of the component making the current call, or nullptr.
+// Benchmarks built with OBS_CALL_ATTRIBUTION pass &ObsCallScope::Current.
+using ScopeProvider = const char* (*)();
+void SetScopeProvider(ScopeProvider provider);
+
+struct CallCount {
+    std::string api;        // e.g. "obs_sceneitem_set_pos"
+    std::string scope;      // Empty when no scope was active
+    uint64_t calls;
+};
+
+// Calls made by the code under test since Reset(), most frequent first.
+// Nested calls made by the stub itself are not counted.
+std::vector<CallCount> GetCallCounts();
+uint64_t GetCallCount(const char* api);     // Summed over all scopes
+void ResetCallCounts();
+
+// Current reference count of a live source (0 when it is not alive)
+int GetRefCount(const obs_source_t* source);
+
+struct LiveObject {
+    std::string kind;       // "source", "scene", "sceneitem" or "data"
+    std::string name;       // Source name (the owning source for scene items and settings)
+    int refs;
+    std::string createdBy;  // Scope active when the object was created
+};
+
+// Every object still alive; after the code under test shut down, anything beyond the
+// objects set up through Reset()/AddSceneSource() is a leak
+std::vector<LiveObject> GetLiveObjects();
+
+// Releases of objects that were not alive (double releases)
+uint64_t GetInvalidReleaseCount();
+
+} // namespace ObsStub
@@ -0,0 +1,102 @@
+#pragma once
+
+// Headless stand-in for the subset of libobs the plugin uses (see obs-stub.hpp)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "graphics/vec2.h"
+#include "util/base.h"
+#include "util/bmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct obs_source obs_source_t;
+typedef struct obs_scene obs_scene_t;
+typedef struct obs_scene_item obs_sceneitem_t;
+typedef struct obs_data obs_data_t;
+
+enum obs_blending_type {
+    OBS_BLEND_NORMAL,
+    OBS_BLEND_ADDITIVE,
+    OBS_BLEND_SUBTRACT,
+    OBS_BLEND_SCREEN,
+    OBS_BLEND_MULTIPLY,
+    OBS_BLEND_LIGHTEN,
+    OBS_BLEND_DARKEN,
+};
+
+struct obs_video_info {
+    const char* graphics_module;
+    uint32_t fps_num;
+    uint32_t fps_den;
+    uint32_t base_width;
+    uint32_t base_height;
+    uint32_t output_width;
+    uint32_t output_height;
+};
+
+typedef void (*obs_source_enum_proc_t)(obs_source_t* parent, obs_source_t* child, void* param);
+
+bool obs_get_video_info(struct obs_video_info* ovi);
+
+// Settings
+obs_data_t* obs_data_create(void);
+void obs_data_addref(obs_data_t* data);
+void obs_data_release(obs_data_t* data);
+void obs_data_set_string(obs_data_t* data, const char* name, const char* val);
+void obs_data_set_int(obs_data_t* data, const char* name, long long val);
+void obs_data_set_double(obs_data_t* data, const char* name, double val);
+void obs_data_set_bool(obs_data_t* data, const char* name, bool val);
+const char* obs_data_get_string(obs_data_t* data, const char* name);
+long long obs_data_get_int(obs_data_t* data, const char* name);
+double obs_data_get_double(obs_data_t* data, const char* name);
+bool obs_data_get_bool(obs_data_t* data, const char* name);
+
+// Sources
+obs_source_t* obs_source_create(const char* id, const char* name, obs_data_t* settings, obs_data_t* hotkey_data);
+obs_source_t* obs_source_create_private(const char* id, const char* name, obs_data_t* settings);
+obs_source_t* obs_source_get_ref(obs_source_t* source);
+void obs_source_addref(obs_source_t* source);
+void obs_source_release(obs_source_t* source);
+obs_source_t* obs_get_source_by_name(const char* name);
+const char* obs_source_get_name(const obs_source_t* source);
+const char* obs_source_get_id(const obs_source_t* source);
+uint32_t obs_source_get_width(obs_source_t* source);
+uint32_t obs_source_get_height(obs_source_t* source);
+obs_data_t* obs_source_get_settings(const obs_source_t* source);
+obs_data_t* obs_source_get_private_settings(obs_source_t* source);
+void obs_source_update(obs_source_t* source, obs_data_t* settings);
+void obs_source_filter_add(obs_source_t* source, obs_source_t* filter);
+void obs_source_filter_remove(obs_source_t* source, obs_source_t* filter);
+void obs_source_enum_filters(obs_source_t* source, obs_source_enum_proc_t callback, void* param);
+
+// Scenes
+obs_scene_t* obs_scene_create(const char* name);
+void obs_scene_release(obs_scene_t* scene);
+obs_source_t* obs_scene_get_source(const obs_scene_t* scene);
+obs_scene_t* obs_scene_from_source(const obs_source_t* source);
+obs_sceneitem_t* obs_scene_find_source(obs_scene_t* scene, const char* name);
+obs_sceneitem_t* obs_scene_add(obs_scene_t* scene, obs_source_t* source);
+void obs_scene_enum_items(obs_scene_t* scene, bool (*callback)(obs_scene_t*, obs_sceneitem_t*, void*), void* param);
+
+// Scene items
+void obs_sceneitem_addref(obs_sceneitem_t* item);
+void obs_sceneitem_release(obs_sceneitem_t* item);
+void obs_sceneitem_remove(obs_sceneitem_t* item);
+obs_source_t* obs_sceneitem_get_source(const obs_sceneitem_t* item);
+void obs_sceneitem_set_pos(obs_sceneitem_t* item, const struct vec2* pos);
+void obs_sceneitem_get_pos(const obs_sceneitem_t* item, struct vec2* pos);
+void obs_sceneitem_set_scale(obs_sceneitem_t* item, const struct vec2* scale);
+void obs_sceneitem_get_scale(const obs_sceneitem_t* item, struct vec2* scale);
+void obs_sceneitem_set_rot(obs_sceneitem_t* item, float rot_deg);
+float obs_sceneitem_get_rot(const obs_sceneitem_t* item);
+bool obs_sceneitem_set_visible(obs_sceneitem_t* item, bool visible);
+bool obs_sceneitem_visible(const obs_sceneitem_t* item);
+void obs_sceneitem_set_blending_mode(obs_sceneitem_t* item, enum obs_blending_type type);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    LOG_ERROR = 100,
+    LOG_WARNING = 200,
+    LOG_INFO = 300,
+    LOG_DEBUG = 400
+};
+
+void blogva(int log_level, const char* format, va_list args);
+void blog(int log_level, const char* format, ...);
+
+#ifdef __cplusplus
+}
+#endif
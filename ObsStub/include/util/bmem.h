@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* bmalloc(size_t size);
+void bfree(void* ptr);
+char* bstrdup(const char* str);
+
+#ifdef __cplusplus
+}
+#endif
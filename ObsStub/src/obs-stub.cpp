@@ -0,0 +1,815 @@
+#include "obs-stub.hpp"
+#include "obs-frontend-api.h"
+#include "obs-module.h"
+#include "util/platform.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+// The plugin only touches libobs from the UI thread, so neither does the stub lock anything
+
+struct obs_data {
+    int refs = 1;
+    const char* createdBy = nullptr;    // Attribution scope at creation
+    const obs_source* owner = nullptr;  // Set for a source's settings / private settings
+    std::map<std::string, std::variant<long long, double, bool, std::string>> values;
+};
+
+struct obs_source {
+    int refs = 1;
+    std::string id;
+    std::string name;
+    bool isPrivate = false;
+    const char* createdBy = nullptr;
+    uint32_t width = 0;     // Used when the settings carry no "width"/"height"
+    uint32_t height = 0;
+    obs_data_t* settings = nullptr;
+    obs_data_t* privateSettings = nullptr;
+    std::vector<obs_source_t*> filters;
+    obs_scene_t* scene = nullptr;   // Set for scene sources
+};
+
+struct obs_scene {
+    obs_source_t* source = nullptr;
+    std::vector<obs_sceneitem_t*> items;
+};
+
+struct obs_scene_item {
+    int refs = 1;   // The scene's reference until the item is removed
+    obs_scene_t* scene = nullptr;
+    obs_source_t* source = nullptr;
+    const char* createdBy = nullptr;
+    vec2 pos{0.0f, 0.0f};
+    vec2 scale{1.0f, 1.0f};
+    float rot = 0.0f;
+    bool visible = true;
+    bool removed = false;
+    obs_blending_type blending = OBS_BLEND_NORMAL;
+};
+
+namespace {
+
+// Calls are keyed by (API, scope) pointers: __func__ and the scope names are static strings,
+// so counting is a hash lookup without string copies. Names are merged when reported.
+struct CallKey {
+    const char* api;
+    const char* scope;
+    bool operator==(const CallKey& other) const { return api == other.api && scope == other.scope; }
+};
+
+struct CallKeyHash {
+    size_t operator()(const CallKey& key) const {
+        return std::hash<const void*>()(key.api) * 31 + std::hash<const void*>()(key.scope);
+    }
+};
+
+struct StubState {
+    obs_video_info video{};
+    obs_scene_t* currentScene = nullptr;
+    std::vector<obs_source_t*> sources;         // Every live source, in creation order
+    std::unordered_set<obs_source_t*> liveSources;
+    std::unordered_set<obs_sceneitem_t*> items; // Every live scene item
+    std::unordered_set<obs_data_t*> data;
+    size_t peakSources = 0;
+    size_t peakItems = 0;
+    uint64_t transformWrites = 0;
+    ObsStub::TransformWriteHook transformHook;
+    ObsStub::ScopeProvider scopeProvider = nullptr;
+    std::unordered_map<CallKey, uint64_t, CallKeyHash> calls;
+    uint64_t invalidReleases = 0;
+    int callDepth = 0;      // > 0 while inside a stub function
+    int logLevel = LOG_WARNING;
+};
+
+StubState& State() {
+    static StubState state;
+    return state;
+}
+
+const char* CurrentScope() {
+    StubState& state = State();
+    return state.scopeProvider ? state.scopeProvider() : nullptr;
+}
+
+// Only calls made by the code under test are counted, not the stub's own nested calls
+// (obs_source_release freeing settings, obs_sceneitem_remove releasing the item, ...)
+class CallGuard {
+public:
+    explicit CallGuard(const char* api) {
+        StubState& state = State();
+        if (api && state.callDepth == 0) {
+            state.calls[CallKey{api, CurrentScope()}]++;
+        }
+        state.callDepth++;
+    }
+    ~CallGuard() { State().callDepth--; }
+};
+
+// Calls made from enum callbacks come from the code under test again
+class CallbackGuard {
+public:
+    CallbackGuard() : m_depth(State().callDepth) { State().callDepth = 0; }
+    ~CallbackGuard() { State().callDepth = m_depth; }
+
+private:
+    int m_depth;
+};
+
+// Release of an object that is not alive: a double release, or a pointer OBS never handed out
+void InvalidRelease(const char* api, const void* object) {
+    State().invalidReleases++;
+    const char* scope = CurrentScope();
+    blog(LOG_ERROR, "[ObsStub] %s(%p) on an object that is not alive (scope: %s)", api, object,
+         scope ? scope : "none");
+}
+
+#define COUNT_CALL() CallGuard callGuard(__func__)
+
+obs_source_t* NewSource(const char* id, const char* name, obs_data_t* settings, bool isPrivate) {
+    StubState& state = State();
+
+    obs_source_t* source = new obs_source;
+    source->id = id ? id : "";
+    source->name = name ? name : "";
+    source->isPrivate = isPrivate;
+    source->createdBy = CurrentScope();
+    source->settings = obs_data_create();
+    source->privateSettings = obs_data_create();
+    source->settings->owner = source;
+    source->privateSettings->owner = source;
+    if (settings) {
+        source->settings->values = settings->values;
+    }
+
+    state.sources.push_back(source);
+    state.liveSources.insert(source);
+    state.peakSources = std::max(state.peakSources, state.sources.size());
+    return source;
+}
+
+void DestroySource(obs_source_t* source) {
+    StubState& state = State();
+    state.sources.erase(std::remove(state.sources.begin(), state.sources.end(), source), state.sources.end());
+    state.liveSources.erase(source);
+
+    for (obs_source_t* filter : source->filters) {
+        obs_source_release(filter);
+    }
+    if (source->scene) {
+        std::vector<obs_sceneitem_t*> items = source->scene->items;
+        for (obs_sceneitem_t* item : items) {
+            obs_sceneitem_remove(item);
+        }
+        if (state.currentScene == source->scene) {
+            state.currentScene = nullptr;
+        }
+        delete source->scene;
+    }
+    obs_data_release(source->settings);
+    obs_data_release(source->privateSettings);
+    delete source;
+}
+
+void NotifyTransformWrite(obs_sceneitem_t* item) {
+    StubState& state = State();
+    state.transformWrites++;
+    if (state.transformHook) {
+        state.transformHook(item, os_gettime_ns());
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Stub control
+// =============================================================================
+
+namespace ObsStub {
+
+void Reset(uint32_t baseWidth, uint32_t baseHeight, uint32_t fps) {
+    StubState& state = State();
+    state.callDepth = 0;
+
+    // Anything still alive was leaked by the previous run; free it without running release logic
+    for (obs_sceneitem_t* item : state.items) {
+        delete item;
+    }
+    for (obs_source_t* source : state.sources) {
+        delete source->scene;
+        delete source;
+    }
+    for (obs_data_t* data : state.data) {
+        delete data;
+    }
+    state.items.clear();
+    state.sources.clear();
+    state.liveSources.clear();
+    state.data.clear();
+    state.calls.clear();
+    state.invalidReleases = 0;
+    state.currentScene = nullptr;
+    state.peakSources = 0;
+    state.peakItems = 0;
+    state.transformWrites = 0;
+
+    state.video = obs_video_info{};
+    state.video.fps_num = fps;
+    state.video.fps_den = 1;
+    state.video.base_width = state.video.output_width = baseWidth;
+    state.video.base_height = state.video.output_height = baseHeight;
+
+    CallGuard setup(nullptr);
+    state.currentScene = obs_scene_create("Scene");
+}
+
+obs_source_t* AddSceneSource(const char* id, const char* name, uint32_t width, uint32_t height) {
+    StubState& state = State();
+    if (!state.currentScene) return nullptr;
+
+    CallGuard setup(nullptr);
+    obs_source_t* source = obs_source_create(id, name, nullptr, nullptr);
+    source->width = width;
+    source->height = height;
+    obs_scene_add(state.currentScene, source);
+    obs_source_release(source);     // The scene item keeps it alive
+    return source;
+}
+
+void SetLogLevel(int maxLevel) {
+    State().logLevel = maxLevel;
+}
+
+size_t GetLiveSourceCount() {
+    return State().sources.size();
+}
+
+size_t GetPeakLiveSourceCount() {
+    return State().peakSources;
+}
+
+size_t GetLiveSceneItemCount() {
+    return State().items.size();
+}
+
+size_t GetPeakLiveSceneItemCount() {
+    return State().peakItems;
+}
+
+void SetTransformWriteHook(TransformWriteHook hook) {
+    State().transformHook = std::move(hook);
+}
+
+uint64_t GetTransformWriteCount() {
+    return State().transformWrites;
+}
+
+void SetScopeProvider(ScopeProvider provider) {
+    State().scopeProvider = provider;
+}
+
+std::vector<CallCount> GetCallCounts() {
+    std::map<std::pair<std::string, std::string>, uint64_t> merged;
+    for (const auto& entry : State().calls) {
+        merged[{entry.first.api, entry.first.scope ? entry.first.scope : ""}] += entry.second;
+    }
+
+    std::vector<CallCount> counts;
+    counts.reserve(merged.size());
+    for (const auto& entry : merged) {
+        counts.push_back(CallCount{entry.first.first, entry.first.second, entry.second});
+    }
+    std::stable_sort(counts.begin(), counts.end(),
+                     [](const CallCount& a, const CallCount& b) { return a.calls > b.calls; });
+    return counts;
+}
+
+uint64_t GetCallCount(const char* api) {
+    if (!api) return 0;
+    uint64_t total = 0;
+    for (const auto& entry : State().calls) {
+        if (std::strcmp(entry.first.api, api) == 0) total += entry.second;
+    }
+    return total;
+}
+
+void ResetCallCounts() {
+    State().calls.clear();
+}
+
+int GetRefCount(const obs_source_t* source) {
+    obs_source_t* key = const_cast<obs_source_t*>(source);
+    return State().liveSources.count(key) ? source->refs : 0;
+}
+
+std::vector<LiveObject> GetLiveObjects() {
+    StubState& state = State();
+    std::vector<LiveObject> objects;
+
+    for (obs_source_t* source : state.sources) {
+        objects.push_back(LiveObject{source->scene ? "scene" : "source", source->name, source->refs,
+                                     source->createdBy ? source->createdBy : ""});
+    }
+    for (obs_sceneitem_t* item : state.items) {
+        objects.push_back(LiveObject{"sceneitem", item->source->name, item->refs,
+                                     item->createdBy ? item->createdBy : ""});
+    }
+    for (obs_data_t* data : state.data) {
+        // A source's own settings only count once someone else holds a reference
+        if (data->owner && data->refs == 1) continue;
+        objects.push_back(LiveObject{"data", data->owner ? data->owner->name : "", data->refs,
+                                     data->createdBy ? data->createdBy : ""});
+    }
+    return objects;
+}
+
+uint64_t GetInvalidReleaseCount() {
+    return State().invalidReleases;
+}
+
+} // namespace ObsStub
+
+// =============================================================================
+// util
+// =============================================================================
+
+extern "C" {
+
+void blogva(int log_level, const char* format, va_list args) {
+    if (log_level > State().logLevel) return;
+
+    const char* prefix = log_level <= LOG_ERROR ? "error" : log_level <= LOG_WARNING ? "warning" :
+                         log_level <= LOG_INFO ? "info" : "debug";
+    std::fprintf(stderr, "%s: ", prefix);
+    std::vfprintf(stderr, format, args);
+    std::fputc('\n', stderr);
+}
+
+void blog(int log_level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    blogva(log_level, format, args);
+    va_end(args);
+}
+
+uint64_t os_gettime_ns(void) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void* bmalloc(size_t size) {
+    return std::malloc(size ? size : 1);
+}
+
+void bfree(void* ptr) {
+    std::free(ptr);
+}
+
+char* bstrdup(const char* str) {
+    if (!str) return nullptr;
+    size_t length = std::strlen(str);
+    char* copy = static_cast<char*>(bmalloc(length + 1));
+    std::memcpy(copy, str, length + 1);
+    return copy;
+}
+
+char* obs_module_config_path(const char* file) {
+    COUNT_CALL();
+    std::string path = std::string("obs-stub-config/") + (file ? file : "");
+    return bstrdup(path.c_str());
+}
+
+char* obs_module_file(const char* file) {
+    COUNT_CALL();
+    std::string path = std::string("obs-stub-data/") + (file ? file : "");
+    return bstrdup(path.c_str());
+}
+
+bool obs_get_video_info(struct obs_video_info* ovi) {
+    COUNT_CALL();
+    if (!ovi || State().video.base_width == 0) return false;
+    *ovi = State().video;
+    return true;
+}
+
+// =============================================================================
+// obs_data
+// =============================================================================
+
+obs_data_t* obs_data_create(void) {
+    COUNT_CALL();
+    obs_data_t* data = new obs_data;
+    data->createdBy = CurrentScope();
+    State().data.insert(data);
+    return data;
+}
+
+void obs_data_addref(obs_data_t* data) {
+    COUNT_CALL();
+    if (data) data->refs++;
+}
+
+void obs_data_release(obs_data_t* data) {
+    COUNT_CALL();
+    if (!data) return;
+    if (!State().data.count(data)) {
+        InvalidRelease(__func__, data);
+        return;
+    }
+    if (--data->refs > 0) return;
+    State().data.erase(data);
+    delete data;
+}
+
+void obs_data_set_string(obs_data_t* data, const char* name, const char* val) {
+    COUNT_CALL();
+    if (data && name) data->values[name] = std::string(val ? val : "");
+}
+
+void obs_data_set_int(obs_data_t* data, const char* name, long long val) {
+    COUNT_CALL();
+    if (data && name) data->values[name] = val;
+}
+
+void obs_data_set_double(obs_data_t* data, const char* name, double val) {
+    COUNT_CALL();
+    if (data && name) data->values[name] = val;
+}
+
+void obs_data_set_bool(obs_data_t* data, const char* name, bool val) {
+    COUNT_CALL();
+    if (data && name) data->values[name] = val;
+}
+
+const char* obs_data_get_string(obs_data_t* data, const char* name) {
+    COUNT_CALL();
+    if (!data || !name) return "";
+    auto it = data->values.find(name);
+    if (it == data->values.end()) return "";
+    const std::string* value = std::get_if<std::string>(&it->second);
+    return value ? value->c_str() : "";
+}
+
+long long obs_data_get_int(obs_data_t* data, const char* name) {
+    COUNT_CALL();
+    if (!data || !name) return 0;
+    auto it = data->values.find(name);
+    if (it == data->values.end()) return 0;
+    if (const long long* value = std::get_if<long long>(&it->second)) return *value;
+    if (const double* value = std::get_if<double>(&it->second)) return static_cast<long long>(*value);
+    return 0;
+}
+
+double obs_data_get_double(obs_data_t* data, const char* name) {
+    COUNT_CALL();
+    if (!data || !name) return 0.0;
+    auto it = data->values.find(name);
+    if (it == data->values.end()) return 0.0;
+    if (const double* value = std::get_if<double>(&it->second)) return *value;
+    if (const long long* value = std::get_if<long long>(&it->second)) return static_cast<double>(*value);
+    return 0.0;
+}
+
+bool obs_data_get_bool(obs_data_t* data, const char* name) {
+    COUNT_CALL();
+    if (!data || !name) return false;
+    auto it = data->values.find(name);
+    if (it == data->values.end()) return false;
+    const bool* value = std::get_if<bool>(&it->second);
+    return value ? *value : false;
+}
+
+// =============================================================================
+// Sources
+// =============================================================================
+
+obs_source_t* obs_source_create(const char* id, const char* name, obs_data_t* settings, obs_data_t* hotkey_data) {
+    COUNT_CALL();
+    (void)hotkey_data;
+    return NewSource(id, name, settings, false);
+}
+
+obs_source_t* obs_source_create_private(const char* id, const char* name, obs_data_t* settings) {
+    COUNT_CALL();
+    return NewSource(id, name, settings, true);
+}
+
+obs_source_t* obs_source_get_ref(obs_source_t* source) {
+    COUNT_CALL();
+    if (source) source->refs++;
+    return source;
+}
+
+void obs_source_addref(obs_source_t* source) {
+    COUNT_CALL();
+    if (source) source->refs++;
+}
+
+void obs_source_release(obs_source_t* source) {
+    COUNT_CALL();
+    if (!source) return;
+    if (!State().liveSources.count(source)) {
+        InvalidRelease(__func__, source);
+        return;
+    }
+    if (--source->refs > 0) return;
+    DestroySource(source);
+}
+
+obs_source_t* obs_get_source_by_name(const char* name) {
+    COUNT_CALL();
+    if (!name) return nullptr;
+    for (obs_source_t* source : State().sources) {
+        if (!source->isPrivate && source->name == name) {
+            source->refs++;
+            return source;
+        }
+    }
+    return nullptr;
+}
+
+const char* obs_source_get_name(const obs_source_t* source) {
+    COUNT_CALL();
+    return source ? source->name.c_str() : nullptr;
+}
+
+const char* obs_source_get_id(const obs_source_t* source) {
+    COUNT_CALL();
+    return source ? source->id.c_str() : nullptr;
+}
+
+uint32_t obs_source_get_width(obs_source_t* source) {
+    COUNT_CALL();
+    if (!source) return 0;
+    long long width = obs_data_get_int(source->settings, "width");
+    return width > 0 ? static_cast<uint32_t>(width) : source->width;
+}
+
+uint32_t obs_source_get_height(obs_source_t* source) {
+    COUNT_CALL();
+    if (!source) return 0;
+    long long height = obs_data_get_int(source->settings, "height");
+    return height > 0 ? static_cast<uint32_t>(height) : source->height;
+}
+
+obs_data_t* obs_source_get_settings(const obs_source_t* source) {
+    COUNT_CALL();
+    if (!source) return nullptr;
+    obs_data_addref(source->settings);
+    return source->settings;
+}
+
+obs_data_t* obs_source_get_private_settings(obs_source_t* source) {
+    COUNT_CALL();
+    if (!source) return nullptr;
+    obs_data_addref(source->privateSettings);
+    return source->privateSettings;
+}
+
+void obs_source_update(obs_source_t* source, obs_data_t* settings) {
+    COUNT_CALL();
+    if (!source || !settings || settings == source->settings) return;
+    for (const auto& entry : settings->values) {
+        source->settings->values[entry.first] = entry.second;
+    }
+}
+
+void obs_source_filter_add(obs_source_t* source, obs_source_t* filter) {
+    COUNT_CALL();
+    if (!source || !filter) return;
+    if (std::find(source->filters.begin(), source->filters.end(), filter) != source->filters.end()) return;
+    filter->refs++;
+    source->filters.push_back(filter);
+}
+
+void obs_source_filter_remove(obs_source_t* source, obs_source_t* filter) {
+    COUNT_CALL();
+    if (!source || !filter) return;
+    auto it = std::find(source->filters.begin(), source->filters.end(), filter);
+    if (it == source->filters.end()) return;
+    source->filters.erase(it);
+    obs_source_release(filter);
+}
+
+void obs_source_enum_filters(obs_source_t* source, obs_source_enum_proc_t callback, void* param) {
+    COUNT_CALL();
+    if (!source || !callback) return;
+    // Callbacks may remove the filter they are given
+    std::vector<obs_source_t*> filters = source->filters;
+    CallbackGuard guard;
+    for (obs_source_t* filter : filters) {
+        callback(source, filter, param);
+    }
+}
+
+// =============================================================================
+// Scenes
+// =============================================================================
+
+obs_scene_t* obs_scene_create(const char* name) {
+    COUNT_CALL();
+    obs_source_t* source = NewSource("scene", name, nullptr, false);
+    source->scene = new obs_scene;
+    source->scene->source = source;
+    return source->scene;
+}
+
+void obs_scene_release(obs_scene_t* scene) {
+    COUNT_CALL();
+    if (scene) obs_source_release(scene->source);
+}
+
+obs_source_t* obs_scene_get_source(const obs_scene_t* scene) {
+    COUNT_CALL();
+    return scene ? scene->source : nullptr;
+}
+
+obs_scene_t* obs_scene_from_source(const obs_source_t* source) {
+    COUNT_CALL();
+    return source ? source->scene : nullptr;
+}
+
+obs_sceneitem_t* obs_scene_find_source(obs_scene_t* scene, const char* name) {
+    COUNT_CALL();
+    if (!scene || !name) return nullptr;
+    for (obs_sceneitem_t* item : scene->items) {
+        if (item->source->name == name) return item;
+    }
+    return nullptr;
+}
+
+obs_sceneitem_t* obs_scene_add(obs_scene_t* scene, obs_source_t* source) {
+    COUNT_CALL();
+    if (!scene || !source) return nullptr;
+    StubState& state = State();
+
+    obs_sceneitem_t* item = new obs_scene_item;
+    item->scene = scene;
+    item->source = source;
+    item->createdBy = CurrentScope();
+    source->refs++;
+    scene->items.push_back(item);
+
+    state.items.insert(item);
+    state.peakItems = std::max(state.peakItems, state.items.size());
+    return item;
+}
+
+void obs_scene_enum_items(obs_scene_t* scene, bool (*callback)(obs_scene_t*, obs_sceneitem_t*, void*), void* param) {
+    COUNT_CALL();
+    if (!scene || !callback) return;
+    std::vector<obs_sceneitem_t*> items = scene->items;
+    CallbackGuard guard;
+    for (obs_sceneitem_t* item : items) {
+        if (!callback(scene, item, param)) break;
+    }
+}
+
+// =============================================================================
+// Scene items
+// =============================================================================
+
+void obs_sceneitem_addref(obs_sceneitem_t* item) {
+    COUNT_CALL();
+    if (item) item->refs++;
+}
+
+void obs_sceneitem_release(obs_sceneitem_t* item) {
+    COUNT_CALL();
+    if (!item) return;
+    if (!State().items.count(item)) {
+        InvalidRelease(__func__, item);
+        return;
+    }
+    if (--item->refs > 0) return;
+    State().items.erase(item);
+    obs_source_release(item->source);
+    delete item;
+}
+
+void obs_sceneitem_remove(obs_sceneitem_t* item) {
+    COUNT_CALL();
+    if (!item || item->removed) return;
+    item->removed = true;
+
+    std::vector<obs_sceneitem_t*>& items = item->scene->items;
+    items.erase(std::remove(items.begin(), items.end(), item), items.end());
+    obs_sceneitem_release(item);
+}
+
+obs_source_t* obs_sceneitem_get_source(const obs_sceneitem_t* item) {
+    COUNT_CALL();
+    return item ? item->source : nullptr;
+}
+
+void obs_sceneitem_set_pos(obs_sceneitem_t* item, const struct vec2* pos) {
+    COUNT_CALL();
+    if (!item || !pos) return;
+    item->pos = *pos;
+    NotifyTransformWrite(item);
+}
+
+void obs_sceneitem_get_pos(const obs_sceneitem_t* item, struct vec2* pos) {
+    COUNT_CALL();
+    if (item && pos) *pos = item->pos;
+}
+
+void obs_sceneitem_set_scale(obs_sceneitem_t* item, const struct vec2* scale) {
+    COUNT_CALL();
+    if (!item || !scale) return;
+    item->scale = *scale;
+    NotifyTransformWrite(item);
+}
+
+void obs_sceneitem_get_scale(const obs_sceneitem_t* item, struct vec2* scale) {
+    COUNT_CALL();
+    if (item && scale) *scale = item->scale;
+}
+
+void obs_sceneitem_set_rot(obs_sceneitem_t* item, float rot_deg) {
+    COUNT_CALL();
+    if (!item) return;
+    item->rot = rot_deg;
+    NotifyTransformWrite(item);
+}
+
+float obs_sceneitem_get_rot(const obs_sceneitem_t* item) {
+    COUNT_CALL();
+    return item ? item->rot : 0.0f;
+}
+
+bool obs_sceneitem_set_visible(obs_sceneitem_t* item, bool visible) {
+    COUNT_CALL();
+    if (!item) return false;
+    item->visible = visible;
+    return true;
+}
+
+bool obs_sceneitem_visible(const obs_sceneitem_t* item) {
+    COUNT_CALL();
+    return item ? item->visible : false;
+}
+
+void obs_sceneitem_set_blending_mode(obs_sceneitem_t* item, enum obs_blending_type type) {
+    COUNT_CALL();
+    if (item) item->blending = type;
+}
+
+// =============================================================================
+// Frontend
+// =============================================================================
+
+obs_source_t* obs_frontend_get_current_scene(void) {
+    COUNT_CALL();
+    obs_scene_t* scene = State().currentScene;
+    if (!scene) return nullptr;
+    scene->source->refs++;
+    return scene->source;
+}
+
+void obs_frontend_set_current_scene(obs_source_t* scene) {
+    COUNT_CALL();
+    if (scene && scene->scene) {
+        State().currentScene = scene->scene;
+    }
+}
+
+void obs_frontend_get_scenes(struct obs_frontend_source_list* sources) {
+    COUNT_CALL();
+    if (!sources) return;
+
+    std::vector<obs_source_t*> scenes;
+    for (obs_source_t* source : State().sources) {
+        if (source->scene) scenes.push_back(source);
+    }
+
+    sources->sources.array = static_cast<obs_source_t**>(bmalloc(scenes.size() * sizeof(obs_source_t*)));
+    sources->sources.num = scenes.size();
+    sources->sources.capacity = scenes.size();
+    for (size_t i = 0; i < scenes.size(); i++) {
+        scenes[i]->refs++;
+        sources->sources.array[i] = scenes[i];
+    }
+}
+
+void obs_frontend_source_list_free(struct obs_frontend_source_list* source_list) {
+    COUNT_CALL();
+    if (!source_list) return;
+    for (size_t i = 0; i < source_list->sources.num; i++) {
+        obs_source_release(source_list->sources.array[i]);
+    }
+    bfree(source_list->sources.array);
+    source_list->sources.array = nullptr;
+    source_list->sources.num = 0;
+    source_list->sources.capacity = 0;
+}
+
+} // extern "C"
@@ -0,0 +1,353 @@
+#include "chat-ingestion-hub.hpp"
+#include "plugin-metrics.hpp"
+#include <obs-module.h>
+#include <util/base.h>
+#include <util/platform.h>
+#include <QDateTime>
+#include <QNetworkAccessManager>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTimer>
+#include <algorithm>
+
+// Events younger than this are held back so a slightly later page from another chat
+// can still be merged in front of them. Pages usually arrive several seconds after
+// their messages were posted, so most events pass straight through.
+static const int64_t REORDER_WINDOW_MS = 1000;
+
+// Cursors are saved at most this often while monitoring; a crash replays no more than this
+static const int CURSOR_SAVE_INTERVAL_MS = 15 * 1000;
+
+// Per-chat metrics are copied into g_metrics this often while monitoring
+static const int SOURCE_METRICS_INTERVAL_MS = 1000;
+static_assert(MAX_CHAT_SOURCES <= static_cast<int>(PluginMetrics::MAX_SOURCE_SLOTS),
+              "every chat needs a metrics slot");
+
+// Events a viewer can send back to back before the per-minute rate applies
+static const double VIEWER_CHAT_BURST = 3.0;
+static const double VIEWER_PAID_BURST = 10.0;
+
+std::vector<std::string> ParseVideoIdList(const std::string& text) {
+    std::vector<std::string> ids;
+    const QStringList parts = QString::fromStdString(text).split(QRegularExpression("[\\s,;]+"), Qt::SkipEmptyParts);
+    for (const QString& part : parts) {
+        std::string id = part.toStdString();
+        if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+ChatIngestionHub::ChatIngestionHub(QObject* parent)
+    : QObject(parent)
+    , m_networkManager(new QNetworkAccessManager(this))
+    , m_quota(std::make_shared<QuotaTracker>())
+    , m_replayClient(nullptr)
+    , m_recordingEnabled(false)
+    , m_skipBacklog(true)
+    , m_plannedStreamHours(8.0)
+    , m_isRunning(false)
+    , m_freeChatTimer(new QTimer(this))
+    , m_nextSequence(0)
+    , m_drainTimer(new QTimer(this))
+    , m_cursorSaveTimer(new QTimer(this))
+    , m_sourceMetricsTimer(new QTimer(this))
+{
+    m_drainTimer->setSingleShot(true);
+    connect(m_drainTimer, &QTimer::timeout, this, &ChatIngestionHub::DrainQueue);
+
+    m_freeChatTimer->setSingleShot(true);
+    m_freeChatTimer->setInterval(0);
+    connect(m_freeChatTimer, &QTimer::timeout, this, &ChatIngestionHub::SampleFreeChat);
+
+    m_cursorSaveTimer->setInterval(CURSOR_SAVE_INTERVAL_MS);
+    connect(m_cursorSaveTimer, &QTimer::timeout, this, &ChatIngestionHub::OnCursorSaveTimer);
+
+    m_sourceMetricsTimer->setInterval(SOURCE_METRICS_INTERVAL_MS);
+    connect(m_sourceMetricsTimer, &QTimer::timeout, this, &ChatIngestionHub::PublishSourceMetrics);
+
+    SetViewerRateLimits(DEFAULT_VIEWER_CHAT_PER_MINUTE, DEFAULT_VIEWER_PAID_PER_MINUTE);
+    g_metrics.viewerLimiterBytes.store(m_viewerLimiter.MemoryBytes(), std::memory_order_relaxed);
+}
+
+ChatIngestionHub::~ChatIngestionHub() {
+    Stop();
+}
+
+YouTubeChatClient* ChatIngestionHub::CreateClient(const std::string& videoId) {
+    YouTubeChatClient* client = new YouTubeChatClient(m_networkManager, m_quota, this);
+    client->SetApiKey(m_apiKey);
+    if (!m_apiBaseUrl.empty()) {
+        client->SetApiBaseUrl(m_apiBaseUrl);
+    }
+    client->SetRecordingEnabled(m_recordingEnabled);
+    client->SetSkipBacklog(m_skipBacklog);
+    client->SetPlannedStreamHours(m_plannedStreamHours);
+    client->SetVideoId(videoId);
+    client->SetDonationCallback([this](const DonationEvent& event) { Enqueue(event); });
+    return client;
+}
+
+void ChatIngestionHub::SetApiKey(const std::string& apiKey) {
+    m_apiKey = apiKey;
+    for (YouTubeChatClient* client : m_clients) {
+        client->SetApiKey(apiKey);
+    }
+}
+
+void ChatIngestionHub::SetApiBaseUrl(const std::string& baseUrl) {
+    m_apiBaseUrl = baseUrl;
+    for (YouTubeChatClient* client : m_clients) {
+        client->SetApiBaseUrl(baseUrl);
+    }
+}
+
+void ChatIngestionHub::SetVideoIds(const std::vector<std::string>& videoIds) {
+    std::vector<YouTubeChatClient*> clients;
+    for (const std::string& videoId : videoIds) {
+        if (static_cast<int>(clients.size()) >= MAX_CHAT_SOURCES) {
+            blog(LOG_WARNING, "[YouTube Chat] Only %d chats can be monitored at once; ignoring %s",
+                 MAX_CHAT_SOURCES, videoId.c_str());
+            continue;
+        }
+
+        auto existing = std::find_if(m_clients.begin(), m_clients.end(),
+                                     [&](YouTubeChatClient* client) { return client->GetVideoId() == videoId; });
+        if (existing != m_clients.end()) {
+            clients.push_back(*existing);
+            m_clients.erase(existing);
+        } else {
+            YouTubeChatClient* client = CreateClient(videoId);
+            if (m_isRunning) {
+                client->Start();
+            }
+            clients.push_back(client);
+        }
+    }
+
+    // Whatever is left is no longer configured
+    for (YouTubeChatClient* client : m_clients) {
+        client->Stop();
+        client->deleteLater();
+    }
+
+    m_clients = std::move(clients);
+    m_quota->SetSharedBy(static_cast<int>(m_clients.size()));
+    if (m_clients.empty()) {
+        m_isRunning = false;
+        m_cursorSaveTimer->stop();
+        m_sourceMetricsTimer->stop();
+    }
+    PublishSourceMetrics();
+}
+
+void ChatIngestionHub::SetRecordingEnabled(bool enabled) {
+    m_recordingEnabled = enabled;
+    for (YouTubeChatClient* client : m_clients) {
+        client->SetRecordingEnabled(enabled);
+    }
+}
+
+void ChatIngestionHub::SetSkipBacklog(bool skip) {
+    m_skipBacklog = skip;
+    for (YouTubeChatClient* client : m_clients) {
+        client->SetSkipBacklog(skip);
+    }
+}
+
+void ChatIngestionHub::SetDailyQuota(int units) {
+    m_quota->SetDailyBudget(units);
+}
+
+void ChatIngestionHub::SetPlannedStreamHours(double hours) {
+    m_plannedStreamHours = hours;
+    for (YouTubeChatClient* client : m_clients) {
+        client->SetPlannedStreamHours(hours);
+    }
+}
+
+void ChatIngestionHub::Start() {
+    if (m_isRunning) return;
+
+    if (m_clients.empty()) {
+        blog(LOG_WARNING, "[YouTube Chat] Cannot start: no Video ID set");
+        return;
+    }
+
+    for (YouTubeChatClient* client : m_clients) {
+        client->Start();
+    }
+    m_isRunning = std::any_of(m_clients.begin(), m_clients.end(),
+                              [](YouTubeChatClient* client) { return client->IsRunning(); });
+    if (m_isRunning && m_clients.size() > 1) {
+        blog(LOG_INFO, "[YouTube Chat] Monitoring %d chats", static_cast<int>(m_clients.size()));
+    }
+    if (m_isRunning) {
+        m_cursorSaveTimer->start();
+        m_sourceMetricsTimer->start();
+    }
+    PublishSourceMetrics();
+}
+
+void ChatIngestionHub::Stop() {
+    if (!m_isRunning) return;
+
+    for (YouTubeChatClient* client : m_clients) {
+        client->Stop();
+    }
+    m_isRunning = false;
+    m_cursorSaveTimer->stop();
+    m_sourceMetricsTimer->stop();
+    PublishSourceMetrics();
+}
+
+void ChatIngestionHub::OnCursorSaveTimer() {
+    if (!m_cursorSaveCallback) return;
+
+    // Only write the config when some chat has actually moved on
+    std::string pageTokens;
+    for (YouTubeChatClient* client : m_clients) {
+        pageTokens += client->GetCursor().pageToken;
+        pageTokens += '\n';
+    }
+    if (pageTokens == m_savedPageTokens) return;
+
+    m_savedPageTokens = std::move(pageTokens);
+    m_cursorSaveCallback();
+}
+
+void ChatIngestionHub::SetViewerRateLimits(int chatPerMinute, int paidPerMinute) {
+    m_viewerLimiter.SetLimit(ViewerEventClass::FreeChat, chatPerMinute, VIEWER_CHAT_BURST);
+    m_viewerLimiter.SetLimit(ViewerEventClass::Paid, paidPerMinute, VIEWER_PAID_BURST);
+}
+
+void ChatIngestionHub::Enqueue(const DonationEvent& event) {
+    ViewerEventClass eventClass = event.type == DonationType::ChatMessage ? ViewerEventClass::FreeChat
+                                                                          : ViewerEventClass::Paid;
+    uint64_t nowNs = os_gettime_ns();
+    bool admitted = m_viewerLimiter.Admit(event.authorChannelId, eventClass, nowNs);
+    g_metrics.viewerLimiterEntries.store(m_viewerLimiter.Size(), std::memory_order_relaxed);
+    if (!admitted) {
+        g_metrics.viewerLimiterSuppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // After the per-viewer limit, so one spammer cannot push everyone else's chance down
+    if (eventClass == ViewerEventClass::FreeChat) {
+        m_freeChatBatch.push_back(event);
+        if (!m_freeChatTimer->isActive()) {
+            m_freeChatTimer->start();
+        }
+        return;
+    }
+
+    Push(event);
+}
+
+void ChatIngestionHub::SampleFreeChat() {
+    m_freeChatSampler.SampleBatch(m_freeChatBatch.size(), os_gettime_ns(), m_freeChatKeep);
+    g_metrics.freeChatRateMilli.store(static_cast<uint64_t>(m_freeChatSampler.GetArrivalRate() * 1000.0),
+                                      std::memory_order_relaxed);
+    g_metrics.freeChatSampleProbabilityMilli.store(
+        static_cast<uint64_t>(m_freeChatSampler.GetSampleProbability() * 1000.0), std::memory_order_relaxed);
+
+    for (size_t i = 0; i < m_freeChatBatch.size(); i++) {
+        if (m_freeChatKeep[i]) {
+            Push(m_freeChatBatch[i]);
+        } else {
+            g_metrics.freeChatSampledOut.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    m_freeChatBatch.clear();
+}
+
+void ChatIngestionHub::Push(const DonationEvent& event) {
+    int64_t now = QDateTime::currentMSecsSinceEpoch();
+
+    // A server clock ahead of ours must not hold an event back for longer than the window.
+    // Events without a post time (local injection) have nothing to wait for.
+    int64_t orderMs = event.publishedAtMs > 0 ? std::min(event.publishedAtMs, now) : now - REORDER_WINDOW_MS;
+    m_pending.push(PendingEvent{event, orderMs, m_nextSequence++});
+    g_metrics.hubQueueDepth.store(m_pending.size(), std::memory_order_relaxed);
+    ScheduleDrain();
+}
+
+void ChatIngestionHub::ScheduleDrain() {
+    if (m_pending.empty()) return;
+
+    int64_t releaseAt = m_pending.top().orderMs + REORDER_WINDOW_MS;
+    int delay = static_cast<int>(std::clamp<int64_t>(releaseAt - QDateTime::currentMSecsSinceEpoch(),
+                                                     0, REORDER_WINDOW_MS));
+
+    // Only move the timer earlier; a batch of events costs one wakeup
+    if (!m_drainTimer->isActive() || m_drainTimer->remainingTime() > delay) {
+        m_drainTimer->start(delay);
+    }
+}
+
+void ChatIngestionHub::DrainQueue() {
+    int64_t cutoff = QDateTime::currentMSecsSinceEpoch() - REORDER_WINDOW_MS;
+
+    while (!m_pending.empty() && m_pending.top().orderMs <= cutoff) {
+        DonationEvent event = m_pending.top().event;
+        m_pending.pop();
+        event.timestamps.dispatchedNs = os_gettime_ns();
+        if (m_donationCallback) {
+            m_donationCallback(event);
+        }
+    }
+    g_metrics.hubQueueDepth.store(m_pending.size(), std::memory_order_relaxed);
+
+    ScheduleDrain();
+}
+
+std::vector<ChatSourceStatus> ChatIngestionHub::GetSourceStatus() const {
+    std::vector<ChatSourceStatus> status;
+    status.reserve(m_clients.size());
+    for (const YouTubeChatClient* client : m_clients) {
+        status.push_back(ChatSourceStatus{client->GetVideoId(), client->IsRunning(),
+                                          client->GetPollIntervalMs(), client->GetStats()});
+    }
+    return status;
+}
+
+void ChatIngestionHub::PublishSourceMetrics() {
+    std::vector<ChatSourceStatus> status = GetSourceStatus();
+    for (size_t slot = 0; slot < PluginMetrics::MAX_SOURCE_SLOTS; slot++) {
+        if (slot >= status.size()) {
+            g_metrics.SetSourceId(slot, "");
+            continue;
+        }
+
+        const ChatSourceStatus& source = status[slot];
+        PluginMetrics::SourceMetrics& metrics = g_metrics.sources[slot];
+        g_metrics.SetSourceId(slot, source.videoId);
+        metrics.running.store(source.running ? 1 : 0, std::memory_order_relaxed);
+        metrics.pagesReceived.store(source.stats.pagesReceived, std::memory_order_relaxed);
+        metrics.messagesReceived.store(source.stats.messagesReceived, std::memory_order_relaxed);
+        metrics.eventsDispatched.store(source.stats.eventsDispatched, std::memory_order_relaxed);
+        metrics.duplicatesSuppressed.store(source.stats.duplicatesSuppressed, std::memory_order_relaxed);
+        metrics.requestFailures.store(source.stats.requestFailures, std::memory_order_relaxed);
+        metrics.pollIntervalMs.store(static_cast<uint64_t>(std::max(source.pollIntervalMs, 0)),
+                                     std::memory_order_relaxed);
+    }
+}
+
+bool ChatIngestionHub::StartReplay(const QString& path, double speed) {
+    if (!m_replayClient) {
+        m_replayClient = new YouTubeChatClient(m_networkManager, m_quota, this);
+        m_replayClient->SetDonationCallback([this](const DonationEvent& event) { Enqueue(event); });
+    }
+    return m_replayClient->StartReplay(path, speed);
+}
+
+void ChatIngestionHub::StopReplay() {
+    if (m_replayClient) {
+        m_replayClient->StopReplay();
+    }
+}
+
+bool ChatIngestionHub::IsReplaying() const {
+    return m_replayClient && m_replayClient->IsReplaying();
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "free-chat-sampler.hpp"
+#include "viewer-rate-limiter.hpp"
+#include "youtube-chat-client.hpp"
+#include <QObject>
+#include <QString>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+class QNetworkAccessManager;
+class QTimer;
+
+// Upper bound on concurrently monitored chats (collab streams rarely have more than a few)
+static const int MAX_CHAT_SOURCES = 10;
+
+struct ChatSourceStatus {
+    std::string videoId;
+    bool running;
+    int pollIntervalMs;
+    ChatSourceStats stats;
+};
+
+// Splits a "id1, id2 id3" settings string into video IDs, dropping duplicates and keeping order
+std::vector<std::string> ParseVideoIdList(const std::string& text);
+
+// Monitors several live chats at once and feeds their donations into one pipeline.
+// All clients share a QNetworkAccessManager and the quota/backoff state of the API key;
+// events are merged into a single stream ordered by publishedAt before dispatch.
+class ChatIngestionHub : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ChatIngestionHub(QObject* parent = nullptr);
+    ~ChatIngestionHub();
+
+    void SetApiKey(const std::string& apiKey);
+    void SetApiBaseUrl(const std::string& baseUrl);
+    // Clients for IDs already monitored keep their pagination state
+    void SetVideoIds(const std::vector<std::string>& videoIds);
+    void SetDonationCallback(DonationCallback callback) { m_donationCallback = std::move(callback); }
+    // Called while running whenever a chat's pageToken has moved since the last call (throttled),
+    // so cursors survive a crash and not only a clean stop
+    void SetCursorSaveCallback(std::function<void()> callback) { m_cursorSaveCallback = std::move(callback); }
+
+    void SetRecordingEnabled(bool enabled);
+    void SetSkipBacklog(bool skip);
+    void SetDailyQuota(int units);
+    void SetPlannedStreamHours(double hours);
+    // Events per minute per viewer (authorDetails.channelId); 0 = unlimited
+    void SetViewerRateLimits(int chatPerMinute, int paidPerMinute);
+    // Regular chat kept across all viewers under a flood; 0 = keep everything
+    void SetFreeChatSampleRate(int perSecond) { m_freeChatSampler.SetMaxPerSecond(perSecond); }
+
+    void Start();
+    void Stop();
+    bool IsRunning() const { return m_isRunning; }
+
+    // Queue an event from any source; dispatched in publishedAt order on the UI thread.
+    // Events over their viewer's rate limit, and regular chat not picked by the sampler,
+    // are dropped here; paid events are never sampled. Regular chat is sampled once control
+    // returns to the event loop, together with everything else enqueued in the same turn.
+    void Enqueue(const DonationEvent& event);
+    size_t GetPendingCount() const { return m_pending.size(); }
+
+    size_t GetSourceCount() const { return m_clients.size(); }
+    YouTubeChatClient* GetSource(size_t index) const { return m_clients[index]; }
+    std::vector<ChatSourceStatus> GetSourceStatus() const;
+    QuotaTracker* GetQuotaTracker() const { return m_quota.get(); }
+
+    // Session replay runs through a dedicated client so live pagination is untouched
+    bool StartReplay(const QString& path, double speed);
+    void StopReplay();
+    bool IsReplaying() const;
+
+private:
+    YouTubeChatClient* CreateClient(const std::string& videoId);
+    void Push(const DonationEvent& event);
+    void SampleFreeChat();
+    void ScheduleDrain();
+    void DrainQueue();
+    void OnCursorSaveTimer();
+    // Copies GetSourceStatus() into g_metrics.sources for the dock and the exporter
+    void PublishSourceMetrics();
+
+    struct PendingEvent {
+        DonationEvent event;
+        int64_t orderMs;    // publishedAt, or arrival time when unknown
+        uint64_t sequence;  // Keeps arrival order for equal timestamps
+    };
+    struct PendingLater {
+        bool operator()(const PendingEvent& a, const PendingEvent& b) const {
+            return a.orderMs != b.orderMs ? a.orderMs > b.orderMs : a.sequence > b.sequence;
+        }
+    };
+
+    QNetworkAccessManager* m_networkManager;
+    std::shared_ptr<QuotaTracker> m_quota;
+    std::vector<YouTubeChatClient*> m_clients;
+    YouTubeChatClient* m_replayClient;
+
+    std::string m_apiKey;
+    std::string m_apiBaseUrl;
+    bool m_recordingEnabled;
+    bool m_skipBacklog;
+    double m_plannedStreamHours;
+    bool m_isRunning;
+
+    ViewerRateLimiter m_viewerLimiter;
+    FreeChatSampler m_freeChatSampler;
+    // Regular chat enqueued in the current event-loop turn (one chat page, one injector read),
+    // sampled as a whole so every position in a page has the same chance
+    std::vector<DonationEvent> m_freeChatBatch;
+    std::vector<bool> m_freeChatKeep;
+    QTimer* m_freeChatTimer;    // Single-shot, zero delay
+    DonationCallback m_donationCallback;
+    std::priority_queue<PendingEvent, std::vector<PendingEvent>, PendingLater> m_pending;
+    uint64_t m_nextSequence;
+    QTimer* m_drainTimer;   // Single-shot; one timer however many chats are monitored
+
+    std::function<void()> m_cursorSaveCallback;
+    QTimer* m_cursorSaveTimer;
+    std::string m_savedPageTokens;  // All clients' pageTokens at the last save
+
+    QTimer* m_sourceMetricsTimer;
+};
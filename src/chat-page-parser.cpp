@@ -0,0 +1,248 @@
+#include "chat-page-parser.hpp"
+#include <util/platform.h>
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Where the parser currently is inside the response document
+enum class Frame {
+    Root,
+    Items,          // "items" array
+    Item,           // One element of "items"
+    Snippet,
+    SuperChat,      // snippet.superChatDetails
+    SuperSticker,   // snippet.superStickerDetails
+    TextMessage,    // snippet.textMessageDetails
+    Author,         // authorDetails
+    Skip            // Anything we do not read
+};
+
+class ChatPageHandler : public nlohmann::json_sax<json> {
+public:
+    explicit ChatPageHandler(ChatPage& page) : m_page(page) {}
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+
+    bool number_integer(number_integer_t value) override {
+        OnNumber(static_cast<int64_t>(value));
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        OnNumber(static_cast<int64_t>(value));
+        return true;
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        OnNumber(static_cast<int64_t>(value));
+        return true;
+    }
+
+    bool string(string_t& value) override {
+        switch (Current()) {
+            case Frame::Root:
+                if (m_key == "nextPageToken") m_page.nextPageToken = std::move(value);
+                break;
+            case Frame::Item:
+                if (m_key == "id") Message().id = std::move(value);
+                break;
+            case Frame::Snippet:
+                if (m_key == "type") Message().type = std::move(value);
+                else if (m_key == "displayMessage") Message().displayMessage = std::move(value);
+                else if (m_key == "publishedAt") Message().publishedAtMs = ParseRfc3339Millis(value);
+                break;
+            case Frame::SuperChat:
+            case Frame::SuperSticker:
+                // amountMicros is sent as a string
+                if (m_key == "amountMicros") Message().amountMicros = std::strtoll(value.c_str(), nullptr, 10);
+                else if (m_key == "currency") Message().currency = std::move(value);
+                else if (m_key == "userComment" && Current() == Frame::SuperChat) Message().messageText = std::move(value);
+                break;
+            case Frame::TextMessage:
+                if (m_key == "messageText") Message().messageText = std::move(value);
+                break;
+            case Frame::Author:
+                if (m_key == "displayName") Message().displayName = std::move(value);
+                else if (m_key == "channelId") Message().channelId = std::move(value);
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        Frame next = Frame::Skip;
+        if (m_stack.empty()) {
+            next = Frame::Root;
+        } else {
+            switch (Current()) {
+                case Frame::Items:
+                    next = Frame::Item;
+                    m_page.messages.emplace_back();
+                    break;
+                case Frame::Item:
+                    if (m_key == "snippet") next = Frame::Snippet;
+                    else if (m_key == "authorDetails") next = Frame::Author;
+                    break;
+                case Frame::Snippet:
+                    if (m_key == "superChatDetails") {
+                        next = Frame::SuperChat;
+                        Message().kind = ChatPageMessage::Kind::SuperChat;
+                    } else if (m_key == "superStickerDetails") {
+                        next = Frame::SuperSticker;
+                        Message().kind = ChatPageMessage::Kind::SuperSticker;
+                    } else if (m_key == "textMessageDetails") {
+                        next = Frame::TextMessage;
+                        if (Message().kind == ChatPageMessage::Kind::Other) {
+                            Message().kind = ChatPageMessage::Kind::TextMessage;
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        m_stack.push_back(next);
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        m_key = std::move(value);
+        return true;
+    }
+
+    bool end_object() override {
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        m_stack.push_back(Current() == Frame::Root && m_key == "items" ? Frame::Items : Frame::Skip);
+        return true;
+    }
+
+    bool end_array() override {
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        m_page.error = ex.what();
+        return false;
+    }
+
+private:
+    Frame Current() const { return m_stack.empty() ? Frame::Skip : m_stack.back(); }
+    ChatPageMessage& Message() { return m_page.messages.back(); }
+
+    void OnNumber(int64_t value) {
+        if (Current() == Frame::Root && m_key == "pollingIntervalMillis") {
+            m_page.pollingIntervalMillis = static_cast<int>(value);
+        } else if ((Current() == Frame::SuperChat || Current() == Frame::SuperSticker) && m_key == "amountMicros") {
+            Message().amountMicros = value;
+        }
+    }
+
+    ChatPage& m_page;
+    std::vector<Frame> m_stack;
+    std::string m_key;
+};
+
+}
+
+static bool ReadDigits(const std::string& text, size_t& pos, int count, int& value) {
+    if (pos + count > text.size()) return false;
+    value = 0;
+    for (int i = 0; i < count; ++i) {
+        char c = text[pos + i];
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    pos += count;
+    return true;
+}
+
+static bool Expect(const std::string& text, size_t& pos, char c) {
+    if (pos >= text.size() || (text[pos] != c && !(c == 'T' && (text[pos] == 't' || text[pos] == ' ')))) return false;
+    ++pos;
+    return true;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+static int64_t DaysFromCivil(int64_t y, int m, int d) {
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+int64_t ParseRfc3339Millis(const std::string& text) {
+    size_t pos = 0;
+    int year, month, day, hour, minute, second;
+    if (!ReadDigits(text, pos, 4, year) || !Expect(text, pos, '-') ||
+        !ReadDigits(text, pos, 2, month) || !Expect(text, pos, '-') ||
+        !ReadDigits(text, pos, 2, day) || !Expect(text, pos, 'T') ||
+        !ReadDigits(text, pos, 2, hour) || !Expect(text, pos, ':') ||
+        !ReadDigits(text, pos, 2, minute) || !Expect(text, pos, ':') ||
+        !ReadDigits(text, pos, 2, second)) {
+        return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31) return 0;
+
+    // Fractional seconds: keep milliseconds, ignore finer digits
+    int millis = 0;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        int digits = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            if (digits < 3) millis = millis * 10 + (text[pos] - '0');
+            ++digits;
+            ++pos;
+        }
+        if (digits == 0) return 0;
+        for (; digits < 3; ++digits) millis *= 10;
+    }
+
+    int offsetMinutes = 0;
+    if (pos < text.size() && (text[pos] == 'Z' || text[pos] == 'z')) {
+        ++pos;
+    } else if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+        int sign = text[pos] == '-' ? -1 : 1;
+        ++pos;
+        int offsetHours, offsetMins;
+        if (!ReadDigits(text, pos, 2, offsetHours) || !Expect(text, pos, ':') ||
+            !ReadDigits(text, pos, 2, offsetMins)) {
+            return 0;
+        }
+        offsetMinutes = sign * (offsetHours * 60 + offsetMins);
+    } else {
+        return 0;
+    }
+
+    int64_t seconds = DaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    seconds -= static_cast<int64_t>(offsetMinutes) * 60;
+    return seconds * 1000 + millis;
+}
+
+ChatPage ParseChatPage(const char* data, size_t size) {
+    ChatPage page;
+    page.bytes = size;
+
+    uint64_t start = os_gettime_ns();
+
+    ChatPageHandler handler(page);
+    page.valid = json::sax_parse(data, data + size, &handler);
+
+    page.parsedNs = os_gettime_ns();
+    page.parseTimeNs = page.parsedNs - start;
+    return page;
+}
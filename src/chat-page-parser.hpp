@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fields of a liveChatMessages item that DonationEvent is built from
+struct ChatPageMessage {
+    enum class Kind {
+        Other,
+        TextMessage,
+        SuperChat,
+        SuperSticker
+    };
+
+    Kind kind = Kind::Other;
+    std::string id;             // items[].id
+    std::string type;           // snippet.type
+    std::string displayName;    // authorDetails.displayName
+    std::string channelId;      // authorDetails.channelId
+    std::string displayMessage; // snippet.displayMessage
+    std::string messageText;    // textMessageDetails.messageText / superChatDetails.userComment
+    std::string currency;
+    int64_t amountMicros = 0;
+    int64_t publishedAtMs = 0;  // snippet.publishedAt as Unix milliseconds, 0 = unknown
+};
+
+// Result of parsing one liveChat/messages response page
+struct ChatPage {
+    std::vector<ChatPageMessage> messages;
+    std::string nextPageToken;
+    int pollingIntervalMillis = -1;  // -1 = not present
+    size_t bytes = 0;
+    uint64_t parseTimeNs = 0;
+    uint64_t receivedNs = 0;        // Set by the caller: when the response arrived (os_gettime_ns)
+    uint64_t parsedNs = 0;          // When parsing finished
+    bool valid = false;
+    std::string error;
+};
+
+// Parses an RFC 3339 timestamp ("2024-05-01T12:34:56.789Z", "+09:00" offsets allowed)
+// to Unix milliseconds; returns 0 if the string is malformed
+int64_t ParseRfc3339Millis(const std::string& text);
+
+// Streams the response through a SAX parser and keeps only the fields above.
+// Safe to call from any thread.
+ChatPage ParseChatPage(const char* data, size_t size);
@@ -0,0 +1,206 @@
+#include "chat-session-log.hpp"
+#include <obs-module.h>
+#include <util/platform.h>
+#include <QtEndian>
+#include <QTimer>
+#include <algorithm>
+#include <cstring>
+
+static const char CHAT_LOG_MAGIC[4] = {'Y', 'T', 'C', 'L'};
+static const uint32_t CHAT_LOG_VERSION = 1;
+static const qint64 CHAT_LOG_HEADER_SIZE = 8;
+static const qint64 CHAT_LOG_RECORD_HEADER_SIZE = 12;
+
+// Pages handed out per event loop turn when replaying as fast as possible,
+// so effect timers still get to run in between
+static const int REPLAY_MAX_BATCH = 16;
+
+ChatSessionRecorder::ChatSessionRecorder()
+    : m_startNs(0)
+    , m_recordCount(0)
+{
+}
+
+ChatSessionRecorder::~ChatSessionRecorder() {
+    Close();
+}
+
+bool ChatSessionRecorder::Open(const QString& path) {
+    Close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        blog(LOG_ERROR, "[Session Log] Failed to open %s for writing: %s",
+             path.toUtf8().constData(), m_file.errorString().toUtf8().constData());
+        return false;
+    }
+
+    uchar version[4];
+    qToLittleEndian<quint32>(CHAT_LOG_VERSION, version);
+    m_file.write(CHAT_LOG_MAGIC, sizeof(CHAT_LOG_MAGIC));
+    m_file.write(reinterpret_cast<const char*>(version), sizeof(version));
+
+    m_startNs = 0;
+    m_recordCount = 0;
+
+    blog(LOG_INFO, "[Session Log] Recording chat session to %s", path.toUtf8().constData());
+    return true;
+}
+
+void ChatSessionRecorder::Append(const QByteArray& page) {
+    if (!m_file.isOpen()) return;
+
+    uint64_t now = os_gettime_ns();
+    if (m_recordCount == 0) {
+        m_startNs = now;
+    }
+
+    uchar header[CHAT_LOG_RECORD_HEADER_SIZE];
+    qToLittleEndian<quint64>(now - m_startNs, header);
+    qToLittleEndian<quint32>(static_cast<quint32>(page.size()), header + 8);
+
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    m_file.write(page);
+    ++m_recordCount;
+}
+
+void ChatSessionRecorder::Close() {
+    if (!m_file.isOpen()) return;
+
+    m_file.close();
+    blog(LOG_INFO, "[Session Log] Recorded %llu pages to %s",
+         static_cast<unsigned long long>(m_recordCount), m_file.fileName().toUtf8().constData());
+}
+
+ChatSessionReplayer::ChatSessionReplayer(QObject* parent)
+    : QObject(parent)
+    , m_map(nullptr)
+    , m_mapSize(0)
+    , m_offset(0)
+    , m_speed(1.0)
+    , m_running(false)
+    , m_replayStartNs(0)
+    , m_pagesReplayed(0)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ChatSessionReplayer::OnTimer);
+}
+
+ChatSessionReplayer::~ChatSessionReplayer() {
+    Stop();
+}
+
+bool ChatSessionReplayer::Open(const QString& path) {
+    Stop();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        blog(LOG_ERROR, "[Session Log] Failed to open %s: %s",
+             path.toUtf8().constData(), m_file.errorString().toUtf8().constData());
+        return false;
+    }
+
+    m_mapSize = m_file.size();
+    m_map = m_mapSize > 0 ? m_file.map(0, m_mapSize) : nullptr;
+    if (!m_map || m_mapSize < CHAT_LOG_HEADER_SIZE ||
+        std::memcmp(m_map, CHAT_LOG_MAGIC, sizeof(CHAT_LOG_MAGIC)) != 0 ||
+        qFromLittleEndian<quint32>(m_map + 4) != CHAT_LOG_VERSION) {
+        blog(LOG_ERROR, "[Session Log] %s is not a chat session log", path.toUtf8().constData());
+        Stop();
+        return false;
+    }
+
+    m_offset = CHAT_LOG_HEADER_SIZE;
+    return true;
+}
+
+void ChatSessionReplayer::Start(double speed, PageCallback callback) {
+    if (!m_map) return;
+
+    m_speed = speed;
+    m_callback = std::move(callback);
+    m_offset = CHAT_LOG_HEADER_SIZE;
+    m_pagesReplayed = 0;
+    m_replayStartNs = os_gettime_ns();
+    m_running = true;
+
+    blog(LOG_INFO, "[Session Log] Replaying %s at %s", m_file.fileName().toUtf8().constData(),
+         speed > 0.0 ? QString("%1x").arg(speed).toUtf8().constData() : "maximum speed");
+
+    ScheduleNext();
+}
+
+void ChatSessionReplayer::Stop() {
+    m_timer->stop();
+    m_running = false;
+    m_callback = nullptr;
+
+    if (m_map) {
+        m_file.unmap(const_cast<uchar*>(m_map));
+        m_map = nullptr;
+    }
+    m_mapSize = 0;
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool ChatSessionReplayer::ReadRecord(Record& record) {
+    if (m_offset + CHAT_LOG_RECORD_HEADER_SIZE > m_mapSize) return false;
+
+    const uchar* header = m_map + m_offset;
+    record.arrivalNs = qFromLittleEndian<quint64>(header);
+    record.size = qFromLittleEndian<quint32>(header + 8);
+
+    // A truncated final record (recording interrupted) ends the replay
+    if (m_offset + CHAT_LOG_RECORD_HEADER_SIZE + record.size > m_mapSize) return false;
+
+    record.data = reinterpret_cast<const char*>(header + CHAT_LOG_RECORD_HEADER_SIZE);
+    return true;
+}
+
+void ChatSessionReplayer::ScheduleNext() {
+    Record record;
+    if (!ReadRecord(record)) {
+        double seconds = (os_gettime_ns() - m_replayStartNs) / 1000000000.0;
+        quint64 pages = m_pagesReplayed;
+        blog(LOG_INFO, "[Session Log] Replay finished: %llu pages in %.2f s",
+             static_cast<unsigned long long>(pages), seconds);
+        Stop();
+        emit Finished(pages, seconds);
+        return;
+    }
+
+    if (m_speed <= 0.0) {
+        m_timer->start(0);
+        return;
+    }
+
+    // Deadlines are relative to the replay start, so timer jitter does not accumulate
+    uint64_t due = m_replayStartNs + static_cast<uint64_t>(record.arrivalNs / m_speed);
+    uint64_t now = os_gettime_ns();
+    int delayMs = due > now ? static_cast<int>((due - now) / 1000000) : 0;
+    m_timer->start(delayMs);
+}
+
+void ChatSessionReplayer::OnTimer() {
+    int batch = m_speed <= 0.0 ? REPLAY_MAX_BATCH : 1;
+
+    for (int i = 0; i < batch && m_running; ++i) {
+        Record record;
+        if (!ReadRecord(record)) break;
+
+        m_offset += CHAT_LOG_RECORD_HEADER_SIZE + record.size;
+        ++m_pagesReplayed;
+
+        if (m_callback) {
+            m_callback(record.data, record.size);
+        }
+    }
+
+    if (m_running) {
+        ScheduleNext();
+    }
+}
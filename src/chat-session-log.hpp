@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QObject>
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class QTimer;
+
+// Binary log of raw liveChat/messages response pages.
+//
+// Layout (all integers little-endian):
+//   header:  "YTCL" magic, uint32 version
+//   record:  uint64 arrival time (ns since the first record), uint32 size, <size> bytes of JSON
+class ChatSessionRecorder {
+public:
+    ChatSessionRecorder();
+    ~ChatSessionRecorder();
+
+    bool Open(const QString& path);
+    void Append(const QByteArray& page);
+    void Close();
+    bool IsOpen() const { return m_file.isOpen(); }
+    QString GetPath() const { return m_file.fileName(); }
+
+private:
+    QFile m_file;
+    uint64_t m_startNs;
+    uint64_t m_recordCount;
+};
+
+// Feeds a recorded log back page by page. The file is memory-mapped, so multi-hour
+// logs are not loaded into memory; records are handed out as pointers into the mapping.
+class ChatSessionReplayer : public QObject {
+    Q_OBJECT
+
+public:
+    using PageCallback = std::function<void(const char* data, size_t size)>;
+
+    explicit ChatSessionReplayer(QObject* parent = nullptr);
+    ~ChatSessionReplayer();
+
+    bool Open(const QString& path);
+
+    // speed: 1.0 = recorded timing, N = N times faster, <= 0 = as fast as possible
+    void Start(double speed, PageCallback callback);
+    void Stop();
+    bool IsRunning() const { return m_running; }
+
+signals:
+    void Finished(quint64 pages, double seconds);
+
+private:
+    struct Record {
+        uint64_t arrivalNs;
+        const char* data;
+        uint32_t size;
+    };
+
+    bool ReadRecord(Record& record);
+    void ScheduleNext();
+    void OnTimer();
+
+    QFile m_file;
+    const uchar* m_map;
+    qint64 m_mapSize;
+    qint64 m_offset;
+    double m_speed;
+    bool m_running;
+    uint64_t m_replayStartNs;
+    quint64 m_pagesReplayed;
+    PageCallback m_callback;
+    QTimer* m_timer;
+};
@@ -0,0 +1,125 @@
+#include "currency-table.hpp"
+#include <obs-module.h>
+#include <util/base.h>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <cstdlib>
+#include <limits>
+
+CurrencyTable& CurrencyTable::Instance() {
+    static CurrencyTable instance;
+    return instance;
+}
+
+CurrencyTable::CurrencyTable() {
+    // Until a rate file is loaded only yen amounts convert
+    auto table = std::make_shared<RateTable>();
+    table->microYenPerUnit[CodeIndex("JPY")] = Money::MICROS_PER_UNIT;
+    table->count = 1;
+    m_table = std::move(table);
+}
+
+int CurrencyTable::CodeIndex(std::string_view code) {
+    if (code.size() != 3) return -1;
+
+    int index = 0;
+    for (char c : code) {
+        char upper = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        if (upper < 'A' || upper > 'Z') return -1;
+        index = index * 26 + (upper - 'A');
+    }
+    return index;
+}
+
+bool CurrencyTable::LoadFromFile(const std::string& path) {
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::ReadOnly)) {
+        blog(LOG_WARNING, "[Currency] Cannot read %s", path.c_str());
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (!doc.isObject()) {
+        blog(LOG_WARNING, "[Currency] Invalid rate file %s: %s", path.c_str(), error.errorString().toStdString().c_str());
+        return false;
+    }
+
+    auto table = std::make_shared<RateTable>();
+    const QJsonObject rates = doc.object()["rates"].toObject();
+    for (auto it = rates.begin(); it != rates.end(); ++it) {
+        int index = CodeIndex(it.key().toStdString());
+        double yenPerUnit = it.value().toDouble();
+        if (index < 0 || !(yenPerUnit > 0.0)) {
+            blog(LOG_WARNING, "[Currency] Ignoring rate %s in %s", it.key().toStdString().c_str(), path.c_str());
+            continue;
+        }
+        if (table->microYenPerUnit[index] == 0) {
+            table->count++;
+        }
+        table->microYenPerUnit[index] = Money::FromUnits(yenPerUnit).Micros();
+    }
+
+    // Yen amounts always convert exactly, whatever the file says
+    int yen = CodeIndex("JPY");
+    if (table->microYenPerUnit[yen] == 0) {
+        table->count++;
+    }
+    table->microYenPerUnit[yen] = Money::MICROS_PER_UNIT;
+
+    std::atomic_store(&m_table, std::shared_ptr<const RateTable>(std::move(table)));
+    blog(LOG_INFO, "[Currency] Loaded %zu rates from %s", GetRateCount(), path.c_str());
+    return true;
+}
+
+bool CurrencyTable::Reload() {
+    char* overridePath = obs_module_config_path(CURRENCY_RATES_FILE);
+    if (overridePath) {
+        std::string path = overridePath;
+        bfree(overridePath);
+        if (QFileInfo::exists(QString::fromStdString(path))) {
+            return LoadFromFile(path);
+        }
+    }
+
+    char* bundledPath = obs_module_file(CURRENCY_RATES_FILE);
+    if (!bundledPath) {
+        blog(LOG_WARNING, "[Currency] %s not found; only JPY amounts can be converted", CURRENCY_RATES_FILE);
+        return false;
+    }
+    std::string path = bundledPath;
+    bfree(bundledPath);
+    return LoadFromFile(path);
+}
+
+bool CurrencyTable::ToJpy(Money amount, std::string_view currency, Money* jpy) const {
+    int index = CodeIndex(currency);
+    if (index < 0) return false;
+
+    std::shared_ptr<const RateTable> table = Snapshot();
+    int64_t rate = table->microYenPerUnit[index];
+    if (rate == 0) return false;
+
+    // micros * rate / 1e6 without overflowing the intermediate product: whole units and
+    // the sub-unit remainder are scaled separately, the remainder rounded to nearest
+    int64_t micros = amount.Micros();
+    int64_t units = micros / Money::MICROS_PER_UNIT;
+    int64_t remainder = micros % Money::MICROS_PER_UNIT;
+    if (units != 0 && std::abs(units) > std::numeric_limits<int64_t>::max() / rate) return false;
+
+    int64_t result = units * rate + (remainder * rate + (remainder >= 0 ? 1 : -1) * Money::MICROS_PER_UNIT / 2)
+                                    / Money::MICROS_PER_UNIT;
+    *jpy = Money::FromMicros(result);
+    return true;
+}
+
+bool CurrencyTable::HasRate(std::string_view currency) const {
+    int index = CodeIndex(currency);
+    return index >= 0 && Snapshot()->microYenPerUnit[index] != 0;
+}
+
+size_t CurrencyTable::GetRateCount() const {
+    return Snapshot()->count;
+}
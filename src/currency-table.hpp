@@ -0,0 +1,53 @@
+#pragma once
+
+#include "money.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// File name of the rate table, looked up in the module config folder first (user
+// override) and then in the plugin's data folder (bundled copy)
+#define CURRENCY_RATES_FILE "currency-rates.json"
+
+// ISO 4217 code -> JPY conversion.
+//
+// Rates are fixed-point micro-yen per unit, stored in a flat array indexed by the
+// three-letter code read as a base-26 number ("AAA" = 0 ... "ZZZ" = 17575), which is a
+// perfect hash: every valid code has its own slot and a lookup is one index.
+// The table is immutable once published; Reload() builds a new one and swaps the
+// pointer atomically, so a conversion running on another thread keeps the old rates.
+class CurrencyTable {
+public:
+    static constexpr size_t CODE_SPACE = 26 * 26 * 26;
+
+    static CurrencyTable& Instance();
+
+    // Reads {"rates": {"USD": 150.0, ...}} (JPY per unit); keeps the current table on failure
+    bool LoadFromFile(const std::string& path);
+
+    // Config-folder override if present, else the bundled file
+    bool Reload();
+
+    // False for codes without a rate; never guesses
+    bool ToJpy(Money amount, std::string_view currency, Money* jpy) const;
+    bool HasRate(std::string_view currency) const;
+    size_t GetRateCount() const;
+
+    // Base-26 index of an ISO 4217 code (case-insensitive); -1 if not three letters
+    static int CodeIndex(std::string_view code);
+
+private:
+    struct RateTable {
+        std::array<int64_t, CODE_SPACE> microYenPerUnit{};  // 0 = no rate
+        size_t count = 0;
+    };
+
+    CurrencyTable();
+
+    std::shared_ptr<const RateTable> Snapshot() const { return std::atomic_load(&m_table); }
+
+    std::shared_ptr<const RateTable> m_table;   // Replaced with std::atomic_store
+};
@@ -0,0 +1,276 @@
+#include "donation-injector.hpp"
+#include "currency-table.hpp"
+#include "plugin-metrics.hpp"
+#include <obs-module.h>
+#include <util/base.h>
+#include <util/platform.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+// Anything larger is treated as a broken or hostile client
+static const int MAX_JSON_LINE_BYTES = 64 * 1024;
+static const uint32_t MAX_BINARY_FRAME_BYTES = 1024 * 1024;
+static const int BINARY_HEADER_BYTES = 5;
+// A client sending this many unparsable JSON lines in a row is not speaking the protocol
+static const int MAX_CONSECUTIVE_MALFORMED_LINES = 10;
+
+DonationInjector::DonationInjector(QObject* parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+    , m_port(DEFAULT_INJECTION_PORT)
+    , m_rateLimit(DEFAULT_INJECTION_RATE)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &DonationInjector::OnNewConnection);
+}
+
+DonationInjector::~DonationInjector() {
+    Stop();
+}
+
+void DonationInjector::SetRateLimit(int eventsPerSecond) {
+    m_rateLimit = std::max(1, eventsPerSecond);
+}
+
+bool DonationInjector::Start(quint16 port) {
+    if (m_server->isListening()) {
+        if (port == m_port) return true;
+        Stop();
+    }
+
+    m_port = port;
+
+    // Never reachable from other machines
+    if (!m_server->listen(QHostAddress::LocalHost, m_port)) {
+        blog(LOG_ERROR, "[Injector] Failed to listen on 127.0.0.1:%d: %s",
+             m_port, m_server->errorString().toStdString().c_str());
+        return false;
+    }
+
+    blog(LOG_INFO, "[Injector] Listening on 127.0.0.1:%d (%d events/s per connection)", m_port, m_rateLimit);
+    return true;
+}
+
+void DonationInjector::Stop() {
+    if (m_server->isListening()) {
+        m_server->close();
+        blog(LOG_INFO, "[Injector] Stopped");
+    }
+
+    const QList<QTcpSocket*> sockets = m_connections.keys();
+    m_connections.clear();
+    for (QTcpSocket* socket : sockets) {
+        socket->disconnect(this);
+        socket->disconnectFromHost();
+        socket->deleteLater();
+    }
+}
+
+bool DonationInjector::IsRunning() const {
+    return m_server->isListening();
+}
+
+void DonationInjector::OnNewConnection() {
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        blog(LOG_INFO, "[Injector] New connection from port %d", socket->peerPort());
+
+        connect(socket, &QTcpSocket::readyRead, this, &DonationInjector::OnReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, &DonationInjector::OnDisconnected);
+
+        Connection connection;
+        connection.tokens = m_rateLimit;    // Full bucket: allow an initial burst of one second
+        connection.lastRefillNs = static_cast<int64_t>(os_gettime_ns());
+        m_connections.insert(socket, connection);
+    }
+}
+
+void DonationInjector::OnReadyRead() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) return;
+
+    it->lastReadNs = os_gettime_ns();
+    it->buffer.append(socket->readAll());
+    if (!ProcessBuffer(*it)) {
+        blog(LOG_WARNING, "[Injector] Malformed data from port %d, closing connection", socket->peerPort());
+        socket->abort();
+    }
+}
+
+void DonationInjector::OnDisconnected() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    auto it = m_connections.find(socket);
+    if (it != m_connections.end()) {
+        blog(LOG_INFO, "[Injector] Client disconnected: %llu events accepted, %llu dropped by rate limit, "
+             "%llu malformed lines",
+             static_cast<unsigned long long>(it->accepted), static_cast<unsigned long long>(it->dropped),
+             static_cast<unsigned long long>(it->malformed));
+        m_connections.erase(it);
+    }
+    socket->deleteLater();
+}
+
+bool DonationInjector::ProcessBuffer(Connection& connection) {
+    const QByteArray& buffer = connection.buffer;
+    int pos = 0;
+
+    while (pos < buffer.size()) {
+        if (buffer[pos] == INJECTION_BINARY_FRAME) {
+            if (buffer.size() - pos < BINARY_HEADER_BYTES) break;
+
+            uint32_t payloadSize = qFromLittleEndian<quint32>(buffer.constData() + pos + 1);
+            if (payloadSize > MAX_BINARY_FRAME_BYTES) return false;
+            if (static_cast<uint32_t>(buffer.size() - pos - BINARY_HEADER_BYTES) < payloadSize) break;
+
+            if (!ParseBinaryFrame(connection, buffer.constData() + pos + BINARY_HEADER_BYTES, payloadSize)) {
+                return false;
+            }
+            pos += BINARY_HEADER_BYTES + static_cast<int>(payloadSize);
+        } else {
+            int newline = buffer.indexOf('\n', pos);
+            if (newline < 0) {
+                if (buffer.size() - pos > MAX_JSON_LINE_BYTES) return false;
+                break;
+            }
+
+            QByteArray line = buffer.mid(pos, newline - pos).trimmed();
+            pos = newline + 1;
+            if (line.isEmpty()) continue;
+
+            if (ParseJsonLine(connection, line)) {
+                connection.malformedInRow = 0;
+            } else {
+                connection.malformed++;
+                g_metrics.injectedLinesMalformed.fetch_add(1, std::memory_order_relaxed);
+                if (++connection.malformedInRow >= MAX_CONSECUTIVE_MALFORMED_LINES) return false;
+            }
+        }
+    }
+
+    connection.buffer.remove(0, pos);
+    return true;
+}
+
+// Injected amounts are in event.currency, like the API's; false (and logged) without a rate
+static bool ConvertToJpy(DonationEvent& event) {
+    if (event.type == DonationType::ChatMessage && !event.originalAmount.IsPositive()) {
+        // Regular chat carries no amount of its own
+        event.originalAmount = CHAT_MESSAGE_AMOUNT;
+        event.currency = "JPY";
+    }
+    if (!event.originalAmount.IsPositive()) return false;
+    if (CurrencyTable::Instance().ToJpy(event.originalAmount, event.currency, &event.amount)) return true;
+
+    g_metrics.unknownCurrencyDonations.fetch_add(1, std::memory_order_relaxed);
+    blog(LOG_WARNING, "[Injector] No JPY rate for currency '%s'; event ignored", event.currency.c_str());
+    return false;
+}
+
+static bool ReadEventObject(const QJsonObject& obj, DonationEvent& event) {
+    QString type = obj["type"].toString().toLower();
+    if (type == "supersticker" || type == "sticker") {
+        event.type = DonationType::SuperSticker;
+    } else if (type == "chat" || type == "text") {
+        event.type = DonationType::ChatMessage;
+    } else {
+        event.type = DonationType::SuperChat;
+    }
+    event.originalAmount = Money::FromUnits(obj["amount"].toDouble());
+    event.currency = obj["currency"].toString("JPY").toStdString();
+    event.displayName = obj["name"].toString().toStdString();
+    event.authorChannelId = obj["channelId"].toString().toStdString();
+    // "text" is what CommentViewer3D's TCPReceiver expects
+    event.message = (obj.contains("message") ? obj["message"] : obj["text"]).toString().toStdString();
+    return ConvertToJpy(event);
+}
+
+bool DonationInjector::ParseJsonLine(Connection& connection, const QByteArray& line) {
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(line, &error);
+    if (doc.isNull()) {
+        blog(LOG_WARNING, "[Injector] Invalid JSON: %s", error.errorString().toStdString().c_str());
+        return false;
+    }
+
+    QJsonArray items = doc.isArray() ? doc.array() : QJsonArray{doc.object()};
+    for (const QJsonValue& item : items) {
+        DonationEvent event;
+        if (ReadEventObject(item.toObject(), event)) {
+            Admit(connection, event);
+        }
+    }
+    return true;
+}
+
+bool DonationInjector::ParseBinaryFrame(Connection& connection, const char* data, size_t size) {
+    size_t pos = 0;
+
+    auto readString = [&](size_t length, std::string& out) {
+        if (size - pos < length) return false;
+        out.assign(data + pos, length);
+        pos += length;
+        return true;
+    };
+
+    while (pos < size) {
+        // type + amount + currency length
+        if (size - pos < 10) return false;
+
+        DonationEvent event;
+        uint8_t type = static_cast<uint8_t>(data[pos]);
+        event.type = type == 1 ? DonationType::SuperSticker : type == 2 ? DonationType::ChatMessage : DonationType::SuperChat;
+        event.originalAmount = Money::FromMicros(qFromLittleEndian<qint64>(data + pos + 1));
+        size_t currencyLength = static_cast<uint8_t>(data[pos + 9]);
+        pos += 10;
+
+        if (!readString(currencyLength, event.currency)) return false;
+        if (size - pos < 2) return false;
+        size_t nameLength = qFromLittleEndian<quint16>(data + pos);
+        pos += 2;
+        if (!readString(nameLength, event.displayName)) return false;
+        if (size - pos < 2) return false;
+        size_t messageLength = qFromLittleEndian<quint16>(data + pos);
+        pos += 2;
+        if (!readString(messageLength, event.message)) return false;
+
+        if (event.currency.empty()) {
+            event.currency = "JPY";
+        }
+        if (ConvertToJpy(event)) {
+            Admit(connection, event);
+        }
+    }
+    return true;
+}
+
+void DonationInjector::Admit(Connection& connection, DonationEvent& event) {
+    int64_t now = static_cast<int64_t>(os_gettime_ns());
+    double elapsed = (now - connection.lastRefillNs) / 1000000000.0;
+    connection.tokens = std::min<double>(m_rateLimit, connection.tokens + elapsed * m_rateLimit);
+    connection.lastRefillNs = now;
+
+    if (connection.tokens < 1.0) {
+        connection.dropped++;
+        g_metrics.injectedEventsDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    connection.tokens -= 1.0;
+    connection.accepted++;
+    g_metrics.injectedEvents.fetch_add(1, std::memory_order_relaxed);
+
+    event.sourceId = "inject";
+    event.timestamps.receivedNs = connection.lastReadNs;
+    event.timestamps.parsedNs = static_cast<uint64_t>(now);
+    if (m_sink) {
+        m_sink(event);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "youtube-chat-client.hpp"
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <cstdint>
+
+class QTcpServer;
+class QTcpSocket;
+
+#define DEFAULT_INJECTION_PORT 45679
+#define DEFAULT_INJECTION_RATE 1000     // Events per second per connection
+
+// Binary frames start with this byte; anything else is read as a line of JSON
+static const char INJECTION_BINARY_FRAME = 0x01;
+
+// Localhost endpoint that feeds test donations into the same queue as the chat clients.
+// Uses the line framing of CommentViewer3D's TCPReceiver, plus a binary frame for batches:
+//
+//   JSON:   {"type":"superchat","amount":1000,"currency":"JPY","name":"...","message":"..."}\n
+//           (one object, or an array of objects, per line)
+//   Binary: 0x01 | u32 payload size | records...
+//           record = u8 type (0 = SuperChat, 1 = SuperSticker, 2 = ChatMessage; others read as 0)
+//                  | i64 amount in micros of the currency | u8 currency length | currency
+//                  | u16 name length | name | u16 message length | message
+//           (integers little-endian, strings UTF-8; an empty currency is JPY, and a
+//           ChatMessage with amount 0 counts as CHAT_MESSAGE_AMOUNT)
+//
+// Each connection has its own token bucket; events over the rate are dropped and counted.
+class DonationInjector : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DonationInjector(QObject* parent = nullptr);
+    ~DonationInjector();
+
+    void SetEventSink(DonationCallback sink) { m_sink = std::move(sink); }
+    void SetRateLimit(int eventsPerSecond);
+
+    bool Start(quint16 port);
+    void Stop();
+    bool IsRunning() const;
+    quint16 GetPort() const { return m_port; }
+
+private slots:
+    void OnNewConnection();
+    void OnReadyRead();
+    void OnDisconnected();
+
+private:
+    struct Connection {
+        QByteArray buffer;
+        double tokens = 0.0;
+        int64_t lastRefillNs = 0;
+        uint64_t accepted = 0;
+        uint64_t dropped = 0;
+        uint64_t malformed = 0;     // JSON lines that did not parse
+        int malformedInRow = 0;
+        uint64_t lastReadNs = 0;    // When the data being processed arrived
+    };
+
+    // Returns false when the stream is malformed and the connection should be closed
+    bool ProcessBuffer(Connection& connection);
+    // False for a line that is not JSON; counted, and enough of them in a row close the connection
+    bool ParseJsonLine(Connection& connection, const QByteArray& line);
+    bool ParseBinaryFrame(Connection& connection, const char* data, size_t size);
+    void Admit(Connection& connection, DonationEvent& event);
+
+    QTcpServer* m_server;
+    QHash<QTcpSocket*, Connection> m_connections;
+    DonationCallback m_sink;
+    quint16 m_port;
+    int m_rateLimit;
+};
@@ -0,0 +1,198 @@
+#include "donation-tracer.hpp"
+#include <obs-module.h>
+#include <util/base.h>
+#include <util/platform.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cstdio>
+
+static const size_t STAGE_COUNT = static_cast<size_t>(TraceStage::Count);
+
+const char* TraceStageName(TraceStage stage) {
+    switch (stage) {
+    case TraceStage::Network:       return "Network";
+    case TraceStage::Parse:         return "Parse";
+    case TraceStage::Queue:         return "Queue";
+    case TraceStage::ConfigResolve: return "Config resolve";
+    case TraceStage::EffectStart:   return "Effect start";
+    case TraceStage::FirstFrame:    return "First frame";
+    case TraceStage::Total:         return "Total";
+    default:                        return "?";
+    }
+}
+
+// Stage boundaries in pipeline order; stage i runs from point i to point i + 1
+static std::array<uint64_t, 7> StagePoints(const DonationTimestamps& timestamps) {
+    return {timestamps.publishedNs, timestamps.receivedNs, timestamps.parsedNs, timestamps.dispatchedNs,
+            timestamps.configResolvedNs, timestamps.effectStartedNs, timestamps.firstFrameNs};
+}
+
+DonationTracer::DonationTracer() {
+    m_completed.reserve(MAX_TRACES);
+    obs_add_tick_callback(&DonationTracer::OnVideoTick, this);
+}
+
+DonationTracer::~DonationTracer() {
+    obs_remove_tick_callback(&DonationTracer::OnVideoTick, this);
+}
+
+void DonationTracer::Submit(const DonationEvent& event, const DonationTimestamps& timestamps) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.push_back(Trace{m_nextId++, event.type, event.amount, event.displayName, event.sourceId, timestamps});
+    m_hasPending.store(true, std::memory_order_release);
+}
+
+void DonationTracer::OnVideoTick(void* param, float seconds) {
+    (void)seconds;
+    DonationTracer* tracer = static_cast<DonationTracer*>(param);
+    if (!tracer->m_hasPending.load(std::memory_order_acquire)) return;
+
+    // The tick runs right before the frame is rendered, so this frame is the first to show the effect
+    tracer->CompletePending(os_gettime_ns());
+}
+
+void DonationTracer::CompletePending(uint64_t frameNs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Trace& trace : m_pending) {
+        trace.timestamps.firstFrameNs = std::max(frameNs, trace.timestamps.effectStartedNs);
+        RecordStages(trace.timestamps);
+
+        if (m_completed.size() < MAX_TRACES) {
+            m_completed.push_back(std::move(trace));
+        } else {
+            m_completed[m_completedHead] = std::move(trace);
+        }
+        m_completedHead = (m_completedHead + 1) % MAX_TRACES;
+        m_completedCount++;
+    }
+    m_pending.clear();
+    m_hasPending.store(false, std::memory_order_release);
+}
+
+void DonationTracer::RecordStages(const DonationTimestamps& timestamps) {
+    std::array<uint64_t, 7> points = StagePoints(timestamps);
+
+    // A stage is measured only when both ends are known (injected events have no publishedAt,
+    // test donations skip the hub)
+    for (size_t i = 0; i + 1 < points.size(); i++) {
+        if (points[i] != 0 && points[i + 1] >= points[i]) {
+            m_histograms[i].Record(points[i + 1] - points[i]);
+        }
+    }
+
+    auto first = std::find_if(points.begin(), points.end(), [](uint64_t point) { return point != 0; });
+    if (first != points.end() && timestamps.firstFrameNs >= *first) {
+        m_histograms[static_cast<size_t>(TraceStage::Total)].Record(timestamps.firstFrameNs - *first);
+    }
+}
+
+LatencyHistogram DonationTracer::GetHistogram(TraceStage stage) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t index = static_cast<size_t>(stage);
+    return index < STAGE_COUNT ? m_histograms[index] : LatencyHistogram();
+}
+
+uint64_t DonationTracer::GetCompletedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completedCount;
+}
+
+std::vector<std::string> DonationTracer::FormatReport() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> lines;
+    char line[256];
+
+    std::snprintf(line, sizeof(line), "%llu donations traced", static_cast<unsigned long long>(m_completedCount));
+    lines.push_back(line);
+
+    for (size_t i = 0; i < STAGE_COUNT; i++) {
+        const LatencyHistogram& histogram = m_histograms[i];
+        if (histogram.GetCount() == 0) continue;
+        std::snprintf(line, sizeof(line), "%-15s n=%-7llu p50=%9.3f ms  p99=%9.3f ms  p999=%9.3f ms  max=%9.3f ms",
+                      TraceStageName(static_cast<TraceStage>(i)),
+                      static_cast<unsigned long long>(histogram.GetCount()),
+                      histogram.GetPercentile(50.0) / 1e6, histogram.GetPercentile(99.0) / 1e6,
+                      histogram.GetPercentile(99.9) / 1e6, histogram.GetMax() / 1e6);
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+bool DonationTracer::ExportChromeTrace(const std::string& path) const {
+    QJsonArray events;
+
+    auto addEvent = [&events](const char* phase, const QString& name, uint64_t id, uint64_t timeNs,
+                              const QJsonObject& args) {
+        QJsonObject event;
+        event["name"] = name;
+        event["cat"] = "donation";
+        event["ph"] = phase;
+        event["id"] = QString::number(id);
+        event["ts"] = timeNs / 1000.0;    // Microseconds
+        event["pid"] = 1;
+        event["tid"] = 1;
+        if (!args.isEmpty()) {
+            event["args"] = args;
+        }
+        events.append(event);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Oldest first once the ring has wrapped
+        size_t count = m_completed.size();
+        size_t start = count < MAX_TRACES ? 0 : m_completedHead;
+        for (size_t n = 0; n < count; n++) {
+            const Trace& trace = m_completed[(start + n) % count];
+            std::array<uint64_t, 7> points = StagePoints(trace.timestamps);
+
+            auto first = std::find_if(points.begin(), points.end(), [](uint64_t point) { return point != 0; });
+            if (first == points.end()) continue;
+
+            // One async slice per donation with a nested slice per measured stage
+            QJsonObject args;
+            args["amount"] = trace.amount.ToUnits();
+            args["name"] = QString::fromStdString(trace.displayName);
+            args["source"] = QString::fromStdString(trace.sourceId);
+            QString name = DonationTypeName(trace.type);
+            addEvent("b", name, trace.id, *first, args);
+
+            for (size_t i = 0; i + 1 < points.size(); i++) {
+                if (points[i] == 0 || points[i + 1] < points[i]) continue;
+                QString stage = TraceStageName(static_cast<TraceStage>(i));
+                addEvent("b", stage, trace.id, points[i], QJsonObject());
+                addEvent("e", stage, trace.id, points[i + 1], QJsonObject());
+            }
+
+            addEvent("e", name, trace.id, trace.timestamps.firstFrameNs, QJsonObject());
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        blog(LOG_WARNING, "[Tracer] Cannot write %s", path.c_str());
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+void DonationTracer::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    m_completed.clear();
+    m_completedHead = 0;
+    m_completedCount = 0;
+    for (LatencyHistogram& histogram : m_histograms) {
+        histogram.Reset();
+    }
+    m_hasPending.store(false, std::memory_order_release);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "youtube-chat-client.hpp"
+#include "latency-histogram.hpp"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Latency between two consecutive pipeline stages of a donation
+enum class TraceStage {
+    Network,        // publishedAt -> response received (YouTube-side delay + polling + transfer)
+    Parse,          // received -> parsed
+    Queue,          // parsed -> released by the hub (UI-thread hop + reorder window)
+    ConfigResolve,  // released -> effect configuration chosen
+    EffectStart,    // configuration chosen -> effect applied
+    FirstFrame,     // effect applied -> next video frame
+    Total,          // earliest known stage -> first frame
+    Count
+};
+
+const char* TraceStageName(TraceStage stage);
+
+// Collects the DonationTimestamps of every donation that started an effect, waits for
+// the next OBS video frame to stamp firstFrameNs, and aggregates each stage into a
+// histogram. The most recent traces can be exported as Chrome trace-event JSON
+// (chrome://tracing, Perfetto).
+class DonationTracer {
+public:
+    static const size_t MAX_TRACES = 4096;
+
+    DonationTracer();     // Registers the OBS tick callback
+    ~DonationTracer();
+
+    // UI thread, right after the effect for the event was applied
+    void Submit(const DonationEvent& event, const DonationTimestamps& timestamps);
+
+    LatencyHistogram GetHistogram(TraceStage stage) const;
+    uint64_t GetCompletedCount() const;
+
+    // One line per stage: count, p50/p99/p999/max in milliseconds
+    std::vector<std::string> FormatReport() const;
+
+    // Writes the retained traces as async trace events; returns false if the file can't be written
+    bool ExportChromeTrace(const std::string& path) const;
+
+    void Reset();
+
+private:
+    struct Trace {
+        uint64_t id;
+        DonationType type;
+        Money amount;
+        std::string displayName;
+        std::string sourceId;
+        DonationTimestamps timestamps;
+    };
+
+    static void OnVideoTick(void* param, float seconds);
+    void CompletePending(uint64_t frameNs);
+    void RecordStages(const DonationTimestamps& timestamps);
+
+    mutable std::mutex m_mutex;             // Guards everything below; the tick runs on the video thread
+    std::atomic<bool> m_hasPending{false};  // Lets the tick skip the lock on idle frames
+    std::vector<Trace> m_pending;           // Waiting for their first frame
+    std::vector<Trace> m_completed;         // Ring buffer of the last MAX_TRACES traces
+    size_t m_completedHead = 0;
+    uint64_t m_completedCount = 0;
+    uint64_t m_nextId = 1;
+    std::array<LatencyHistogram, static_cast<size_t>(TraceStage::Count)> m_histograms;
+};
@@ -6,6 +6,7 @@
 #include <QFileDialog>
 #include <QLabel>
 #include <QScrollArea>
+#include <QRegularExpression>
 
 EffectConfigDialog::EffectConfigDialog(QWidget* parent)
     : QDialog(parent)
@@ -238,6 +239,12 @@ void EffectConfigDialog::SetupUI() {
     m_durationSpin->setToolTip("エフェクトの持続時間");
     basicLayout->addRow("持続時間:", m_durationSpin);
 
+    m_keywordsEdit = new QLineEdit();
+    m_keywordsEdit->setPlaceholderText("!shake, :shake:, 揺れろ");
+    m_keywordsEdit->setToolTip("通常チャットにこの語句が含まれると発動（カンマ区切り）\n"
+                               "設定すると金額では発動しません。全角/半角・大文字/小文字は区別しません");
+    basicLayout->addRow("キーワード:", m_keywordsEdit);
+
     basicGroup->setLayout(basicLayout);
     contentLayout->addWidget(basicGroup);
 
@@ -448,6 +455,26 @@ void EffectConfigDialog::SetupUI() {
     m_shrinkSmoothCheck->setChecked(true);
     shrinkLayout->addRow("", m_shrinkSmoothCheck);
 
+    m_shrinkEasingCombo = new QComboBox();
+    m_shrinkEasingCombo->addItem("リニア");
+    m_shrinkEasingCombo->addItem("加速");
+    m_shrinkEasingCombo->addItem("減速");
+    m_shrinkEasingCombo->addItem("加速→減速");
+    m_shrinkEasingCombo->addItem("バック");
+    m_shrinkEasingCombo->addItem("バウンド");
+    m_shrinkEasingCombo->setCurrentIndex(2);
+    shrinkLayout->addRow("イージング:", m_shrinkEasingCombo);
+
+    m_shrinkAnimDurationSpin = new QDoubleSpinBox();
+    m_shrinkAnimDurationSpin->setRange(0.1, 5.0);
+    m_shrinkAnimDurationSpin->setValue(0.6);
+    m_shrinkAnimDurationSpin->setSingleStep(0.1);
+    m_shrinkAnimDurationSpin->setSuffix(" 秒");
+    shrinkLayout->addRow("アニメーション時間:", m_shrinkAnimDurationSpin);
+
+    connect(m_shrinkSmoothCheck, &QCheckBox::toggled, m_shrinkEasingCombo, &QWidget::setEnabled);
+    connect(m_shrinkSmoothCheck, &QCheckBox::toggled, m_shrinkAnimDurationSpin, &QWidget::setEnabled);
+
     m_parameterStack->addWidget(m_shrinkWidget);
 
     // 11: パーティクル
@@ -556,9 +583,10 @@ void EffectConfigDialog::OnBrowseVideoFolder() {
 }
 
 void EffectConfigDialog::SetEffectSettings(const EffectSettings& settings) {
-    m_amountSpin->setValue(settings.amount);
+    m_amountSpin->setValue(settings.amount.ToUnits());
     m_effectTypeCombo->setCurrentIndex(static_cast<int>(settings.action));
     m_durationSpin->setValue(settings.duration);
+    m_keywordsEdit->setText(settings.keywords.join(", "));
 
     // 画像/動画パス設定
     m_mediaPathEdit->setText(settings.mediaPath);
@@ -587,6 +615,8 @@ void EffectConfigDialog::SetEffectSettings(const EffectSettings& settings) {
 
     m_shrinkPercentageSpin->setValue(settings.shrinkPercentage);
     m_shrinkSmoothCheck->setChecked(settings.shrinkSmooth);
+    m_shrinkEasingCombo->setCurrentIndex(settings.shrinkEasing);
+    m_shrinkAnimDurationSpin->setValue(settings.shrinkAnimDuration);
 
     m_particleCountSpin->setValue(settings.particleCount);
     m_particleTypeCombo->setCurrentIndex(settings.particleType);
@@ -597,9 +627,14 @@ void EffectConfigDialog::SetEffectSettings(const EffectSettings& settings) {
 EffectSettings EffectConfigDialog::GetEffectSettings() const {
     EffectSettings settings;
 
-    settings.amount = m_amountSpin->value();
+    settings.amount = Money::FromUnits(m_amountSpin->value());
     settings.action = static_cast<EffectAction>(m_effectTypeCombo->currentIndex());
     settings.duration = m_durationSpin->value();
+    for (const QString& keyword : m_keywordsEdit->text().split(QRegularExpression("[,、，]"))) {
+        if (!keyword.trimmed().isEmpty()) {
+            settings.keywords.append(keyword.trimmed());
+        }
+    }
 
     // 画像または動画パスを取得（選択されたエフェクトタイプに応じて）
     if (settings.action == EffectAction::ImageOverlay) {
@@ -631,6 +666,8 @@ EffectSettings EffectConfigDialog::GetEffectSettings() const {
 
     settings.shrinkPercentage = m_shrinkPercentageSpin->value();
     settings.shrinkSmooth = m_shrinkSmoothCheck->isChecked();
+    settings.shrinkEasing = m_shrinkEasingCombo->currentIndex();
+    settings.shrinkAnimDuration = m_shrinkAnimDurationSpin->value();
 
     settings.particleCount = m_particleCountSpin->value();
     settings.particleType = m_particleTypeCombo->currentIndex();
@@ -36,6 +36,7 @@ private:
     QDoubleSpinBox* m_amountSpin;
     QComboBox* m_effectTypeCombo;
     QDoubleSpinBox* m_durationSpin;
+    QLineEdit* m_keywordsEdit;
 
     // スタックウィジェット（エフェクトごとのパラメータ）
     QStackedWidget* m_parameterStack;
@@ -87,6 +88,8 @@ private:
     QWidget* m_shrinkWidget;
     QDoubleSpinBox* m_shrinkPercentageSpin;
     QCheckBox* m_shrinkSmoothCheck;
+    QComboBox* m_shrinkEasingCombo;
+    QDoubleSpinBox* m_shrinkAnimDurationSpin;
 
     // === パーティクル ===
     QWidget* m_particleWidget;
@@ -264,7 +264,7 @@ void EffectConfigManager::OnAddConfig() {
         RefreshTable();
         emit ConfigurationsChanged();
 
-        blog(LOG_INFO, "[EffectConfig] Added new configuration for %.2f JPY", settings.amount);
+        blog(LOG_INFO, "[EffectConfig] Added new configuration for %.2f JPY", settings.amount.ToUnits());
     }
 }
 
@@ -286,7 +286,7 @@ void EffectConfigManager::OnEditConfig() {
         RefreshTable();
         emit ConfigurationsChanged();
 
-        blog(LOG_INFO, "[EffectConfig] Updated configuration for %.2f JPY", newSettings.amount);
+        blog(LOG_INFO, "[EffectConfig] Updated configuration for %.2f JPY", newSettings.amount.ToUnits());
     }
 }
 
@@ -302,7 +302,7 @@ void EffectConfigManager::OnDeleteConfig() {
     QMessageBox::StandardButton reply = QMessageBox::question(
         this,
         "設定の削除",
-        QString("金額 %1 JPY の設定を削除しますか？").arg(settings.amount),
+        QString("金額 %1 JPY の設定を削除しますか？").arg(settings.amount.ToUnits()),
         QMessageBox::Yes | QMessageBox::No
     );
 
@@ -311,7 +311,7 @@ void EffectConfigManager::OnDeleteConfig() {
         RefreshTable();
         emit ConfigurationsChanged();
 
-        blog(LOG_INFO, "[EffectConfig] Deleted configuration for %.2f JPY", settings.amount);
+        blog(LOG_INFO, "[EffectConfig] Deleted configuration for %.2f JPY", settings.amount.ToUnits());
     }
 }
 
@@ -330,7 +330,7 @@ void EffectConfigManager::OnTestConfig() {
     }
 
     blog(LOG_INFO, "[EffectConfig] Testing configuration: %.2f JPY, Action: %d",
-         settings.amount, static_cast<int>(settings.action));
+         settings.amount.ToUnits(), static_cast<int>(settings.action));
 
     // Apply the configured effect directly
     g_obstructionManager->ApplyConfiguredEffect(settings);
@@ -365,7 +365,7 @@ void EffectConfigManager::OnTestConfig() {
         this,
         "✓ テスト実行",
         QString("金額: %1 JPY\nエフェクト: %2\n持続時間: %3秒%4\n\n設定したエフェクトを適用しました。\nOBSプレビューを確認してください。")
-            .arg(settings.amount)
+            .arg(settings.amount.ToUnits())
             .arg(EffectActionToString(settings.action))
             .arg(settings.duration)
             .arg(effectDetails)
@@ -405,8 +405,11 @@ void EffectConfigManager::RefreshTable() {
         int row = m_configTable->rowCount();
         m_configTable->insertRow(row);
 
-        // Amount
-        m_configTable->setItem(row, 0, new QTableWidgetItem(QString::number(config.amount, 'f', 0)));
+        // Amount (keyword rules are not triggered by amount)
+        QString trigger = config.keywords.isEmpty()
+            ? QString::number(config.amount.ToUnits(), 'f', 0)
+            : QString("キーワード: %1").arg(config.keywords.join(", "));
+        m_configTable->setItem(row, 0, new QTableWidgetItem(trigger));
 
         // Effect type
         m_configTable->setItem(row, 1, new QTableWidgetItem(EffectActionToString(config.action)));
@@ -27,10 +27,13 @@ EffectSettings EffectConfigList::GetConfig(int index) const {
     return EffectSettings();
 }
 
-EffectSettings EffectConfigList::FindConfigForAmount(double amount) const {
+EffectSettings EffectConfigList::FindConfigForAmount(Money amount) const {
     // 金額以下の最大設定を探す
     EffectSettings result;
     for (const auto& config : m_configs) {
+        if (!config.keywords.isEmpty()) {
+            continue;  // キーワード専用の設定
+        }
         if (amount >= config.amount) {
             result = config;
         } else {
@@ -51,9 +54,11 @@ QVariantList EffectConfigList::ToVariantList() const {
     QVariantList list;
     for (const auto& config : m_configs) {
         QVariantMap map;
-        map["amount"] = config.amount;
+        map["amount"] = config.amount.ToUnits();             // 旧バージョン・手動編集向け
+        map["amountMicros"] = static_cast<qlonglong>(config.amount.Micros());
         map["action"] = static_cast<int>(config.action);
         map["duration"] = config.duration;
+        map["keywords"] = config.keywords;
         map["mediaPath"] = config.mediaPath;
         map["mediaFolder"] = config.mediaFolder;
         map["imageScale"] = config.imageScale;
@@ -71,6 +76,8 @@ QVariantList EffectConfigList::ToVariantList() const {
         map["rotationReverse"] = config.rotationReverse;
         map["shrinkPercentage"] = config.shrinkPercentage;
         map["shrinkSmooth"] = config.shrinkSmooth;
+        map["shrinkEasing"] = config.shrinkEasing;
+        map["shrinkAnimDuration"] = config.shrinkAnimDuration;
         map["particleCount"] = config.particleCount;
         map["particleType"] = config.particleType;
         list.append(map);
@@ -83,9 +90,13 @@ void EffectConfigList::FromVariantList(const QVariantList& list) {
     for (const auto& item : list) {
         QVariantMap map = item.toMap();
         EffectSettings config;
-        config.amount = map["amount"].toDouble();
+        // amountMicros があれば丸め誤差のないそちらを優先
+        config.amount = map.contains("amountMicros")
+            ? Money::FromMicros(map["amountMicros"].toLongLong())
+            : Money::FromUnits(map["amount"].toDouble());
         config.action = static_cast<EffectAction>(map["action"].toInt());
         config.duration = map["duration"].toDouble();
+        config.keywords = map["keywords"].toStringList();
         config.mediaPath = map["mediaPath"].toString();
         config.mediaFolder = map["mediaFolder"].toString();
         config.imageScale = map["imageScale"].toDouble();
@@ -103,6 +114,8 @@ void EffectConfigList::FromVariantList(const QVariantList& list) {
         config.rotationReverse = map["rotationReverse"].toBool();
         config.shrinkPercentage = map["shrinkPercentage"].toDouble();
         config.shrinkSmooth = map["shrinkSmooth"].toBool();
+        config.shrinkEasing = map.value("shrinkEasing", config.shrinkEasing).toInt();
+        config.shrinkAnimDuration = map.value("shrinkAnimDuration", config.shrinkAnimDuration).toDouble();
         config.particleCount = map["particleCount"].toInt();
         config.particleType = map["particleType"].toInt();
         m_configs.append(config);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "money.hpp"
 #include <QString>
+#include <QStringList>
 #include <QList>
 #include <QVariant>
 
@@ -23,9 +25,10 @@ enum class EffectAction {
 
 // 各エフェクトの詳細設定
 struct EffectSettings {
-    double amount;              // 金額（JPY）
+    Money amount;               // 金額（JPY、固定小数点）
     EffectAction action;        // エフェクトの種類
     double duration;            // 持続時間（秒）
+    QStringList keywords;       // 通常チャットで発動するキーワード（空=金額で発動、設定時は金額では発動しない）
 
     // === エフェクト固有のパラメータ ===
 
@@ -59,6 +62,8 @@ struct EffectSettings {
     // 画面縮小
     double shrinkPercentage;    // 縮小率（%、0=消える, 100=変化なし）
     bool shrinkSmooth;          // スムーズ縮小
+    int shrinkEasing;           // イージング（0=リニア, 1=加速, 2=減速, 3=加速→減速, 4=バック, 5=バウンド）
+    double shrinkAnimDuration;  // アニメーション時間（秒）
 
     // パーティクル
     int particleCount;          // パーティクル数
@@ -66,7 +71,7 @@ struct EffectSettings {
 
     // コンストラクタ（デフォルト値）
     EffectSettings()
-        : amount(1000.0)
+        : amount(Money::FromWholeUnits(1000))
         , action(EffectAction::Random)
         , duration(5.0)
         , mediaPath("")
@@ -86,6 +91,8 @@ struct EffectSettings {
         , rotationReverse(false)
         , shrinkPercentage(20.0)
         , shrinkSmooth(true)
+        , shrinkEasing(2)
+        , shrinkAnimDuration(0.6)
         , particleCount(50)
         , particleType(0)
     {}
@@ -102,7 +109,7 @@ public:
     void Clear() { m_configs.clear(); }
 
     // 金額に基づいて適切な設定を取得
-    EffectSettings FindConfigForAmount(double amount) const;
+    EffectSettings FindConfigForAmount(Money amount) const;
 
     // すべての設定を取得
     const QList<EffectSettings>& GetAllConfigs() const { return m_configs; }
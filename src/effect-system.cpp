@@ -1,13 +1,21 @@
 #include "effect-system.hpp"
+#include "source-registry.hpp"
+#include "overlay-placement.hpp"
+#include "obs-call-scope.hpp"
+#include "plugin-log.hpp"
+#include "plugin-metrics.hpp"
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include <obs-source.h>
+#include <util/platform.h>
 #include <graphics/vec2.h>
 #include <graphics/vec3.h>
 #include <graphics/matrix4.h>
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <array>
+#include "obs-call-profiler.hpp"     // Keep last
 
 // =============================================================================
 // EffectBase Implementation
@@ -23,6 +31,11 @@ EffectBase::EffectBase(obs_source_t* source, double duration, QObject* parent)
 {
     // Note: Source reference is managed by the caller, no need to addref
 
+    uint32_t canvasWidth, canvasHeight;
+    GetCanvasSize(&canvasWidth, &canvasHeight);
+    m_canvasWidth = static_cast<float>(canvasWidth);
+    m_canvasHeight = static_cast<float>(canvasHeight);
+
     // 60 FPS update rate
     m_timer->setInterval(16); // ~60 FPS
     connect(m_timer, &QTimer::timeout, this, &EffectBase::OnTimerTick);
@@ -33,6 +46,9 @@ EffectBase::~EffectBase() {
 }
 
 void EffectBase::OnTimerTick() {
+    OBS_CALL_SCOPE(metaObject()->className());
+    uint64_t startNs = os_gettime_ns();
+
     m_elapsedTime += 0.016; // 16ms in seconds
 
     Update(m_elapsedTime);
@@ -40,6 +56,8 @@ void EffectBase::OnTimerTick() {
     if (m_elapsedTime >= m_duration) {
         Stop();
     }
+
+    g_metrics.RecordEffectTick(os_gettime_ns() - startNs);
 }
 
 // =============================================================================
@@ -82,8 +100,8 @@ void RotationEffect::Start() {
     const char* rotationTypeStr = (m_rotationType == 0) ? "Z軸" :
                                   (m_rotationType == 1) ? "X軸" :
                                   (m_rotationType == 2) ? "Y軸" : "全軸";
-    blog(LOG_INFO, "[Effect] Rotation effect started (%.1fs, %.1f rot/s, %s%s)",
-         m_duration, m_rotationsPerSecond, rotationTypeStr, m_reverse ? ", 逆回転" : "");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Rotation effect started (%.1fs, %.1f rot/s, %s%s)",
+               m_duration, m_rotationsPerSecond, rotationTypeStr, m_reverse ? ", 逆回転" : "");
 }
 
 void RotationEffect::Stop() {
@@ -105,7 +123,7 @@ void RotationEffect::Stop() {
         obs_source_release(sceneSource);
     }
 
-    blog(LOG_INFO, "[Effect] Rotation effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Rotation effect stopped");
 }
 
 void RotationEffect::Update(double elapsed) {
@@ -189,7 +207,7 @@ void BlinkEffect::Start() {
     m_isVisible = true;
     m_timer->start();
 
-    blog(LOG_INFO, "[Effect] Blink effect started (%.1fs, %.1f Hz)", m_duration, m_blinkFrequency);
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Blink effect started (%.1fs, %.1f Hz)", m_duration, m_blinkFrequency);
 }
 
 void BlinkEffect::Stop() {
@@ -212,7 +230,7 @@ void BlinkEffect::Stop() {
     }
 
     obs_source_release(sceneSource);
-    blog(LOG_INFO, "[Effect] Blink effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Blink effect stopped");
 }
 
 void BlinkEffect::Update(double elapsed) {
@@ -266,9 +284,9 @@ void HueShiftEffect::Start() {
     m_colorFilter = obs_source_create("color_filter", "temp_hue_shift_filter", settings, nullptr);
     if (m_colorFilter) {
         obs_source_filter_add(m_source, m_colorFilter);
-        blog(LOG_INFO, "[Effect] Hue shift effect started (%.1fs, %.1f deg/s)", m_duration, m_shiftSpeed);
+        PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Hue shift effect started (%.1fs, %.1f deg/s)", m_duration, m_shiftSpeed);
     } else {
-        blog(LOG_WARNING, "[Effect] Failed to create color filter for hue shift effect");
+        PLUGIN_LOG(LogCategory::Effects, LOG_WARNING, "[Effect] Failed to create color filter for hue shift effect");
         m_isActive = false;
     }
 
@@ -290,7 +308,7 @@ void HueShiftEffect::Stop() {
         m_colorFilter = nullptr;
     }
 
-    blog(LOG_INFO, "[Effect] Hue shift effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Hue shift effect stopped");
 }
 
 void HueShiftEffect::Update(double elapsed) {
@@ -341,7 +359,7 @@ void ShakeEffect::Start() {
 
     obs_source_release(sceneSource);
 
-    blog(LOG_INFO, "[Effect] Shake effect started (%.1fs, intensity: %.1f)", m_duration, m_intensity);
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Shake effect started (%.1fs, intensity: %.1f)", m_duration, m_intensity);
 }
 
 void ShakeEffect::Stop() {
@@ -365,7 +383,7 @@ void ShakeEffect::Stop() {
 
     obs_source_release(sceneSource);
 
-    blog(LOG_INFO, "[Effect] Shake effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Shake effect stopped");
 }
 
 void ShakeEffect::Update(double elapsed) {
@@ -420,15 +438,15 @@ void KaleidoscopeEffect::Start() {
                 obs_sceneitem_get_pos(sceneItem, &m_originalPos);
                 obs_sceneitem_get_scale(sceneItem, &m_originalScale);
                 m_originalRot = obs_sceneitem_get_rot(sceneItem);
-                blog(LOG_INFO, "[Effect] Saved kaleidoscope original transform: pos=(%.2f,%.2f), scale=(%.2f,%.2f), rot=%.2f",
-                     m_originalPos.x, m_originalPos.y, m_originalScale.x, m_originalScale.y, m_originalRot);
+                PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Saved kaleidoscope original transform: pos=(%.2f,%.2f), scale=(%.2f,%.2f), rot=%.2f",
+                           m_originalPos.x, m_originalPos.y, m_originalScale.x, m_originalScale.y, m_originalRot);
             }
         }
         obs_source_release(sceneSource);
     }
 
     m_timer->start();
-    blog(LOG_INFO, "[Effect] Kaleidoscope effect started (%d segments)", m_segments);
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Kaleidoscope effect started (%d segments)", m_segments);
 }
 
 void KaleidoscopeEffect::Stop() {
@@ -445,7 +463,7 @@ void KaleidoscopeEffect::Stop() {
                 obs_sceneitem_set_pos(sceneItem, &m_originalPos);
                 obs_sceneitem_set_scale(sceneItem, &m_originalScale);
                 obs_sceneitem_set_rot(sceneItem, m_originalRot);
-                blog(LOG_INFO, "[Effect] Restored kaleidoscope original transform");
+                PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Restored kaleidoscope original transform");
             }
         }
         obs_source_release(sceneSource);
@@ -459,7 +477,7 @@ void KaleidoscopeEffect::Stop() {
     }
     m_mirrorSources.clear();
 
-    blog(LOG_INFO, "[Effect] Kaleidoscope effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Kaleidoscope effect stopped");
 }
 
 void KaleidoscopeEffect::Update(double elapsed) {
@@ -524,15 +542,15 @@ void Rotation3DEffect::Start() {
                 obs_sceneitem_get_pos(sceneItem, &m_originalPos);
                 obs_sceneitem_get_scale(sceneItem, &m_originalScale);
                 m_originalRot = obs_sceneitem_get_rot(sceneItem);
-                blog(LOG_INFO, "[Effect] Saved 3D rotation original transform: pos=(%.2f,%.2f), scale=(%.2f,%.2f), rot=%.2f",
-                     m_originalPos.x, m_originalPos.y, m_originalScale.x, m_originalScale.y, m_originalRot);
+                PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Saved 3D rotation original transform: pos=(%.2f,%.2f), scale=(%.2f,%.2f), rot=%.2f",
+                           m_originalPos.x, m_originalPos.y, m_originalScale.x, m_originalScale.y, m_originalRot);
             }
         }
         obs_source_release(sceneSource);
     }
 
     m_timer->start();
-    blog(LOG_INFO, "[Effect] 3D Rotation effect started (X: %d, Y: %d)", m_rotateX, m_rotateY);
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] 3D Rotation effect started (X: %d, Y: %d)", m_rotateX, m_rotateY);
 }
 
 void Rotation3DEffect::Stop() {
@@ -549,13 +567,13 @@ void Rotation3DEffect::Stop() {
                 obs_sceneitem_set_pos(sceneItem, &m_originalPos);
                 obs_sceneitem_set_scale(sceneItem, &m_originalScale);
                 obs_sceneitem_set_rot(sceneItem, m_originalRot);
-                blog(LOG_INFO, "[Effect] Restored 3D rotation original transform");
+                PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Restored 3D rotation original transform");
             }
         }
         obs_source_release(sceneSource);
     }
 
-    blog(LOG_INFO, "[Effect] 3D Rotation effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] 3D Rotation effect stopped");
 }
 
 void Rotation3DEffect::Update(double elapsed) {
@@ -624,13 +642,13 @@ void RandomShapesEffect::Start() {
     m_elapsedTime = 0.0;
     m_shapes.clear();
 
-    // Use full screen dimensions for shapes (not source dimensions)
-    uint32_t screenWidth = 1920;
-    uint32_t screenHeight = 1080;
+    // Use full canvas dimensions for shapes (not source dimensions)
+    float screenWidth = m_canvasWidth;
+    float screenHeight = m_canvasHeight;
 
     // Initialize random shapes with actual color sources across entire screen
-    std::uniform_real_distribution<float> posXDist(0.0f, static_cast<float>(screenWidth));
-    std::uniform_real_distribution<float> posYDist(0.0f, static_cast<float>(screenHeight));
+    std::uniform_real_distribution<float> posXDist(0.0f, screenWidth);
+    std::uniform_real_distribution<float> posYDist(0.0f, screenHeight);
     std::uniform_real_distribution<float> velDist(-100.0f, 100.0f);
     std::uniform_real_distribution<float> sizeDist(30.0f, 80.0f);
     std::uniform_int_distribution<int> typeDist(0, 2);
@@ -638,7 +656,7 @@ void RandomShapesEffect::Start() {
 
     obs_source_t* sceneSource = obs_frontend_get_current_scene();
     if (!sceneSource) {
-        blog(LOG_WARNING, "[Effect] Cannot create random shapes - no current scene");
+        PLUGIN_LOG(LogCategory::Effects, LOG_WARNING, "[Effect] Cannot create random shapes - no current scene");
         return;
     }
 
@@ -675,7 +693,7 @@ void RandomShapesEffect::Start() {
         obs_data_release(settings);
 
         if (colorSource) {
-            obs_sceneitem_t* item = obs_scene_add(scene, colorSource);
+            obs_sceneitem_t* item = SourceRegistry::Instance().AddToScene(scene, colorSource);
             if (item) {
                 // Set initial position
                 vec2 pos;
@@ -686,13 +704,13 @@ void RandomShapesEffect::Start() {
                 // Set blend mode for nice visual effect
                 obs_sceneitem_set_blending_mode(item, OBS_BLEND_ADDITIVE);
 
-                blog(LOG_INFO, "[Effect] Created random shape %d at (%.1f, %.1f) size=%.1f color=0x%08X",
-                     i, shape.position.x, shape.position.y, shape.size, shape.color);
+                PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Created random shape %d at (%.1f, %.1f) size=%.1f color=0x%08X",
+                           i, shape.position.x, shape.position.y, shape.size, shape.color);
             }
             // Release the creation reference (scene now owns it)
             obs_source_release(colorSource);
         } else {
-            blog(LOG_WARNING, "[Effect] Failed to create color source for random shape %d", i);
+            PLUGIN_LOG(LogCategory::Effects, LOG_WARNING, "[Effect] Failed to create color source for random shape %d", i);
         }
 
         m_shapes.push_back(shape);
@@ -701,7 +719,7 @@ void RandomShapesEffect::Start() {
     obs_source_release(sceneSource);
 
     m_timer->start();
-    blog(LOG_INFO, "[Effect] Random shapes effect started (%d shapes)", m_shapeCount);
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Random shapes effect started (%d shapes)", m_shapeCount);
 }
 
 void RandomShapesEffect::Stop() {
@@ -719,7 +737,7 @@ void RandomShapesEffect::Stop() {
 
                 obs_sceneitem_t* item = obs_scene_find_source(scene, shapeName);
                 if (item) {
-                    obs_sceneitem_remove(item);
+                    SourceRegistry::Instance().Remove(item);
                 }
             }
         }
@@ -727,13 +745,13 @@ void RandomShapesEffect::Stop() {
     }
 
     m_shapes.clear();
-    blog(LOG_INFO, "[Effect] Random shapes effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Random shapes effect stopped");
 }
 
 void RandomShapesEffect::Update(double elapsed) {
-    // Use full screen dimensions for boundary checking
-    uint32_t screenWidth = 1920;
-    uint32_t screenHeight = 1080;
+    // Use full canvas dimensions for boundary checking
+    float screenWidth = m_canvasWidth;
+    float screenHeight = m_canvasHeight;
 
     obs_source_t* sceneSource = obs_frontend_get_current_scene();
     if (!sceneSource) return;
@@ -754,11 +772,11 @@ void RandomShapesEffect::Update(double elapsed) {
         // Bounce off edges of entire screen
         if (shape.position.x < 0 || shape.position.x > screenWidth) {
             shape.velocity.x *= -1.0f;
-            shape.position.x = std::clamp(shape.position.x, 0.0f, static_cast<float>(screenWidth));
+            shape.position.x = std::clamp(shape.position.x, 0.0f, screenWidth);
         }
         if (shape.position.y < 0 || shape.position.y > screenHeight) {
             shape.velocity.y *= -1.0f;
-            shape.position.y = std::clamp(shape.position.y, 0.0f, static_cast<float>(screenHeight));
+            shape.position.y = std::clamp(shape.position.y, 0.0f, screenHeight);
         }
 
         // Update the color source position in scene
@@ -812,8 +830,8 @@ void ParticleSystemEffect::Start() {
 
     // Get screen center for explosion effects
     vec2 screenCenter;
-    screenCenter.x = 1920.0f / 2.0f;
-    screenCenter.y = 1080.0f / 2.0f;
+    screenCenter.x = m_canvasWidth / 2.0f;
+    screenCenter.y = m_canvasHeight / 2.0f;
 
     // Initialize all particles based on type
     for (int i = 0; i < m_particleCount; ++i) {
@@ -868,8 +886,8 @@ void ParticleSystemEffect::Start() {
     const char* typeStr = (m_particleType == 0) ? "爆発" :
                          (m_particleType == 1) ? "雨" :
                          (m_particleType == 2) ? "雪" : "星";
-    blog(LOG_INFO, "[Effect] Cinema-quality particle system started: %s (%d particles)",
-         typeStr, m_particleCount);
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Cinema-quality particle system started: %s (%d particles)",
+               typeStr, m_particleCount);
 }
 
 void ParticleSystemEffect::Stop() {
@@ -880,7 +898,7 @@ void ParticleSystemEffect::Stop() {
     m_particles.clear();
     m_particleSources.clear();
 
-    blog(LOG_INFO, "[Effect] Particle system effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Particle system effect stopped");
 }
 
 void ParticleSystemEffect::Update(double elapsed) {
@@ -896,8 +914,8 @@ void ParticleSystemEffect::Update(double elapsed) {
         // Respawn particle if dead
         if (particle.life <= 0.0f) {
             vec2 screenCenter;
-            screenCenter.x = 1920.0f / 2.0f;
-            screenCenter.y = 1080.0f / 2.0f;
+            screenCenter.x = m_canvasWidth / 2.0f;
+            screenCenter.y = m_canvasHeight / 2.0f;
 
             switch (m_particleType) {
                 case 0: InitExplosionParticle(particle, screenCenter); break;
@@ -1009,7 +1027,7 @@ void ParticleSystemEffect::UpdateExplosionParticle(Particle& particle, float del
 // =============================================================================
 
 void ParticleSystemEffect::InitRainParticle(Particle& particle) {
-    std::uniform_real_distribution<float> posXDist(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> posXDist(0.0f, m_canvasWidth);
     std::uniform_real_distribution<float> speedDist(400.0f, 800.0f);
     std::uniform_real_distribution<float> windDist(-30.0f, 30.0f);
 
@@ -1039,7 +1057,7 @@ void ParticleSystemEffect::UpdateRainParticle(Particle& particle, float deltaTim
     particle.position.y += particle.velocity.y * deltaTime;
 
     // Check if hit ground
-    if (particle.position.y > 1080.0f) {
+    if (particle.position.y > m_canvasHeight) {
         // Create splash effect by changing phase
         if (particle.phase == 0) {
             particle.phase = 1; // Splash
@@ -1063,7 +1081,7 @@ void ParticleSystemEffect::UpdateRainParticle(Particle& particle, float deltaTim
 // =============================================================================
 
 void ParticleSystemEffect::InitSnowParticle(Particle& particle) {
-    std::uniform_real_distribution<float> posXDist(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> posXDist(0.0f, m_canvasWidth);
     std::uniform_real_distribution<float> posYDist(-100.0f, 0.0f);
     std::uniform_real_distribution<float> speedDist(20.0f, 60.0f);
     std::uniform_real_distribution<float> sizeDist(8.0f, 25.0f);
@@ -1101,7 +1119,8 @@ void ParticleSystemEffect::UpdateSnowParticle(Particle& particle, float deltaTim
     particle.rotation += particle.rotationSpeed * deltaTime;
 
     // Check if off screen
-    if (particle.position.y > 1150.0f || particle.position.x < -50.0f || particle.position.x > 1970.0f) {
+    if (particle.position.y > m_canvasHeight + 70.0f || particle.position.x < -50.0f ||
+        particle.position.x > m_canvasWidth + 50.0f) {
         particle.life = 0.0f; // Respawn
     }
 
@@ -1115,8 +1134,8 @@ void ParticleSystemEffect::UpdateSnowParticle(Particle& particle, float deltaTim
 // =============================================================================
 
 void ParticleSystemEffect::InitStarParticle(Particle& particle) {
-    std::uniform_real_distribution<float> posXDist(0.0f, 1920.0f);
-    std::uniform_real_distribution<float> posYDist(0.0f, 1080.0f);
+    std::uniform_real_distribution<float> posXDist(0.0f, m_canvasWidth);
+    std::uniform_real_distribution<float> posYDist(0.0f, m_canvasHeight);
     std::uniform_real_distribution<float> sizeDist(10.0f, 30.0f);
     std::uniform_real_distribution<float> lifeDist(2.0f, 5.0f);
 
@@ -1229,7 +1248,7 @@ void ParticleSystemEffect::CreateParticleSource(int index, const Particle& parti
     obs_data_release(settings);
 
     if (colorSource) {
-        obs_sceneitem_t* item = obs_scene_add(scene, colorSource);
+        obs_sceneitem_t* item = SourceRegistry::Instance().AddToScene(scene, colorSource);
         if (item) {
             // Set initial position
             vec2 pos;
@@ -1308,7 +1327,7 @@ void ParticleSystemEffect::RemoveAllParticleSources() {
                 snprintf(particleName, sizeof(particleName), "particle_%d", static_cast<int>(i));
                 obs_sceneitem_t* item = obs_scene_find_source(scene, particleName);
                 if (item) {
-                    obs_sceneitem_remove(item);
+                    SourceRegistry::Instance().Remove(item);
                 }
                 obs_source_release(m_particleSources[i]);
                 m_particleSources[i] = nullptr;
@@ -1355,20 +1374,20 @@ void ProgressBarEffect::Start() {
         if (sceneSource) {
             obs_scene_t* scene = obs_scene_from_source(sceneSource);
             if (scene) {
-                obs_sceneitem_t* item = obs_scene_add(scene, m_progressBarSource);
+                obs_sceneitem_t* item = SourceRegistry::Instance().AddToScene(scene, m_progressBarSource);
                 if (item) {
                     // Position at top center
                     vec2 pos;
-                    pos.x = 1920.0f / 2.0f - 100.0f;
+                    pos.x = m_canvasWidth / 2.0f - 100.0f;
                     pos.y = 50.0f;
                     obs_sceneitem_set_pos(item, &pos);
                 }
             }
             obs_source_release(sceneSource);
         }
-        blog(LOG_INFO, "[Effect] Progress bar effect started");
+        PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Progress bar effect started");
     } else {
-        blog(LOG_WARNING, "[Effect] Failed to create progress bar source");
+        PLUGIN_LOG(LogCategory::Effects, LOG_WARNING, "[Effect] Failed to create progress bar source");
         m_isActive = false;
     }
 
@@ -1391,7 +1410,7 @@ void ProgressBarEffect::Stop() {
             if (scene) {
                 obs_sceneitem_t* item = obs_scene_find_source(scene, obs_source_get_name(m_progressBarSource));
                 if (item) {
-                    obs_sceneitem_remove(item);
+                    SourceRegistry::Instance().Remove(item);
                 }
             }
             obs_source_release(sceneSource);
@@ -1400,7 +1419,7 @@ void ProgressBarEffect::Stop() {
         m_progressBarSource = nullptr;
     }
 
-    blog(LOG_INFO, "[Effect] Progress bar effect stopped");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[Effect] Progress bar effect stopped");
 }
 
 void ProgressBarEffect::Update(double elapsed) {
@@ -1512,15 +1531,17 @@ void EffectManager::ApplyEffect(obs_source_t* source, EffectType type, double in
             break;
 
         default:
-            blog(LOG_WARNING, "[EffectManager] Unknown effect type");
+            PLUGIN_LOG(LogCategory::Effects, LOG_WARNING, "[EffectManager] Unknown effect type");
             return;
     }
 
     if (effect) {
+        OBS_CALL_SCOPE(effect->metaObject()->className());
         effect->Start();
         m_activeEffects.push_back(std::move(effect));
+        g_metrics.effectsStarted.fetch_add(1, std::memory_order_relaxed);
 
-        blog(LOG_INFO, "[EffectManager] Applied effect, total active: %d", GetActiveEffectCount());
+        PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[EffectManager] Applied effect, total active: %d", GetActiveEffectCount());
     }
 }
 
@@ -1529,11 +1550,13 @@ void EffectManager::ApplyRotationEffect(obs_source_t* source, double duration, d
     auto effect = std::make_unique<RotationEffect>(source, duration, speed, rotationType, reverse);
 
     if (effect) {
+        OBS_CALL_SCOPE(effect->metaObject()->className());
         effect->Start();
         m_activeEffects.push_back(std::move(effect));
+        g_metrics.effectsStarted.fetch_add(1, std::memory_order_relaxed);
 
-        blog(LOG_INFO, "[EffectManager] Applied rotation effect with custom params, total active: %d",
-             GetActiveEffectCount());
+        PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[EffectManager] Applied rotation effect with custom params, total active: %d",
+                   GetActiveEffectCount());
     }
 }
 
@@ -1541,35 +1564,54 @@ void EffectManager::ApplyParticleEffect(obs_source_t* source, double duration, i
     auto effect = std::make_unique<ParticleSystemEffect>(source, duration, particleCount, particleType);
 
     if (effect) {
+        OBS_CALL_SCOPE(effect->metaObject()->className());
         effect->Start();
         m_activeEffects.push_back(std::move(effect));
+        g_metrics.effectsStarted.fetch_add(1, std::memory_order_relaxed);
 
         const char* typeStr = (particleType == 0) ? "爆発" :
                              (particleType == 1) ? "雨" :
                              (particleType == 2) ? "雪" : "星";
-        blog(LOG_INFO, "[EffectManager] Applied particle effect: type=%s, count=%d, total active: %d",
-             typeStr, particleCount, GetActiveEffectCount());
+        PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[EffectManager] Applied particle effect: type=%s, count=%d, total active: %d",
+                   typeStr, particleCount, GetActiveEffectCount());
     }
 }
 
 void EffectManager::ClearAllEffects() {
     for (auto& effect : m_activeEffects) {
         if (effect && effect->IsActive()) {
+            OBS_CALL_SCOPE(effect->metaObject()->className());
             effect->Stop();
         }
     }
+    g_metrics.effectsCompleted.fetch_add(m_activeEffects.size(), std::memory_order_relaxed);
     m_activeEffects.clear();
+    PublishActiveEffects();
 
-    blog(LOG_INFO, "[EffectManager] All effects cleared");
+    PLUGIN_LOG(LogCategory::Effects, LOG_INFO, "[EffectManager] All effects cleared");
 }
 
 void EffectManager::CheckEffectCompletion() {
     // Remove completed effects
-    m_activeEffects.erase(
-        std::remove_if(m_activeEffects.begin(), m_activeEffects.end(),
-            [](const std::unique_ptr<EffectBase>& effect) {
-                return !effect || !effect->IsActive();
-            }),
-        m_activeEffects.end()
-    );
+    auto completed = std::remove_if(m_activeEffects.begin(), m_activeEffects.end(),
+        [](const std::unique_ptr<EffectBase>& effect) {
+            return !effect || !effect->IsActive();
+        });
+    g_metrics.effectsCompleted.fetch_add(static_cast<uint64_t>(m_activeEffects.end() - completed),
+                                         std::memory_order_relaxed);
+    m_activeEffects.erase(completed, m_activeEffects.end());
+    PublishActiveEffects();
+}
+
+void EffectManager::PublishActiveEffects() {
+    std::array<uint32_t, PluginMetrics::EFFECT_TYPE_COUNT> counts{};
+    for (const auto& effect : m_activeEffects) {
+        size_t index = static_cast<size_t>(effect->GetType());
+        if (index < counts.size()) {
+            counts[index]++;
+        }
+    }
+    for (size_t i = 0; i < counts.size(); i++) {
+        g_metrics.activeEffects[i].store(counts[i], std::memory_order_relaxed);
+    }
 }
@@ -36,6 +36,7 @@ public:
     virtual void Start() = 0;
     virtual void Stop() = 0;
     virtual void Update(double elapsed) = 0;
+    virtual EffectType GetType() const = 0;
 
     bool IsActive() const { return m_isActive; }
     double GetDuration() const { return m_duration; }
@@ -47,6 +48,8 @@ protected:
     double m_elapsedTime;   // Elapsed time in seconds
     bool m_isActive;
     QTimer* m_timer;
+    float m_canvasWidth;    // Base canvas resolution at effect creation
+    float m_canvasHeight;
 
 protected slots:
     virtual void OnTimerTick();
@@ -63,6 +66,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::Rotation; }
 
 private:
     double m_rotationsPerSecond;
@@ -83,6 +87,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::Blink; }
 
 private:
     double m_blinkFrequency;
@@ -99,6 +104,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::HueShift; }
 
 private:
     double m_shiftSpeed;      // Degrees per second
@@ -116,6 +122,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::Shake; }
 
 private:
     double m_intensity;
@@ -133,6 +140,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::Kaleidoscope; }
 
 private:
     int m_segments;
@@ -152,6 +160,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::Rotation3D; }
 
 private:
     bool m_rotateX;
@@ -173,6 +182,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::RandomShapes; }
 
 private:
     struct Shape {
@@ -202,6 +212,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::ParticleSystem; }
 
 private:
     struct Particle {
@@ -256,6 +267,7 @@ public:
     void Start() override;
     void Stop() override;
     void Update(double elapsed) override;
+    EffectType GetType() const override { return EffectType::ProgressBar; }
 
     void SetProgress(double progress);
 
@@ -296,6 +308,9 @@ public:
     int GetActiveEffectCount() const { return static_cast<int>(m_activeEffects.size()); }
 
 private:
+    // Publishes the active effect count per type to g_metrics
+    void PublishActiveEffects();
+
     std::vector<std::unique_ptr<EffectBase>> m_activeEffects;
     std::mt19937 m_randomEngine;
 
@@ -0,0 +1,61 @@
+#include "free-chat-sampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+FreeChatSampler::FreeChatSampler(double maxPerSecond)
+    : m_maxPerSecond(0.0)
+    , m_rate(0.0)
+    , m_tokens(0.0)
+    , m_lastBatchNs(0)
+    , m_randomEngine(std::random_device{}())
+{
+    SetMaxPerSecond(maxPerSecond);
+}
+
+void FreeChatSampler::SetMaxPerSecond(double maxPerSecond) {
+    m_maxPerSecond = std::max(0.0, maxPerSecond);
+    m_tokens = Carry();
+}
+
+double FreeChatSampler::GetSampleProbability() const {
+    if (m_maxPerSecond <= 0.0 || m_rate <= m_maxPerSecond) return 1.0;
+    return m_maxPerSecond / m_rate;
+}
+
+void FreeChatSampler::SampleBatch(size_t count, uint64_t nowNs, std::vector<bool>& keep) {
+    double elapsed = m_lastBatchNs != 0 && nowNs > m_lastBatchNs ? (nowNs - m_lastBatchNs) / 1e9 : 0.0;
+    elapsed = std::min(elapsed, MAX_BATCH_GAP_S);
+    m_lastBatchNs = nowNs;
+
+    // Each batch's own rate (count over the gap it covers), exponentially averaged over time
+    if (elapsed > 0.0) {
+        double decay = std::exp(-elapsed / RATE_TIME_CONSTANT_S);
+        m_rate = m_rate * decay + (1.0 - decay) * count / elapsed;
+    } else {
+        m_rate += count / RATE_TIME_CONSTANT_S;
+    }
+
+    keep.assign(count, true);
+    if (m_maxPerSecond <= 0.0) return;
+
+    double earned = elapsed * m_maxPerSecond;
+    m_tokens = std::min(m_tokens, Carry()) + earned;
+
+    size_t budget = static_cast<size_t>(m_tokens);
+    if (count <= budget) {
+        m_tokens -= count;
+        return;
+    }
+
+    // Partial Fisher-Yates: the first `budget` entries of the shuffled order are a uniform subset
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), size_t{0});
+    keep.assign(count, false);
+    for (size_t i = 0; i < budget; i++) {
+        std::uniform_int_distribution<size_t> pick(i, count - 1);
+        std::swap(m_order[i], m_order[pick(m_randomEngine)]);
+        keep[m_order[i]] = true;
+    }
+    m_tokens -= budget;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#define DEFAULT_FREE_CHAT_SAMPLES_PER_SECOND 2    // Regular chat messages that may trigger effects
+
+// Thins regular chat to at most K events per second.
+//
+// Chat arrives a page at a time, so messages are sampled per batch (everything that arrived
+// together): the batch earns K tokens per second since the previous batch, and when it holds
+// more messages than tokens a uniformly random subset of that size is kept. Every position in
+// a page has the same chance, a quiet chat passes untouched, and a flood yields K per second.
+// Tokens left over carry at most one second's worth, so a quiet spell does not bank a burst.
+// The arrival rate (each batch's size over the gap before it, exponentially averaged with
+// time constant RATE_TIME_CONSTANT_S) is reported for metrics only.
+class FreeChatSampler {
+public:
+    static constexpr double RATE_TIME_CONSTANT_S = 2.0;
+    // A longer gap earns no more tokens, so one page after a long stall stays bounded
+    static constexpr double MAX_BATCH_GAP_S = 30.0;
+
+    explicit FreeChatSampler(double maxPerSecond = DEFAULT_FREE_CHAT_SAMPLES_PER_SECOND);
+
+    // 0 disables sampling: every message is kept
+    void SetMaxPerSecond(double maxPerSecond);
+
+    // Sets keep[i] for the messages of a count-message batch that are kept
+    void SampleBatch(size_t count, uint64_t nowNs, std::vector<bool>& keep);
+
+    double GetArrivalRate() const { return m_rate; }
+    double GetSampleProbability() const;
+
+private:
+    double Carry() const { return std::max(1.0, m_maxPerSecond); }
+
+    double m_maxPerSecond;
+    double m_rate;              // Estimated messages per second
+    double m_tokens;
+    uint64_t m_lastBatchNs;     // 0 = no batch yet
+    std::mt19937_64 m_randomEngine;
+    std::vector<size_t> m_order;    // Scratch for the partial shuffle
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Open-addressing core shared by the fixed-size ID tables (RecentIdSet, ViewerRateLimiter).
+// Keys are 64-bit fingerprints, 0 marks an empty slot, collisions probe linearly and
+// deletions shift the rest of the probe chain back, so there are no tombstones.
+
+// FNV-1a followed by a 64-bit finalizer so the low bits are well mixed; never 0
+inline uint64_t IdFingerprint(std::string_view id) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : id) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash != 0 ? hash : 1;
+}
+
+// Power-of-two table at least twice the capacity keeps probe chains short
+inline size_t IdTableSize(size_t capacity) {
+    size_t tableSize = 1;
+    while (tableSize < capacity * 2) {
+        tableSize <<= 1;
+    }
+    return tableSize;
+}
+
+// Slot holding key, or the empty slot where it would go. keyOf(entry) returns an entry's key.
+template <typename Entry, typename KeyOf>
+size_t IdTableFind(const std::vector<Entry>& table, size_t mask, uint64_t key, KeyOf keyOf) {
+    size_t slot = static_cast<size_t>(key) & mask;
+    while (keyOf(table[slot]) != 0 && keyOf(table[slot]) != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Removes the entry at slot by backward-shift deletion: later entries of the probe chain are
+// pulled into the hole. Returns the slot left over at the end, for the caller to mark empty.
+template <typename Entry, typename KeyOf>
+size_t IdTableErase(std::vector<Entry>& table, size_t mask, size_t slot, KeyOf keyOf) {
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+    while (keyOf(table[next]) != 0) {
+        size_t home = static_cast<size_t>(keyOf(table[next])) & mask;
+        // Move the entry if its home is not cyclically within (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    return hole;
+}
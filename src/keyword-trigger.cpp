@@ -0,0 +1,175 @@
+#include "keyword-trigger.hpp"
+#include <util/base.h>
+#include <algorithm>
+#include <utility>
+
+KeywordTriggerEngine::KeywordTriggerEngine()
+    : m_firstEdge{0, 0}
+    , m_fail{0}
+    , m_outputLink{-1}
+    , m_firstOutput{0, 0}
+    , m_patternCount(0)
+{
+    m_rootNext.fill(0);
+}
+
+std::string KeywordTriggerEngine::Normalize(std::string_view text) {
+    bool ascii = std::all_of(text.begin(), text.end(), [](char c) { return static_cast<uint8_t>(c) < 0x80; });
+    if (!ascii) {
+        return Normalize(QString::fromUtf8(text.data(), static_cast<int>(text.size())));
+    }
+
+    // NFKC leaves ASCII unchanged and case folding is plain lowercasing
+    std::string result(text);
+    for (char& c : result) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return result;
+}
+
+std::string KeywordTriggerEngine::Normalize(const QString& text) {
+    return text.normalized(QString::NormalizationForm_KC).toCaseFolded().toStdString();
+}
+
+void KeywordTriggerEngine::Compile(const EffectConfigList& configs) {
+    // Build a trie with per-node sorted child lists, then flatten it
+    std::vector<std::vector<std::pair<uint8_t, int32_t>>> children(1);
+    std::vector<std::vector<uint32_t>> outputs(1);
+    std::vector<EffectSettings> keywordConfigs;
+    size_t patternCount = 0;
+
+    for (const EffectSettings& config : configs.GetAllConfigs()) {
+        if (config.keywords.isEmpty()) continue;
+
+        uint32_t configIndex = static_cast<uint32_t>(keywordConfigs.size());
+        keywordConfigs.push_back(config);
+
+        for (const QString& keyword : config.keywords) {
+            std::string pattern = Normalize(keyword.trimmed());
+            if (pattern.empty()) continue;
+
+            int32_t state = 0;
+            for (char c : pattern) {
+                uint8_t byte = static_cast<uint8_t>(c);
+                auto& edges = children[state];
+                auto it = std::lower_bound(edges.begin(), edges.end(), byte,
+                                           [](const std::pair<uint8_t, int32_t>& edge, uint8_t b) { return edge.first < b; });
+                if (it != edges.end() && it->first == byte) {
+                    state = it->second;
+                    continue;
+                }
+                int32_t child = static_cast<int32_t>(children.size());
+                edges.insert(it, {byte, child});
+                children.emplace_back();
+                outputs.emplace_back();
+                state = child;
+            }
+
+            std::vector<uint32_t>& ending = outputs[state];
+            if (std::find(ending.begin(), ending.end(), configIndex) == ending.end()) {
+                ending.push_back(configIndex);
+                patternCount++;
+            }
+        }
+    }
+
+    size_t stateCount = children.size();
+    m_firstEdge.assign(stateCount + 1, 0);
+    m_edgeBytes.clear();
+    m_edgeTargets.clear();
+    m_firstOutput.assign(stateCount + 1, 0);
+    m_outputs.clear();
+    for (size_t state = 0; state < stateCount; state++) {
+        m_firstEdge[state] = static_cast<uint32_t>(m_edgeBytes.size());
+        for (const auto& edge : children[state]) {
+            m_edgeBytes.push_back(edge.first);
+            m_edgeTargets.push_back(edge.second);
+        }
+        m_firstOutput[state] = static_cast<uint32_t>(m_outputs.size());
+        m_outputs.insert(m_outputs.end(), outputs[state].begin(), outputs[state].end());
+    }
+    m_firstEdge[stateCount] = static_cast<uint32_t>(m_edgeBytes.size());
+    m_firstOutput[stateCount] = static_cast<uint32_t>(m_outputs.size());
+
+    m_rootNext.fill(0);
+    for (const auto& edge : children[0]) {
+        m_rootNext[edge.first] = edge.second;
+    }
+
+    // Failure and output links in breadth-first order, so every link points to a finished state
+    m_fail.assign(stateCount, 0);
+    m_outputLink.assign(stateCount, -1);
+    std::vector<int32_t> queue;
+    queue.reserve(stateCount);
+    for (const auto& edge : children[0]) {
+        queue.push_back(edge.second);
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        int32_t state = queue[head];
+        for (uint32_t e = m_firstEdge[state]; e < m_firstEdge[state + 1]; e++) {
+            int32_t child = m_edgeTargets[e];
+            int32_t fail = Next(m_fail[state], m_edgeBytes[e]);
+            m_fail[child] = fail;
+            m_outputLink[child] = m_firstOutput[fail] != m_firstOutput[fail + 1] ? fail : m_outputLink[fail];
+            queue.push_back(child);
+        }
+    }
+
+    m_configs = std::move(keywordConfigs);
+    m_patternCount = patternCount;
+
+    blog(LOG_INFO, "[Keywords] Compiled %zu keywords from %zu configurations (%zu states, %zu KB)",
+         m_patternCount, m_configs.size(), stateCount, MemoryBytes() / 1024);
+}
+
+int32_t KeywordTriggerEngine::Next(int32_t state, uint8_t byte) const {
+    while (state != 0) {
+        auto begin = m_edgeBytes.begin() + m_firstEdge[state];
+        auto end = m_edgeBytes.begin() + m_firstEdge[state + 1];
+        auto it = std::lower_bound(begin, end, byte);
+        if (it != end && *it == byte) {
+            return m_edgeTargets[it - m_edgeBytes.begin()];
+        }
+        state = m_fail[state];
+    }
+    return m_rootNext[byte];
+}
+
+std::vector<EffectSettings> KeywordTriggerEngine::Match(std::string_view text) const {
+    std::vector<EffectSettings> result;
+    if (m_patternCount == 0) return result;
+
+    std::string normalized = Normalize(text);
+    std::array<uint32_t, MAX_EFFECTS_PER_MESSAGE> matched;
+    size_t matchedCount = 0;
+
+    int32_t state = 0;
+    for (char c : normalized) {
+        state = Next(state, static_cast<uint8_t>(c));
+
+        int32_t hit = m_firstOutput[state] != m_firstOutput[state + 1] ? state : m_outputLink[state];
+        for (; hit >= 0; hit = m_outputLink[hit]) {
+            for (uint32_t o = m_firstOutput[hit]; o < m_firstOutput[hit + 1]; o++) {
+                uint32_t configIndex = m_outputs[o];
+                if (std::find(matched.begin(), matched.begin() + matchedCount, configIndex) != matched.begin() + matchedCount) {
+                    continue;
+                }
+                matched[matchedCount++] = configIndex;
+                result.push_back(m_configs[configIndex]);
+                if (matchedCount == MAX_EFFECTS_PER_MESSAGE) return result;
+            }
+        }
+    }
+    return result;
+}
+
+size_t KeywordTriggerEngine::MemoryBytes() const {
+    return sizeof(m_rootNext)
+        + m_firstEdge.capacity() * sizeof(uint32_t)
+        + m_edgeBytes.capacity() * sizeof(uint8_t)
+        + m_edgeTargets.capacity() * sizeof(int32_t)
+        + m_fail.capacity() * sizeof(int32_t)
+        + m_outputLink.capacity() * sizeof(int32_t)
+        + m_firstOutput.capacity() * sizeof(uint32_t)
+        + m_outputs.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "effect-config.hpp"
+#include <QString>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Matches chat text against the keywords of every effect configuration in one pass.
+//
+// Keywords are normalized (NFKC, then case-folded, so full-width "！ＳＨＡＫＥ" and half-width
+// katakana match their ordinary forms) and compiled into an Aho-Corasick automaton over
+// the UTF-8 bytes. A message is normalized the same way and scanned once: the cost is
+// linear in the message length plus the number of hits, independent of how many keywords
+// are configured. Transitions are stored as sorted per-state edge lists with a dense
+// table for the root, which most bytes of a non-matching message fall back to.
+//
+// Matches are substring matches. Not thread-safe: compile and match on the UI thread.
+class KeywordTriggerEngine {
+public:
+    // Distinct configurations one message can trigger
+    static constexpr size_t MAX_EFFECTS_PER_MESSAGE = 3;
+
+    KeywordTriggerEngine();
+
+    // Replaces the automaton with the keywords of every configuration in the list
+    void Compile(const EffectConfigList& configs);
+
+    // Configurations whose keywords occur in the text, in order of first occurrence
+    std::vector<EffectSettings> Match(std::string_view text) const;
+
+    bool IsEmpty() const { return m_patternCount == 0; }
+    size_t GetPatternCount() const { return m_patternCount; }
+    size_t GetStateCount() const { return m_fail.size(); }
+    size_t MemoryBytes() const;
+
+    // NFKC + case folding, as UTF-8; ASCII-only text takes a fast path
+    static std::string Normalize(std::string_view text);
+    static std::string Normalize(const QString& text);
+
+private:
+    int32_t Next(int32_t state, uint8_t byte) const;
+
+    std::vector<EffectSettings> m_configs;  // Only configurations with keywords
+
+    // State 0 is the root. Edges of state s: m_edgeBytes/m_edgeTargets[m_firstEdge[s] .. m_firstEdge[s + 1])
+    std::array<int32_t, 256> m_rootNext;
+    std::vector<uint32_t> m_firstEdge;
+    std::vector<uint8_t> m_edgeBytes;       // Sorted within a state
+    std::vector<int32_t> m_edgeTargets;
+    std::vector<int32_t> m_fail;
+    std::vector<int32_t> m_outputLink;      // Nearest state on the failure chain with outputs; -1 = none
+
+    // Config indices of keywords ending at state s: m_outputs[m_firstOutput[s] .. m_firstOutput[s + 1])
+    std::vector<uint32_t> m_firstOutput;
+    std::vector<uint32_t> m_outputs;
+
+    size_t m_patternCount;
+};
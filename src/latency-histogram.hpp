@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// Log-linear histogram of nanosecond durations (HDR histogram layout).
+// Values below 32 are exact; above that every power of two is split into 32 buckets,
+// so any recorded value is reported within ~3%. Fixed size, no allocation, single writer.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static const size_t BUCKET_COUNT = (65 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    LatencyHistogram() { Reset(); }
+
+    void Reset() {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_sum = 0;
+        m_min = std::numeric_limits<uint64_t>::max();
+        m_max = 0;
+    }
+
+    void Record(uint64_t value) {
+        m_buckets[BucketIndex(value)]++;
+        m_count++;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    uint64_t GetCount() const { return m_count; }
+    uint64_t GetMin() const { return m_count ? m_min : 0; }
+    uint64_t GetMax() const { return m_max; }
+    double GetMean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+    // percentile in [0, 100]; returns the highest value equivalent to the bucket it falls in
+    uint64_t GetPercentile(double percentile) const {
+        if (m_count == 0) return 0;
+
+        double clamped = std::min(std::max(percentile, 0.0), 100.0);
+        uint64_t rank = static_cast<uint64_t>(clamped / 100.0 * m_count + 0.5);
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                return std::min(BucketUpperBound(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+private:
+    static size_t BucketIndex(uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+
+        int magnitude = 63;
+        while (!(value >> magnitude)) magnitude--;
+        int shift = magnitude - SUB_BUCKET_BITS;
+        return static_cast<size_t>(SUB_BUCKETS + shift * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS));
+    }
+
+    static uint64_t BucketUpperBound(size_t index) {
+        if (index < SUB_BUCKETS) return index;
+
+        uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        uint64_t mantissa = SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    std::array<uint64_t, BUCKET_COUNT> m_buckets;
+    uint64_t m_count;
+    uint64_t m_sum;
+    uint64_t m_min;
+    uint64_t m_max;
+};
@@ -0,0 +1,210 @@
+#include "metrics-dock.hpp"
+#include <util/platform.h>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QTimer>
+#include <QVBoxLayout>
+
+static const int REFRESH_INTERVAL_MS = 1000;
+
+// Indexed by EffectType
+static const char* EFFECT_TYPE_NAMES[PluginMetrics::EFFECT_TYPE_COUNT] = {
+    "Rotation", "Blink", "Hue shift", "Shake", "Kaleidoscope",
+    "3D rotation", "Custom shader", "Random shapes", "Particles", "Progress bar"
+};
+
+static uint64_t Load(const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+}
+
+static QString FormatBytes(double bytes) {
+    if (bytes >= 1024.0 * 1024.0) return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+    if (bytes >= 1024.0) return QString::number(bytes / 1024.0, 'f', 1) + " KB";
+    return QString::number(bytes, 'f', 0) + " B";
+}
+
+MetricsDock::MetricsDock(QWidget* parent)
+    : QWidget(parent)
+    , m_timer(new QTimer(this))
+{
+    SetupUI();
+
+    connect(m_timer, &QTimer::timeout, this, &MetricsDock::Refresh);
+    m_timer->start(REFRESH_INTERVAL_MS);
+    Refresh();
+}
+
+void MetricsDock::SetupUI() {
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+
+    QGroupBox* effectGroup = new QGroupBox("Active Effects");
+    QFormLayout* effectLayout = new QFormLayout();
+    for (size_t i = 0; i < m_effectLabels.size(); i++) {
+        m_effectLabels[i] = new QLabel();
+        effectLayout->addRow(EFFECT_TYPE_NAMES[i], m_effectLabels[i]);
+    }
+    m_tickCostLabel = new QLabel();
+    effectLayout->addRow("Tick cost (avg / max):", m_tickCostLabel);
+    effectGroup->setLayout(effectLayout);
+    mainLayout->addWidget(effectGroup);
+
+    QGroupBox* sourceGroup = new QGroupBox("OBS Objects");
+    QFormLayout* sourceLayout = new QFormLayout();
+    m_overlaySourcesLabel = new QLabel();
+    sourceLayout->addRow("Overlay sources:", m_overlaySourcesLabel);
+    m_sceneItemsLabel = new QLabel();
+    sourceLayout->addRow("Plugin scene items:", m_sceneItemsLabel);
+    sourceGroup->setLayout(sourceLayout);
+    mainLayout->addWidget(sourceGroup);
+
+    QGroupBox* pipelineGroup = new QGroupBox("Donation Pipeline");
+    QFormLayout* pipelineLayout = new QFormLayout();
+    m_queueDepthLabel = new QLabel();
+    pipelineLayout->addRow("Queue depth:", m_queueDepthLabel);
+    m_droppedLabel = new QLabel();
+    pipelineLayout->addRow("Dropped (injected):", m_droppedLabel);
+    m_coalescedLabel = new QLabel();
+    pipelineLayout->addRow("Coalesced duplicates:", m_coalescedLabel);
+    m_viewerLimitedLabel = new QLabel();
+    pipelineLayout->addRow("Limited per viewer:", m_viewerLimitedLabel);
+    m_freeChatSampledLabel = new QLabel();
+    pipelineLayout->addRow("Free chat sampled out:", m_freeChatSampledLabel);
+    pipelineGroup->setLayout(pipelineLayout);
+    mainLayout->addWidget(pipelineGroup);
+
+    QGroupBox* pollGroup = new QGroupBox("Chat Polling");
+    QFormLayout* pollLayout = new QFormLayout();
+    m_pollLatencyLabel = new QLabel();
+    pollLayout->addRow("Latency (last / avg):", m_pollLatencyLabel);
+    m_pollBytesLabel = new QLabel();
+    pollLayout->addRow("Bytes/s (decoded):", m_pollBytesLabel);
+    m_pollIntervalLabel = new QLabel();
+    pollLayout->addRow("Next poll in:", m_pollIntervalLabel);
+    pollGroup->setLayout(pollLayout);
+    mainLayout->addWidget(pollGroup);
+
+    QGroupBox* chatSourceGroup = new QGroupBox("Chat Sources");
+    QFormLayout* chatSourceLayout = new QFormLayout();
+    for (size_t i = 0; i < m_sourceLabels.size(); i++) {
+        m_sourceNameLabels[i] = new QLabel();
+        m_sourceLabels[i] = new QLabel();
+        chatSourceLayout->addRow(m_sourceNameLabels[i], m_sourceLabels[i]);
+    }
+    chatSourceGroup->setLayout(chatSourceLayout);
+    mainLayout->addWidget(chatSourceGroup);
+
+    QGroupBox* cacheGroup = new QGroupBox("Caches");
+    QFormLayout* cacheLayout = new QFormLayout();
+    m_dedupeHitRateLabel = new QLabel();
+    cacheLayout->addRow("Message ID dedupe hits:", m_dedupeHitRateLabel);
+    cacheGroup->setLayout(cacheLayout);
+    mainLayout->addWidget(cacheGroup);
+
+    mainLayout->addStretch();
+}
+
+void MetricsDock::Refresh() {
+    Snapshot current;
+    current.timeNs = os_gettime_ns();
+    current.effectTicks = Load(g_metrics.effectTicks);
+    current.effectTickTimeNs = Load(g_metrics.effectTickTimeNs);
+    current.pollsCompleted = Load(g_metrics.pollsCompleted);
+    current.pollLatencyNs = Load(g_metrics.pollLatencyNs);
+    current.chatBytesParsed = Load(g_metrics.chatBytesParsed);
+    current.chatMessagesParsed = Load(g_metrics.chatMessagesParsed);
+    current.chatDuplicatesSuppressed = Load(g_metrics.chatDuplicatesSuppressed);
+    current.injectedEventsDropped = Load(g_metrics.injectedEventsDropped);
+    current.viewerLimiterSuppressed = Load(g_metrics.viewerLimiterSuppressed);
+    current.freeChatSampledOut = Load(g_metrics.freeChatSampledOut);
+    for (size_t i = 0; i < current.sourceEvents.size(); i++) {
+        current.sourceEvents[i] = Load(g_metrics.sources[i].eventsDispatched);
+    }
+
+    double seconds = m_previous.timeNs != 0 ? (current.timeNs - m_previous.timeNs) / 1e9 : 0.0;
+
+    for (size_t i = 0; i < m_effectLabels.size(); i++) {
+        m_effectLabels[i]->setText(QString::number(g_metrics.activeEffects[i].load(std::memory_order_relaxed)));
+    }
+
+    uint64_t ticks = current.effectTicks - m_previous.effectTicks;
+    uint64_t tickMaxNs = g_metrics.TakeEffectTickMax();
+    if (ticks > 0) {
+        double avgUs = (current.effectTickTimeNs - m_previous.effectTickTimeNs) / 1000.0 / ticks;
+        m_tickCostLabel->setText(QString("%1 / %2 us (%3 ticks)")
+                                     .arg(avgUs, 0, 'f', 1)
+                                     .arg(tickMaxNs / 1000.0, 0, 'f', 1)
+                                     .arg(ticks));
+    } else {
+        m_tickCostLabel->setText("idle");
+    }
+
+    m_overlaySourcesLabel->setText(QString::number(Load(g_metrics.overlaySources)));
+    m_sceneItemsLabel->setText(QString::number(Load(g_metrics.ownedSceneItems)));
+
+    m_queueDepthLabel->setText(QString::number(Load(g_metrics.hubQueueDepth)));
+    m_droppedLabel->setText(QString("%1 (+%2)")
+                                .arg(current.injectedEventsDropped)
+                                .arg(current.injectedEventsDropped - m_previous.injectedEventsDropped));
+    m_coalescedLabel->setText(QString("%1 (+%2)")
+                                  .arg(current.chatDuplicatesSuppressed)
+                                  .arg(current.chatDuplicatesSuppressed - m_previous.chatDuplicatesSuppressed));
+    m_viewerLimitedLabel->setText(QString("%1 (+%2, %3 viewers)")
+                                      .arg(current.viewerLimiterSuppressed)
+                                      .arg(current.viewerLimiterSuppressed - m_previous.viewerLimiterSuppressed)
+                                      .arg(Load(g_metrics.viewerLimiterEntries)));
+    m_freeChatSampledLabel->setText(QString("%1 (+%2, %3/s, keep %4%)")
+                                        .arg(current.freeChatSampledOut)
+                                        .arg(current.freeChatSampledOut - m_previous.freeChatSampledOut)
+                                        .arg(Load(g_metrics.freeChatRateMilli) / 1000.0, 0, 'f', 1)
+                                        .arg(Load(g_metrics.freeChatSampleProbabilityMilli) / 10.0, 0, 'f', 0));
+
+    if (current.pollsCompleted > 0) {
+        m_pollLatencyLabel->setText(QString("%1 / %2 ms")
+                                        .arg(Load(g_metrics.lastPollLatencyNs) / 1e6, 0, 'f', 0)
+                                        .arg(current.pollLatencyNs / 1e6 / current.pollsCompleted, 0, 'f', 0));
+    } else {
+        m_pollLatencyLabel->setText("-");
+    }
+    if (seconds > 0.0) {
+        m_pollBytesLabel->setText(FormatBytes((current.chatBytesParsed - m_previous.chatBytesParsed) / seconds));
+    }
+    m_pollIntervalLabel->setText(QString("%1 ms").arg(Load(g_metrics.pollIntervalMs)));
+
+    for (size_t i = 0; i < m_sourceLabels.size(); i++) {
+        char videoId[PluginMetrics::SOURCE_ID_BYTES + 1];
+        bool used = g_metrics.GetSourceId(i, videoId);
+        m_sourceNameLabels[i]->setVisible(used);
+        m_sourceLabels[i]->setVisible(used);
+        if (!used) continue;
+
+        const PluginMetrics::SourceMetrics& source = g_metrics.sources[i];
+        // The slot may have been handed to another chat since the previous refresh
+        uint64_t events = current.sourceEvents[i];
+        uint64_t newEvents = events >= m_previous.sourceEvents[i] ? events - m_previous.sourceEvents[i] : events;
+        m_sourceNameLabels[i]->setText(QString::fromLatin1(videoId) + ":");
+        if (Load(source.running) == 0) {
+            m_sourceLabels[i]->setText(QString("stopped, %1 events").arg(events));
+            continue;
+        }
+        m_sourceLabels[i]->setText(QString("%1 pages, %2 events (+%3), %4 dup, %5 failures, every %6 ms")
+                                       .arg(Load(source.pagesReceived))
+                                       .arg(events)
+                                       .arg(newEvents)
+                                       .arg(Load(source.duplicatesSuppressed))
+                                       .arg(Load(source.requestFailures))
+                                       .arg(Load(source.pollIntervalMs)));
+    }
+
+    uint64_t messages = current.chatMessagesParsed - m_previous.chatMessagesParsed;
+    if (messages > 0) {
+        double recent = static_cast<double>(current.chatDuplicatesSuppressed - m_previous.chatDuplicatesSuppressed) / messages;
+        m_dedupeHitRateLabel->setText(QString("%1% (session %2%)")
+                                          .arg(recent * 100.0, 0, 'f', 1)
+                                          .arg(g_metrics.GetDedupeHitRate() * 100.0, 0, 'f', 1));
+    } else {
+        m_dedupeHitRateLabel->setText(QString("session %1%").arg(g_metrics.GetDedupeHitRate() * 100.0, 0, 'f', 1));
+    }
+
+    m_previous = current;
+}
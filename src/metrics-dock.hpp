@@ -0,0 +1,64 @@
+#pragma once
+
+#include "plugin-metrics.hpp"
+#include <QWidget>
+#include <array>
+#include <cstdint>
+
+class QLabel;
+class QTimer;
+
+// Live view of g_metrics, docked into the OBS main window (View > Docks > SuperChat Metrics).
+// Refreshes once per second from the lock-free counters only: it never takes a lock or
+// touches the subsystems, so showing it adds nothing to the polling, dispatch or effect paths.
+// Rates and averages are deltas since the previous refresh.
+class MetricsDock : public QWidget {
+    Q_OBJECT
+
+public:
+    static constexpr const char* DOCK_ID = "youtube-superchat-metrics";
+
+    explicit MetricsDock(QWidget* parent = nullptr);
+
+private slots:
+    void Refresh();
+
+private:
+    void SetupUI();
+
+    // Counter values at the previous refresh
+    struct Snapshot {
+        uint64_t timeNs = 0;
+        uint64_t effectTicks = 0;
+        uint64_t effectTickTimeNs = 0;
+        uint64_t pollsCompleted = 0;
+        uint64_t pollLatencyNs = 0;
+        uint64_t chatBytesParsed = 0;
+        uint64_t chatMessagesParsed = 0;
+        uint64_t chatDuplicatesSuppressed = 0;
+        uint64_t injectedEventsDropped = 0;
+        uint64_t viewerLimiterSuppressed = 0;
+        uint64_t freeChatSampledOut = 0;
+        std::array<uint64_t, PluginMetrics::MAX_SOURCE_SLOTS> sourceEvents{};
+    };
+
+    QTimer* m_timer;
+    Snapshot m_previous;
+
+    std::array<QLabel*, PluginMetrics::EFFECT_TYPE_COUNT> m_effectLabels;
+    QLabel* m_tickCostLabel;
+    QLabel* m_overlaySourcesLabel;
+    QLabel* m_sceneItemsLabel;
+    QLabel* m_queueDepthLabel;
+    QLabel* m_droppedLabel;
+    QLabel* m_coalescedLabel;
+    QLabel* m_viewerLimitedLabel;
+    QLabel* m_freeChatSampledLabel;
+    QLabel* m_pollLatencyLabel;
+    QLabel* m_pollBytesLabel;
+    QLabel* m_pollIntervalLabel;
+    // One row per chat slot, hidden while the slot is unused
+    std::array<QLabel*, PluginMetrics::MAX_SOURCE_SLOTS> m_sourceNameLabels;
+    std::array<QLabel*, PluginMetrics::MAX_SOURCE_SLOTS> m_sourceLabels;
+    QLabel* m_dedupeHitRateLabel;
+};
@@ -0,0 +1,310 @@
+#include "metrics-exporter.hpp"
+#include "plugin-metrics.hpp"
+#include <obs-module.h>
+#include <util/base.h>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <algorithm>
+#include <cstdio>
+
+// Anything larger is not a scrape
+static const int MAX_REQUEST_BYTES = 8 * 1024;
+
+// Label values, indexed by EffectType and DonationType
+static const char* EFFECT_TYPE_LABELS[PluginMetrics::EFFECT_TYPE_COUNT] = {
+    "rotation", "blink", "hue_shift", "shake", "kaleidoscope",
+    "rotation_3d", "custom_shader", "random_shapes", "particle_system", "progress_bar"
+};
+static const char* DONATION_TYPE_LABELS[PluginMetrics::DONATION_TYPE_COUNT] = {"superchat", "supersticker", "chat"};
+
+namespace {
+
+class PrometheusWriter {
+public:
+    void Header(const char* name, const char* type, const char* help) {
+        Append("# HELP obs_superchat_%s %s\n", name, help);
+        Append("# TYPE obs_superchat_%s %s\n", name, type);
+    }
+
+    void Value(const char* name, uint64_t value) {
+        Append("obs_superchat_%s %llu\n", name, static_cast<unsigned long long>(value));
+    }
+
+    void Value(const char* name, const char* labels, uint64_t value) {
+        Append("obs_superchat_%s{%s} %llu\n", name, labels, static_cast<unsigned long long>(value));
+    }
+
+    void Value(const char* name, double value) {
+        Append("obs_superchat_%s %.9g\n", name, value);
+    }
+
+    void Value(const char* name, const char* labels, double value) {
+        Append("obs_superchat_%s{%s} %.9g\n", name, labels, value);
+    }
+
+    void Counter(const char* name, const char* help, const std::atomic<uint64_t>& counter) {
+        Header(name, "counter", help);
+        Value(name, counter.load(std::memory_order_relaxed));
+    }
+
+    void Gauge(const char* name, const char* help, const std::atomic<uint64_t>& gauge) {
+        Header(name, "gauge", help);
+        Value(name, gauge.load(std::memory_order_relaxed));
+    }
+
+    // Buckets are recorded in nanoseconds and exported in seconds
+    template <size_t N>
+    void HistogramSeconds(const char* name, const char* help, const AtomicHistogram<N>& histogram) {
+        Header(name, "histogram", help);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i <= N; i++) {
+            cumulative += histogram.buckets[i].load(std::memory_order_relaxed);
+            if (i < N) {
+                Append("obs_superchat_%s_bucket{le=\"%.9g\"} %llu\n", name, histogram.bounds[i] / 1e9,
+                       static_cast<unsigned long long>(cumulative));
+            } else {
+                Append("obs_superchat_%s_bucket{le=\"+Inf\"} %llu\n", name,
+                       static_cast<unsigned long long>(cumulative));
+            }
+        }
+        Append("obs_superchat_%s_sum %.9g\n", name, histogram.sum.load(std::memory_order_relaxed) / 1e9);
+        Append("obs_superchat_%s_count %llu\n", name, static_cast<unsigned long long>(cumulative));
+    }
+
+    std::string Take() { return std::move(m_text); }
+
+private:
+    template <typename... Args>
+    void Append(const char* format, Args... args) {
+        char line[256];
+        int length = std::snprintf(line, sizeof(line), format, args...);
+        if (length > 0) {
+            m_text.append(line, std::min(static_cast<size_t>(length), sizeof(line) - 1));
+        }
+    }
+
+    std::string m_text;
+};
+
+}
+
+std::string FormatPrometheusMetrics() {
+    PrometheusWriter out;
+    char labels[96];
+
+    out.Header("donations_total", "counter", "Donations dispatched to the effect pipeline");
+    for (const PluginMetrics::CurrencyDonations& slot : g_metrics.donations) {
+        uint32_t code = slot.code.load(std::memory_order_acquire);
+        if (code == 0) continue;
+        char currency[4] = {static_cast<char>(code >> 16), static_cast<char>(code >> 8), static_cast<char>(code), '\0'};
+        for (size_t type = 0; type < PluginMetrics::DONATION_TYPE_COUNT; type++) {
+            std::snprintf(labels, sizeof(labels), "type=\"%s\",currency=\"%s\"", DONATION_TYPE_LABELS[type], currency);
+            out.Value("donations_total", labels, slot.count[type].load(std::memory_order_relaxed));
+        }
+    }
+
+    out.Counter("effects_started_total", "Visual effects started", g_metrics.effectsStarted);
+    out.Counter("effects_completed_total", "Visual effects finished or cleared", g_metrics.effectsCompleted);
+    out.Header("effects_active", "gauge", "Visual effects currently running");
+    for (size_t i = 0; i < PluginMetrics::EFFECT_TYPE_COUNT; i++) {
+        std::snprintf(labels, sizeof(labels), "type=\"%s\"", EFFECT_TYPE_LABELS[i]);
+        out.Value("effects_active", labels, g_metrics.activeEffects[i].load(std::memory_order_relaxed));
+    }
+    out.HistogramSeconds("effect_tick_seconds", "Duration of one effect animation tick", g_metrics.effectTickHistogramNs);
+
+    out.HistogramSeconds("poll_latency_seconds", "Live chat request to response time", g_metrics.pollLatencyHistogramNs);
+    out.Counter("api_requests_total", "YouTube Data API requests", g_metrics.apiRequests);
+    out.Counter("api_errors_total", "Failed YouTube Data API requests", g_metrics.apiErrors);
+    out.Gauge("quota_units_used", "Estimated API quota units used today", g_metrics.quotaUnitsUsed);
+    out.Header("poll_interval_seconds", "gauge", "Delay before the next scheduled poll");
+    out.Value("poll_interval_seconds", g_metrics.pollIntervalMs.load(std::memory_order_relaxed) / 1000.0);
+
+    out.Counter("chat_pages_parsed_total", "Live chat pages parsed", g_metrics.chatPagesParsed);
+    out.Counter("chat_messages_parsed_total", "Live chat messages parsed", g_metrics.chatMessagesParsed);
+    out.Counter("chat_bytes_parsed_total", "Decoded live chat bytes parsed", g_metrics.chatBytesParsed);
+    out.Counter("chat_parse_errors_total", "Live chat pages that failed to parse", g_metrics.chatParseErrors);
+    out.Counter("chat_duplicates_suppressed_total", "Chat messages skipped as already dispatched",
+                g_metrics.chatDuplicatesSuppressed);
+
+    // Per chat, labelled by video ID; unused slots are skipped
+    std::array<std::array<char, 64>, PluginMetrics::MAX_SOURCE_SLOTS> sourceLabels{};
+    for (size_t slot = 0; slot < PluginMetrics::MAX_SOURCE_SLOTS; slot++) {
+        char videoId[PluginMetrics::SOURCE_ID_BYTES + 1];
+        if (g_metrics.GetSourceId(slot, videoId)) {
+            std::snprintf(sourceLabels[slot].data(), sourceLabels[slot].size(), "source=\"%s\"", videoId);
+        }
+    }
+    auto sourceValues = [&](const char* name, const char* type, const char* help,
+                            std::atomic<uint64_t> PluginMetrics::SourceMetrics::*field) {
+        out.Header(name, type, help);
+        for (size_t slot = 0; slot < PluginMetrics::MAX_SOURCE_SLOTS; slot++) {
+            if (sourceLabels[slot][0] == '\0') continue;
+            out.Value(name, sourceLabels[slot].data(), (g_metrics.sources[slot].*field).load(std::memory_order_relaxed));
+        }
+    };
+    sourceValues("source_running", "gauge", "Whether the chat is being polled",
+                 &PluginMetrics::SourceMetrics::running);
+    sourceValues("source_pages_total", "counter", "Live chat pages received per chat",
+                 &PluginMetrics::SourceMetrics::pagesReceived);
+    sourceValues("source_messages_total", "counter", "Live chat messages received per chat",
+                 &PluginMetrics::SourceMetrics::messagesReceived);
+    sourceValues("source_events_dispatched_total", "counter", "Events handed to the ingestion hub per chat",
+                 &PluginMetrics::SourceMetrics::eventsDispatched);
+    sourceValues("source_duplicates_total", "counter", "Messages skipped as already dispatched per chat",
+                 &PluginMetrics::SourceMetrics::duplicatesSuppressed);
+    sourceValues("source_request_failures_total", "counter", "Failed live chat requests per chat",
+                 &PluginMetrics::SourceMetrics::requestFailures);
+    out.Header("source_poll_interval_seconds", "gauge", "Delay before the chat's next scheduled poll");
+    for (size_t slot = 0; slot < PluginMetrics::MAX_SOURCE_SLOTS; slot++) {
+        if (sourceLabels[slot][0] == '\0') continue;
+        out.Value("source_poll_interval_seconds", sourceLabels[slot].data(),
+                  g_metrics.sources[slot].pollIntervalMs.load(std::memory_order_relaxed) / 1000.0);
+    }
+
+    out.Counter("unknown_currency_donations_total", "Paid messages skipped because their currency has no JPY rate",
+                g_metrics.unknownCurrencyDonations);
+    out.Counter("viewer_limiter_suppressed_total", "Events dropped by the per-viewer rate limiter",
+                g_metrics.viewerLimiterSuppressed);
+    out.Gauge("viewer_limiter_entries", "Viewers tracked by the per-viewer rate limiter", g_metrics.viewerLimiterEntries);
+    out.Counter("free_chat_sampled_out_total", "Regular chat messages not picked by the free chat sampler",
+                g_metrics.freeChatSampledOut);
+    out.Header("free_chat_arrival_rate", "gauge", "Estimated regular chat messages per second");
+    out.Value("free_chat_arrival_rate", g_metrics.freeChatRateMilli.load(std::memory_order_relaxed) / 1000.0);
+    out.Header("free_chat_sample_probability", "gauge", "Chance that a regular chat message is kept");
+    out.Value("free_chat_sample_probability",
+              g_metrics.freeChatSampleProbabilityMilli.load(std::memory_order_relaxed) / 1000.0);
+
+    out.Counter("injected_events_total", "Events accepted by the local injection endpoint", g_metrics.injectedEvents);
+    out.Counter("injected_events_dropped_total", "Injected events over the rate limit", g_metrics.injectedEventsDropped);
+    out.Counter("injected_lines_malformed_total", "Injected JSON lines that did not parse",
+                g_metrics.injectedLinesMalformed);
+    out.Gauge("queue_depth", "Donations waiting in the reorder window", g_metrics.hubQueueDepth);
+
+    out.Gauge("overlay_sources", "Obstruction overlay sources, including fading ones", g_metrics.overlaySources);
+    out.Gauge("scene_items", "Scene items owned by the plugin", g_metrics.ownedSceneItems);
+
+    out.Header("cache_memory_bytes", "gauge", "Memory held by plugin caches");
+    out.Value("cache_memory_bytes", "cache=\"message_ids\"", g_metrics.dedupeCacheBytes.load(std::memory_order_relaxed));
+    out.Value("cache_memory_bytes", "cache=\"viewer_buckets\"", g_metrics.viewerLimiterBytes.load(std::memory_order_relaxed));
+
+    return out.Take();
+}
+
+// =============================================================================
+// MetricsHttpServer (worker thread)
+// =============================================================================
+
+MetricsHttpServer::MetricsHttpServer(quint16 port)
+    : m_server(new QTcpServer(this))
+    , m_port(port)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &MetricsHttpServer::OnNewConnection);
+}
+
+void MetricsHttpServer::Listen() {
+    // Never reachable from other machines
+    if (!m_server->listen(QHostAddress::LocalHost, m_port)) {
+        blog(LOG_ERROR, "[Metrics] Failed to listen on 127.0.0.1:%d: %s",
+             m_port, m_server->errorString().toStdString().c_str());
+        return;
+    }
+    blog(LOG_INFO, "[Metrics] Serving http://127.0.0.1:%d/metrics", m_port);
+}
+
+void MetricsHttpServer::OnNewConnection() {
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, &MetricsHttpServer::OnReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, &MetricsHttpServer::OnDisconnected);
+        m_requests.insert(socket, QByteArray());
+    }
+}
+
+void MetricsHttpServer::OnReadyRead() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    auto it = m_requests.find(socket);
+    if (it == m_requests.end()) return;
+
+    it->append(socket->readAll());
+    if (it->size() > MAX_REQUEST_BYTES) {
+        socket->abort();
+        return;
+    }
+    if (!it->contains("\r\n\r\n")) return;
+
+    // Request line: "GET /metrics HTTP/1.1"
+    const QList<QByteArray> requestLine = it->left(it->indexOf("\r\n")).split(' ');
+    m_requests.erase(it);
+
+    if (requestLine.size() < 2 || requestLine[0] != "GET") {
+        Respond(socket, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+    } else if (requestLine[1] != "/metrics") {
+        Respond(socket, "404 Not Found", "text/plain", "Metrics are served at /metrics\n");
+    } else {
+        Respond(socket, "200 OK", "text/plain; version=0.0.4; charset=utf-8",
+                QByteArray::fromStdString(FormatPrometheusMetrics()));
+    }
+}
+
+void MetricsHttpServer::OnDisconnected() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    m_requests.remove(socket);
+    socket->deleteLater();
+}
+
+void MetricsHttpServer::Respond(QTcpSocket* socket, const QByteArray& status, const QByteArray& contentType,
+                                const QByteArray& body) {
+    QByteArray response = "HTTP/1.1 " + status + "\r\n"
+                          "Content-Type: " + contentType + "\r\n"
+                          "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                          "Connection: close\r\n\r\n";
+    response += body;
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+// =============================================================================
+// MetricsExporter (UI thread)
+// =============================================================================
+
+MetricsExporter::MetricsExporter()
+    : m_thread(nullptr)
+    , m_port(DEFAULT_METRICS_PORT)
+{
+}
+
+MetricsExporter::~MetricsExporter() {
+    Stop();
+}
+
+void MetricsExporter::Start(quint16 port) {
+    if (m_thread) {
+        if (port == m_port) return;
+        Stop();
+    }
+
+    m_port = port;
+    m_thread = new QThread();
+    m_thread->setObjectName("obs-superchat-metrics");
+
+    // The server and its sockets are created and destroyed on the worker thread
+    MetricsHttpServer* server = new MetricsHttpServer(m_port);
+    server->moveToThread(m_thread);
+    QObject::connect(m_thread, &QThread::started, server, &MetricsHttpServer::Listen);
+    QObject::connect(m_thread, &QThread::finished, server, &QObject::deleteLater);
+    m_thread->start(QThread::LowPriority);
+}
+
+void MetricsExporter::Stop() {
+    if (!m_thread) return;
+
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    blog(LOG_INFO, "[Metrics] Stopped");
+}
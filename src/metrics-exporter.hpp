@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <string>
+
+class QThread;
+class QTcpServer;
+class QTcpSocket;
+
+#define DEFAULT_METRICS_PORT 45680
+
+// g_metrics in Prometheus text exposition format (version 0.0.4)
+std::string FormatPrometheusMetrics();
+
+// Lives on the exporter's worker thread; answers GET /metrics and nothing else
+class MetricsHttpServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MetricsHttpServer(quint16 port);
+
+public slots:
+    void Listen();
+
+private slots:
+    void OnNewConnection();
+    void OnReadyRead();
+    void OnDisconnected();
+
+private:
+    void Respond(QTcpSocket* socket, const QByteArray& status, const QByteArray& contentType,
+                 const QByteArray& body);
+
+    QTcpServer* m_server;
+    QHash<QTcpSocket*, QByteArray> m_requests;  // Request bytes received so far
+    quint16 m_port;
+};
+
+// Opt-in localhost endpoint for Prometheus scrapes (http://127.0.0.1:<port>/metrics).
+// The HTTP server runs on its own QThread and reads only the atomic counters in
+// g_metrics, so a scrape never waits on, or blocks, the UI and graphics threads.
+class MetricsExporter {
+public:
+    MetricsExporter();
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Restarts the worker when the port changes; the listen result is logged by the worker
+    void Start(quint16 port);
+    void Stop();
+    bool IsRunning() const { return m_thread != nullptr; }
+    quint16 GetPort() const { return m_port; }
+
+private:
+    QThread* m_thread;
+    quint16 m_port;
+};
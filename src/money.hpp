@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// Fixed-point amount in micro-units (1/1,000,000) of a currency, the unit YouTube sends
+// as amountMicros. Thresholds and comparisons stay exact; doubles only appear at the UI
+// and effect-intensity edges via FromUnits()/ToUnits().
+class Money {
+public:
+    static constexpr int64_t MICROS_PER_UNIT = 1000000;
+
+    constexpr Money() : m_micros(0) {}
+
+    static constexpr Money FromMicros(int64_t micros) { return Money(micros); }
+    static constexpr Money FromWholeUnits(int64_t units) { return Money(units * MICROS_PER_UNIT); }
+
+    // Rounds to the nearest micro-unit (spin boxes, JSON numbers)
+    static Money FromUnits(double units) { return Money(std::llround(units * MICROS_PER_UNIT)); }
+
+    constexpr int64_t Micros() const { return m_micros; }
+    double ToUnits() const { return static_cast<double>(m_micros) / MICROS_PER_UNIT; }
+
+    constexpr bool IsPositive() const { return m_micros > 0; }
+
+    constexpr Money operator+(Money other) const { return Money(m_micros + other.m_micros); }
+    constexpr Money operator-(Money other) const { return Money(m_micros - other.m_micros); }
+    Money& operator+=(Money other) { m_micros += other.m_micros; return *this; }
+
+    constexpr bool operator==(Money other) const { return m_micros == other.m_micros; }
+    constexpr bool operator!=(Money other) const { return m_micros != other.m_micros; }
+    constexpr bool operator<(Money other) const { return m_micros < other.m_micros; }
+    constexpr bool operator<=(Money other) const { return m_micros <= other.m_micros; }
+    constexpr bool operator>(Money other) const { return m_micros > other.m_micros; }
+    constexpr bool operator>=(Money other) const { return m_micros >= other.m_micros; }
+
+private:
+    explicit constexpr Money(int64_t micros) : m_micros(micros) {}
+
+    int64_t m_micros;
+};
@@ -0,0 +1,172 @@
+#include "obs-call-profiler.hpp"
+
+#ifdef OBS_CALL_PROFILING
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+static const uint64_t DEFAULT_FRAME_INTERVAL_NS = 1000000000ULL / 60;
+static const char* NO_SCOPE_NAME = "(no scope)";
+
+ObsCallProfiler& ObsCallProfiler::Instance() {
+    static ObsCallProfiler instance;
+    return instance;
+}
+
+ObsCallProfiler::ObsCallProfiler()
+    : m_frames(FRAME_HISTORY)
+{
+    m_scopeNames.reserve(MAX_SCOPES);
+}
+
+uint64_t ObsCallProfiler::FrameIntervalNs() {
+    if (m_frameIntervalNs == 0) {
+        struct obs_video_info ovi;
+        if (obs_get_video_info(&ovi) && ovi.fps_num > 0) {
+            m_frameIntervalNs = 1000000000ULL * ovi.fps_den / ovi.fps_num;
+        } else {
+            m_frameIntervalNs = DEFAULT_FRAME_INTERVAL_NS;
+        }
+    }
+    return m_frameIntervalNs;
+}
+
+size_t ObsCallProfiler::ScopeIndex(const char* scope) {
+    // Scope names are static strings, so the pointer usually matches; names from
+    // different translation units may not share storage, hence the string compare
+    for (size_t i = 0; i < m_scopeNames.size(); i++) {
+        const char* name = m_scopeNames[i];
+        if (name == scope || (name && scope && std::strcmp(name, scope) == 0)) return i;
+    }
+    if (m_scopeNames.size() < MAX_SCOPES) {
+        m_scopeNames.push_back(scope);
+        return m_scopeNames.size() - 1;
+    }
+    return MAX_SCOPES - 1;
+}
+
+void ObsCallProfiler::Record(const char* api, bool takesSceneLock, uint64_t startNs, uint64_t durationNs) {
+    const char* scope = ObsCallScope::Current();
+
+    // Frames are numbered on the video clock; a frame without calls gets no slot
+    uint64_t frame = startNs / FrameIntervalNs();
+    if (m_frameCount == 0 || m_frames[m_head].frame != frame) {
+        if (m_frameCount > 0) {
+            m_head = (m_head + 1) % FRAME_HISTORY;
+        }
+        m_frames[m_head] = FrameRecord();
+        m_frames[m_head].frame = frame;
+        m_frameCount = std::min(m_frameCount + 1, FRAME_HISTORY);
+    }
+
+    size_t scopeIndex = ScopeIndex(scope);
+    ScopeFrameStats& stats = m_frames[m_head].scopes[scopeIndex];
+    stats.calls++;
+    stats.timeNs += durationNs;
+    if (takesSceneLock) {
+        stats.sceneLockNs += durationNs;
+    }
+
+    ApiStats& apiStats = m_apiStats[ApiKey{scopeIndex, api}];
+    apiStats.calls++;
+    apiStats.timeNs += durationNs;
+    apiStats.maxNs = std::max(apiStats.maxNs, durationNs);
+}
+
+std::vector<std::string> ObsCallProfiler::FormatReport(size_t topCount) const {
+    std::vector<std::string> lines;
+    char line[256];
+
+    if (m_frameCount == 0) {
+        lines.push_back("No libobs calls recorded");
+        return lines;
+    }
+
+    // Oldest slot first, so the frame span is last - first
+    size_t oldest = (m_head + FRAME_HISTORY + 1 - m_frameCount) % FRAME_HISTORY;
+    uint64_t spanFrames = m_frames[m_head].frame - m_frames[oldest].frame + 1;
+    std::snprintf(line, sizeof(line), "%zu frames with libobs calls out of the last %llu (%.1f s)",
+                  m_frameCount, static_cast<unsigned long long>(spanFrames),
+                  spanFrames * m_frameIntervalNs / 1e9);
+    lines.push_back(line);
+
+    struct ScopeSummary {
+        const char* name;
+        uint64_t frames = 0;        // Frames in which the scope made calls
+        uint64_t calls = 0;
+        uint64_t timeNs = 0;
+        uint64_t sceneLockNs = 0;
+        uint32_t maxCalls = 0;
+        uint64_t maxTimeNs = 0;
+    };
+
+    std::vector<ScopeSummary> summaries(m_scopeNames.size());
+    for (size_t i = 0; i < m_scopeNames.size(); i++) {
+        summaries[i].name = m_scopeNames[i] ? m_scopeNames[i] : NO_SCOPE_NAME;
+    }
+    for (size_t n = 0; n < m_frameCount; n++) {
+        const FrameRecord& record = m_frames[(oldest + n) % FRAME_HISTORY];
+        for (size_t i = 0; i < summaries.size(); i++) {
+            const ScopeFrameStats& stats = record.scopes[i];
+            if (stats.calls == 0) continue;
+            ScopeSummary& summary = summaries[i];
+            summary.frames++;
+            summary.calls += stats.calls;
+            summary.timeNs += stats.timeNs;
+            summary.sceneLockNs += stats.sceneLockNs;
+            summary.maxCalls = std::max(summary.maxCalls, stats.calls);
+            summary.maxTimeNs = std::max(summary.maxTimeNs, stats.timeNs);
+        }
+    }
+    std::sort(summaries.begin(), summaries.end(),
+              [](const ScopeSummary& a, const ScopeSummary& b) { return a.timeNs > b.timeNs; });
+
+    lines.push_back("Per frame (averaged over frames where the scope was active):");
+    lines.push_back("  scope                     frames  calls/frame  max calls  time/frame us  max us  lock/frame us");
+    for (const ScopeSummary& summary : summaries) {
+        if (summary.frames == 0) continue;
+        std::snprintf(line, sizeof(line), "  %-24s %7llu %12.1f %10u %14.1f %7.1f %14.1f",
+                      summary.name, static_cast<unsigned long long>(summary.frames),
+                      static_cast<double>(summary.calls) / summary.frames, summary.maxCalls,
+                      summary.timeNs / 1000.0 / summary.frames, summary.maxTimeNs / 1000.0,
+                      summary.sceneLockNs / 1000.0 / summary.frames);
+        lines.push_back(line);
+    }
+
+    // The same API may be recorded under several name literals (one per translation unit)
+    std::map<std::string, ApiStats> merged;
+    for (const auto& entry : m_apiStats) {
+        const char* scope = m_scopeNames[entry.first.scope];
+        ApiStats& stats = merged[std::string(scope ? scope : NO_SCOPE_NAME) + "|" + entry.first.api];
+        stats.calls += entry.second.calls;
+        stats.timeNs += entry.second.timeNs;
+        stats.maxNs = std::max(stats.maxNs, entry.second.maxNs);
+    }
+
+    std::vector<std::pair<std::string, ApiStats>> apis(merged.begin(), merged.end());
+    size_t count = std::min(topCount, apis.size());
+    std::partial_sort(apis.begin(), apis.begin() + count, apis.end(),
+                      [](const auto& a, const auto& b) { return a.second.timeNs > b.second.timeNs; });
+
+    lines.push_back("Top offenders since reset (scope|API):");
+    lines.push_back("  call                                                    calls   total ms   mean us    max us");
+    for (size_t i = 0; i < count; i++) {
+        const ApiStats& stats = apis[i].second;
+        std::snprintf(line, sizeof(line), "  %-52s %9llu %10.2f %9.2f %9.1f", apis[i].first.c_str(),
+                      static_cast<unsigned long long>(stats.calls), stats.timeNs / 1e6,
+                      stats.timeNs / 1000.0 / stats.calls, stats.maxNs / 1000.0);
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void ObsCallProfiler::Reset() {
+    std::fill(m_frames.begin(), m_frames.end(), FrameRecord());
+    m_head = 0;
+    m_frameCount = 0;
+    m_apiStats.clear();
+}
+
+#endif
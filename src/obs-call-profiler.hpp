@@ -0,0 +1,163 @@
+#pragma once
+
+// Per-frame libobs call profiler, compiled in with -DENABLE_OBS_CALL_PROFILING=ON.
+//
+// Translation units that include this header LAST get every profiled obs_* call replaced
+// by a wrapper that times it and charges it to the current OBS_CALL_SCOPE (effect class
+// or "ObstructionManager"). Calls, time and scene-lock hold time are aggregated per scope
+// per video frame into a ring buffer; Tools > "Dump libobs Call Profile" logs the worst.
+// Without OBS_CALL_PROFILING this header defines nothing.
+
+#ifdef OBS_CALL_PROFILING
+
+#include "obs-call-scope.hpp"
+#include <obs.h>
+#include <obs-frontend-api.h>
+#include <util/platform.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ObsCallProfiler {
+public:
+    static constexpr size_t FRAME_HISTORY = 600;   // 10 s at 60 FPS
+    static constexpr size_t MAX_SCOPES = 32;       // Effect classes + managers; extra scopes share the last slot
+
+    static ObsCallProfiler& Instance();
+
+    // Wraps one libobs call: returns whatever the call returns
+    template <typename Call>
+    static auto Profile(const char* api, bool takesSceneLock, Call&& call) -> decltype(call()) {
+        CallTimer timer(api, takesSceneLock);
+        return call();
+    }
+
+    void Record(const char* api, bool takesSceneLock, uint64_t startNs, uint64_t durationNs);
+
+    // Per-scope frame statistics over the ring buffer, followed by the (scope, API)
+    // pairs with the most total time since the last Reset()
+    std::vector<std::string> FormatReport(size_t topCount = 15) const;
+
+    void Reset();
+
+private:
+    struct ScopeFrameStats {
+        uint32_t calls = 0;
+        uint64_t timeNs = 0;
+        uint64_t sceneLockNs = 0;   // Time inside calls that take the scene mutex
+    };
+
+    struct FrameRecord {
+        uint64_t frame = 0;
+        std::array<ScopeFrameStats, MAX_SCOPES> scopes{};
+    };
+
+    struct ApiStats {
+        uint64_t calls = 0;
+        uint64_t timeNs = 0;
+        uint64_t maxNs = 0;
+    };
+
+    // Scope index + API name literal; recording never allocates for a known pair
+    struct ApiKey {
+        size_t scope;
+        const char* api;
+        bool operator==(const ApiKey& other) const { return scope == other.scope && api == other.api; }
+    };
+
+    struct ApiKeyHash {
+        size_t operator()(const ApiKey& key) const {
+            return std::hash<const void*>()(key.api) * 31 + key.scope;
+        }
+    };
+
+    class CallTimer {
+    public:
+        CallTimer(const char* api, bool takesSceneLock)
+            : m_api(api), m_takesSceneLock(takesSceneLock), m_start(os_gettime_ns()) {}
+        ~CallTimer() {
+            uint64_t end = os_gettime_ns();
+            ObsCallProfiler::Instance().Record(m_api, m_takesSceneLock, m_start, end - m_start);
+        }
+
+    private:
+        const char* m_api;
+        bool m_takesSceneLock;
+        uint64_t m_start;
+    };
+
+    ObsCallProfiler();
+    ObsCallProfiler(const ObsCallProfiler&) = delete;
+    ObsCallProfiler& operator=(const ObsCallProfiler&) = delete;
+
+    size_t ScopeIndex(const char* scope);
+    uint64_t FrameIntervalNs();
+
+    std::vector<FrameRecord> m_frames;      // Ring buffer of frames that made calls
+    size_t m_head = 0;                      // Slot of the frame being filled
+    size_t m_frameCount = 0;                // Valid slots
+    uint64_t m_frameIntervalNs = 0;
+    std::vector<const char*> m_scopeNames;  // Index -> scope name (nullptr = no scope)
+    std::unordered_map<ApiKey, ApiStats, ApiKeyHash> m_apiStats;    // Totals since Reset()
+};
+
+#define OBS_PROFILED_CALL(fn, lock, ...) \
+    ObsCallProfiler::Profile(#fn, lock, [&]() { return (fn)(__VA_ARGS__); })
+
+// A function-like macro is not expanded again inside its own replacement, so (fn)(...)
+// above still calls the real function.
+
+// Scene graph: these take the scene's mutex inside libobs
+#define obs_scene_find_source(...) OBS_PROFILED_CALL(obs_scene_find_source, true, __VA_ARGS__)
+#define obs_scene_add(...) OBS_PROFILED_CALL(obs_scene_add, true, __VA_ARGS__)
+#define obs_scene_enum_items(...) OBS_PROFILED_CALL(obs_scene_enum_items, true, __VA_ARGS__)
+#define obs_sceneitem_remove(...) OBS_PROFILED_CALL(obs_sceneitem_remove, true, __VA_ARGS__)
+
+#define obs_frontend_get_current_scene(...) OBS_PROFILED_CALL(obs_frontend_get_current_scene, false, __VA_ARGS__)
+#define obs_frontend_get_scenes(...) OBS_PROFILED_CALL(obs_frontend_get_scenes, false, __VA_ARGS__)
+#define obs_frontend_source_list_free(...) OBS_PROFILED_CALL(obs_frontend_source_list_free, false, __VA_ARGS__)
+#define obs_scene_from_source(...) OBS_PROFILED_CALL(obs_scene_from_source, false, __VA_ARGS__)
+#define obs_get_source_by_name(...) OBS_PROFILED_CALL(obs_get_source_by_name, false, __VA_ARGS__)
+
+// Sources
+#define obs_source_create(...) OBS_PROFILED_CALL(obs_source_create, false, __VA_ARGS__)
+#define obs_source_create_private(...) OBS_PROFILED_CALL(obs_source_create_private, false, __VA_ARGS__)
+#define obs_source_release(...) OBS_PROFILED_CALL(obs_source_release, false, __VA_ARGS__)
+#define obs_source_get_name(...) OBS_PROFILED_CALL(obs_source_get_name, false, __VA_ARGS__)
+#define obs_source_get_width(...) OBS_PROFILED_CALL(obs_source_get_width, false, __VA_ARGS__)
+#define obs_source_get_height(...) OBS_PROFILED_CALL(obs_source_get_height, false, __VA_ARGS__)
+#define obs_source_get_settings(...) OBS_PROFILED_CALL(obs_source_get_settings, false, __VA_ARGS__)
+#define obs_source_get_private_settings(...) OBS_PROFILED_CALL(obs_source_get_private_settings, false, __VA_ARGS__)
+#define obs_source_update(...) OBS_PROFILED_CALL(obs_source_update, false, __VA_ARGS__)
+#define obs_source_filter_add(...) OBS_PROFILED_CALL(obs_source_filter_add, false, __VA_ARGS__)
+#define obs_source_filter_remove(...) OBS_PROFILED_CALL(obs_source_filter_remove, false, __VA_ARGS__)
+#define obs_source_enum_filters(...) OBS_PROFILED_CALL(obs_source_enum_filters, false, __VA_ARGS__)
+
+// Scene items
+#define obs_sceneitem_addref(...) OBS_PROFILED_CALL(obs_sceneitem_addref, false, __VA_ARGS__)
+#define obs_sceneitem_release(...) OBS_PROFILED_CALL(obs_sceneitem_release, false, __VA_ARGS__)
+#define obs_sceneitem_get_source(...) OBS_PROFILED_CALL(obs_sceneitem_get_source, false, __VA_ARGS__)
+#define obs_sceneitem_set_pos(...) OBS_PROFILED_CALL(obs_sceneitem_set_pos, false, __VA_ARGS__)
+#define obs_sceneitem_get_pos(...) OBS_PROFILED_CALL(obs_sceneitem_get_pos, false, __VA_ARGS__)
+#define obs_sceneitem_set_scale(...) OBS_PROFILED_CALL(obs_sceneitem_set_scale, false, __VA_ARGS__)
+#define obs_sceneitem_get_scale(...) OBS_PROFILED_CALL(obs_sceneitem_get_scale, false, __VA_ARGS__)
+#define obs_sceneitem_set_rot(...) OBS_PROFILED_CALL(obs_sceneitem_set_rot, false, __VA_ARGS__)
+#define obs_sceneitem_get_rot(...) OBS_PROFILED_CALL(obs_sceneitem_get_rot, false, __VA_ARGS__)
+#define obs_sceneitem_set_visible(...) OBS_PROFILED_CALL(obs_sceneitem_set_visible, false, __VA_ARGS__)
+#define obs_sceneitem_set_blending_mode(...) OBS_PROFILED_CALL(obs_sceneitem_set_blending_mode, false, __VA_ARGS__)
+
+// Settings
+#define obs_data_create(...) OBS_PROFILED_CALL(obs_data_create, false, __VA_ARGS__)
+#define obs_data_release(...) OBS_PROFILED_CALL(obs_data_release, false, __VA_ARGS__)
+#define obs_data_set_int(...) OBS_PROFILED_CALL(obs_data_set_int, false, __VA_ARGS__)
+#define obs_data_set_double(...) OBS_PROFILED_CALL(obs_data_set_double, false, __VA_ARGS__)
+#define obs_data_set_bool(...) OBS_PROFILED_CALL(obs_data_set_bool, false, __VA_ARGS__)
+#define obs_data_set_string(...) OBS_PROFILED_CALL(obs_data_set_string, false, __VA_ARGS__)
+#define obs_data_get_bool(...) OBS_PROFILED_CALL(obs_data_get_bool, false, __VA_ARGS__)
+#define obs_data_get_string(...) OBS_PROFILED_CALL(obs_data_get_string, false, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+// Names the plugin component responsible for the libobs calls made inside a block, so the
+// headless stub (and profiling builds) can attribute calls to an effect. Scopes nest; the
+// innermost one wins. Compiled out unless OBS_CALL_ATTRIBUTION is defined.
+//
+//     OBS_CALL_SCOPE(metaObject()->className());
+//
+// Names must outlive the scope (string literals or Qt class names).
+
+#ifdef OBS_CALL_ATTRIBUTION
+
+class ObsCallScope {
+public:
+    explicit ObsCallScope(const char* name) : m_previous(s_current) { s_current = name; }
+    ~ObsCallScope() { s_current = m_previous; }
+
+    ObsCallScope(const ObsCallScope&) = delete;
+    ObsCallScope& operator=(const ObsCallScope&) = delete;
+
+    // nullptr outside of any scope
+    static const char* Current() { return s_current; }
+
+private:
+    const char* m_previous;
+    static inline thread_local const char* s_current = nullptr;
+};
+
+#define OBS_CALL_SCOPE_CONCAT_(a, b) a##b
+#define OBS_CALL_SCOPE_NAME_(line) OBS_CALL_SCOPE_CONCAT_(obsCallScope_, line)
+#define OBS_CALL_SCOPE(name) ObsCallScope OBS_CALL_SCOPE_NAME_(__LINE__)(name)
+
+#else
+
+#define OBS_CALL_SCOPE(name) ((void)0)
+
+#endif
@@ -1,6 +1,10 @@
 #include "obstruction-manager.hpp"
 #include "effect-system.hpp"
 #include "effect-config.hpp"
+#include "source-registry.hpp"
+#include "obs-call-scope.hpp"
+#include "plugin-log.hpp"
+#include "plugin-metrics.hpp"
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include <graphics/vec2.h>
@@ -13,12 +17,29 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QFileInfoList>
+#include <QTimer>
+#include "obs-call-profiler.hpp"     // Keep last
 
 namespace fs = std::filesystem;
 
+// Attribution name for libobs calls made outside of any effect (see obs-call-scope.hpp)
+static const char* CALL_SCOPE = "ObstructionManager";
+
+// Length of the fade-out played when an overlay expires or is evicted
+static const double OVERLAY_FADE_SECONDS = 1.0;
+
+// TweenEngine id for the main source scale transition
+static const int MAIN_SOURCE_SCALE_TWEEN = 0;
+
 ObstructionManager::ObstructionManager()
     : m_currentShrinkPercentage(0.0)
     , m_enabled(true)
+    , m_expiryTimer(std::make_unique<QTimer>())
+    , m_fadeTimer(std::make_unique<QTimer>())
+    , m_overlayLifetime(60.0)
+    , m_maxOverlays(20)
+    , m_evictionPolicy(OverlayEvictionPolicy::OldestFirst)
+    , m_nextObstructionId(0)
     , m_originalTransformSaved(false)
     , m_randomEngine(std::random_device{}())
     , m_effectManager(std::make_unique<EffectManager>())
@@ -29,7 +50,13 @@ ObstructionManager::ObstructionManager()
     m_originalPos.y = 0.0f;
     m_originalRotation = 0.0f;
 
-    blog(LOG_INFO, "[Obstruction] EffectManager initialized");
+    m_expiryTimer->setSingleShot(true);
+    QObject::connect(m_expiryTimer.get(), &QTimer::timeout, [this]() { OnExpiryTimer(); });
+
+    m_fadeTimer->setInterval(16); // ~60 FPS, same rate as EffectBase
+    QObject::connect(m_fadeTimer.get(), &QTimer::timeout, [this]() { OnFadeTick(); });
+
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] EffectManager initialized");
 }
 
 ObstructionManager::~ObstructionManager() {
@@ -37,9 +64,11 @@ ObstructionManager::~ObstructionManager() {
 }
 
 void ObstructionManager::ApplyObstruction(double amount) {
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
     if (!m_enabled) return;
 
-    blog(LOG_INFO, "[Obstruction] Applying obstruction for amount: %.2f JPY", amount);
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applying obstruction for amount: %.2f JPY", amount);
 
     // Scale effects based on donation amount
     // 100 JPY = minimal effect, 10000 JPY = maximum effect
@@ -52,7 +81,7 @@ void ObstructionManager::ApplyObstruction(double amount) {
     // Add obstruction overlays
     int numObstructions = static_cast<int>(1 + intensity * 3);  // 1-4 obstructions
     for (int i = 0; i < numObstructions; ++i) {
-        AddRandomObstruction(intensity);
+        AddRandomObstruction(intensity, amount);
     }
 
     // Apply visual effects to main source
@@ -69,52 +98,56 @@ void ObstructionManager::ApplyObstruction(double amount) {
             }
 
             obs_source_release(mainSource);
-            blog(LOG_INFO, "[Obstruction] Applied %d visual effects (duration: %.1fs)", numEffects, effectDuration);
+            PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied %d visual effects (duration: %.1fs)", numEffects, effectDuration);
         }
     }
 }
 
-void ObstructionManager::ShrinkMainSource(double percentage) {
+void ObstructionManager::ShrinkMainSource(double percentage, bool smooth, EasingCurve curve, double animDuration) {
     if (m_mainSourceName.empty()) {
-        blog(LOG_WARNING, "[Obstruction] Main source name not set");
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_WARNING, "[Obstruction] Main source name not set");
         return;
     }
 
     obs_source_t* source = FindSourceByName(m_mainSourceName);
     if (!source) {
-        blog(LOG_WARNING, "[Obstruction] Main source not found: %s", m_mainSourceName.c_str());
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_WARNING, "[Obstruction] Main source not found: %s", m_mainSourceName.c_str());
         return;
     }
 
+    double fromScale = 1.0 - (m_currentShrinkPercentage / 100.0);
+
     // Accumulate shrink percentage (but cap at 80%)
     m_currentShrinkPercentage = std::min(m_currentShrinkPercentage + percentage, 80.0);
 
     // Calculate new scale
     double scale = 1.0 - (m_currentShrinkPercentage / 100.0);
 
-    UpdateSourceTransform(source, scale);
+    AnimateMainSourceScale(source, fromScale, scale, smooth, curve, animDuration);
 
-    blog(LOG_INFO, "[Obstruction] Shrunk main source to %.1f%% (total shrink: %.1f%%)",
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Shrunk main source to %.1f%% (total shrink: %.1f%%)",
             scale * 100.0, m_currentShrinkPercentage);
 
     obs_source_release(source);
 }
 
-void ObstructionManager::AddRandomObstruction(double intensity) {
+void ObstructionManager::AddRandomObstruction(double intensity, double value) {
     std::string assetPath = SelectRandomObstructionAsset();
     if (assetPath.empty()) {
-        blog(LOG_WARNING, "[Obstruction] No obstruction assets found");
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_WARNING, "[Obstruction] No obstruction assets found");
         return;
     }
 
-    CreateObstructionSource(assetPath, intensity);
+    CreateObstructionSource(assetPath, intensity, value, m_overlayLifetime);
 }
 
 void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
     if (!m_enabled) return;
 
-    blog(LOG_INFO, "[Obstruction] Applying configured effect: Action=%d, Duration=%.1f, Amount=%.2f",
-         static_cast<int>(config.action), config.duration, config.amount);
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applying configured effect: Action=%d, Duration=%.1f, Amount=%.2f",
+               static_cast<int>(config.action), config.duration, config.amount.ToUnits());
 
     obs_source_t* mainSource = nullptr;
     if (!m_mainSourceName.empty()) {
@@ -127,7 +160,7 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyRandomEffect(mainSource, 0.5, config.duration);
             } else {
-                ApplyObstruction(config.amount);
+                ApplyObstruction(config.amount.ToUnits());
             }
             break;
         }
@@ -140,8 +173,8 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
                 const char* rotTypeStr = (config.rotationType == 0) ? "Z軸" :
                                         (config.rotationType == 1) ? "X軸" :
                                         (config.rotationType == 2) ? "Y軸" : "全軸";
-                blog(LOG_INFO, "[Obstruction] Applied rotation: type=%s, speed=%.1f, duration=%.1f, reverse=%d",
-                     rotTypeStr, config.rotationSpeed, config.duration, config.rotationReverse);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied rotation: type=%s, speed=%.1f, duration=%.1f, reverse=%d",
+                           rotTypeStr, config.rotationSpeed, config.duration, config.rotationReverse);
             }
             break;
         }
@@ -150,8 +183,8 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply blink effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::Blink, config.blinkFrequency, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied blink: frequency=%.1f Hz, duration=%.1f",
-                     config.blinkFrequency, config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied blink: frequency=%.1f Hz, duration=%.1f",
+                           config.blinkFrequency, config.duration);
             }
             break;
         }
@@ -160,8 +193,8 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply hue shift effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::HueShift, config.hueSpeed / 180.0, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied hue shift: speed=%.1f deg/s, duration=%.1f",
-                     config.hueSpeed, config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied hue shift: speed=%.1f deg/s, duration=%.1f",
+                           config.hueSpeed, config.duration);
             }
             break;
         }
@@ -170,8 +203,8 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply shake effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::Shake, config.shakeIntensity / 10.0, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied shake: intensity=%.1f, duration=%.1f",
-                     config.shakeIntensity, config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied shake: intensity=%.1f, duration=%.1f",
+                           config.shakeIntensity, config.duration);
             }
             break;
         }
@@ -180,7 +213,7 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply progress bar effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::ProgressBar, 1.0, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied progress bar: duration=%.1f", config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied progress bar: duration=%.1f", config.duration);
             }
             break;
         }
@@ -189,7 +222,7 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply 3D rotation effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::Rotation3D, 0.5, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied 3D rotation: duration=%.1f", config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied 3D rotation: duration=%.1f", config.duration);
             }
             break;
         }
@@ -198,7 +231,7 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply kaleidoscope effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::Kaleidoscope, 1.0, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied kaleidoscope: duration=%.1f", config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied kaleidoscope: duration=%.1f", config.duration);
             }
             break;
         }
@@ -221,9 +254,10 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             }
 
             if (!imagePath.isEmpty()) {
-                CreateObstructionSource(imagePath.toStdString(), config.imageScale / 100.0);
-                blog(LOG_INFO, "[Obstruction] Applied image overlay: %s, scale=%.0f%%",
-                     imagePath.toStdString().c_str(), config.imageScale);
+                CreateObstructionSource(imagePath.toStdString(), config.imageScale / 100.0,
+                                        config.amount.ToUnits(), config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied image overlay: %s, scale=%.0f%%",
+                           imagePath.toStdString().c_str(), config.imageScale);
             }
             break;
         }
@@ -246,16 +280,17 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             }
 
             if (!videoPath.isEmpty()) {
-                CreateObstructionSource(videoPath.toStdString(), 1.0);
-                blog(LOG_INFO, "[Obstruction] Applied video overlay: %s", videoPath.toStdString().c_str());
+                CreateObstructionSource(videoPath.toStdString(), 1.0, config.amount.ToUnits(), config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied video overlay: %s", videoPath.toStdString().c_str());
             }
             break;
         }
 
         case EffectAction::ShrinkScreen: {
             // Apply screen shrink
-            ShrinkMainSource(config.shrinkPercentage);
-            blog(LOG_INFO, "[Obstruction] Applied screen shrink: %.0f%%", config.shrinkPercentage);
+            ShrinkMainSource(config.shrinkPercentage, config.shrinkSmooth,
+                             static_cast<EasingCurve>(config.shrinkEasing), config.shrinkAnimDuration);
+            PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied screen shrink: %.0f%%", config.shrinkPercentage);
             break;
         }
 
@@ -266,8 +301,8 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
                 const char* particleTypeStr = (config.particleType == 0) ? "爆発" :
                                              (config.particleType == 1) ? "雨" :
                                              (config.particleType == 2) ? "雪" : "星";
-                blog(LOG_INFO, "[Obstruction] Applied particle effect: type=%s, count=%d, duration=%.1f",
-                     particleTypeStr, config.particleCount, config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied particle effect: type=%s, count=%d, duration=%.1f",
+                           particleTypeStr, config.particleCount, config.duration);
             }
             break;
         }
@@ -276,13 +311,13 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
             // Apply random shapes effect
             if (m_effectManager && mainSource) {
                 m_effectManager->ApplyEffect(mainSource, EffectType::RandomShapes, 1.0, config.duration);
-                blog(LOG_INFO, "[Obstruction] Applied random shapes: duration=%.1f", config.duration);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Applied random shapes: duration=%.1f", config.duration);
             }
             break;
         }
 
         default:
-            blog(LOG_WARNING, "[Obstruction] Unknown effect action: %d", static_cast<int>(config.action));
+            PLUGIN_LOG(LogCategory::Obstruction, LOG_WARNING, "[Obstruction] Unknown effect action: %d", static_cast<int>(config.action));
             break;
     }
 
@@ -292,9 +327,11 @@ void ObstructionManager::ApplyConfiguredEffect(const EffectSettings& config) {
 }
 
 void ObstructionManager::ApplyRecovery(double amount) {
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
     if (!m_enabled) return;
 
-    blog(LOG_INFO, "[Recovery] Applying recovery for amount: %.2f JPY", amount);
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Applying recovery for amount: %.2f JPY", amount);
 
     // Scale recovery based on donation amount
     double intensity = std::min(amount / 10000.0, 1.0);
@@ -310,9 +347,11 @@ void ObstructionManager::ApplyRecovery(double amount) {
     }
 }
 
-void ObstructionManager::ExpandMainSource(double percentage) {
+void ObstructionManager::ExpandMainSource(double percentage, bool smooth, EasingCurve curve, double animDuration) {
     if (m_mainSourceName.empty()) return;
 
+    double fromScale = 1.0 - (m_currentShrinkPercentage / 100.0);
+
     // Reduce shrink percentage (but don't go negative)
     m_currentShrinkPercentage = std::max(m_currentShrinkPercentage - percentage, 0.0);
 
@@ -322,85 +361,65 @@ void ObstructionManager::ExpandMainSource(double percentage) {
     // Calculate new scale
     double scale = 1.0 - (m_currentShrinkPercentage / 100.0);
 
-    UpdateSourceTransform(source, scale);
+    AnimateMainSourceScale(source, fromScale, scale, smooth, curve, animDuration);
 
-    blog(LOG_INFO, "[Recovery] Expanded main source to %.1f%% (remaining shrink: %.1f%%)",
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Expanded main source to %.1f%% (remaining shrink: %.1f%%)",
             scale * 100.0, m_currentShrinkPercentage);
 
     obs_source_release(source);
 }
 
 void ObstructionManager::RemoveRandomObstruction() {
-    // Find active obstructions
-    std::vector<size_t> activeIndices;
-    for (size_t i = 0; i < m_obstructions.size(); ++i) {
-        if (m_obstructions[i].active) {
-            activeIndices.push_back(i);
-        }
-    }
-
-    if (activeIndices.empty()) {
-        blog(LOG_INFO, "[Recovery] No active obstructions to remove");
+    if (m_obstructions.Empty()) {
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] No active obstructions to remove");
         return;
     }
 
-    // Select random obstruction
-    std::uniform_int_distribution<size_t> dist(0, activeIndices.size() - 1);
-    size_t indexToRemove = activeIndices[dist(m_randomEngine)];
+    // Every stored obstruction is active, so a dense index is a uniform pick
+    std::uniform_int_distribution<size_t> dist(0, m_obstructions.Size() - 1);
+    size_t indexToRemove = dist(m_randomEngine);
 
-    RemoveObstructionSource(m_obstructions[indexToRemove]);
-    m_obstructions.erase(m_obstructions.begin() + indexToRemove);
+    RemoveObstructionSource(m_obstructions.At(indexToRemove));
+    m_obstructions.RemoveAt(indexToRemove);
+    PublishOverlayCount();
 
-    blog(LOG_INFO, "[Recovery] Removed obstruction (%zu active remaining)",
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Removed obstruction (%d active remaining)",
             GetActiveObstructionCount());
 }
 
 void ObstructionManager::ClearAllObstructions() {
-    blog(LOG_INFO, "[Recovery] Clearing all obstructions");
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Clearing all obstructions");
 
     // First, clear tracked obstructions
     for (auto& obstruction : m_obstructions) {
         RemoveObstructionSource(obstruction);
     }
-    m_obstructions.clear();
-
-    // Also search for and remove any orphaned obstruction sources from all scenes
-    // This handles obstructions that may have been left over from previous OBS sessions
-    auto removeOrphanedObstructions = [](void* param, obs_source_t* source) -> bool {
-        const char* sourceName = obs_source_get_name(source);
-        std::string name(sourceName ? sourceName : "");
-
-        // Check if this is an obstruction source (starts with "Obstruction" or contains "obstruction")
-        if (name.find("Obstruction") != std::string::npos ||
-            name.find("obstruction") != std::string::npos) {
-
-            // Get current scene
-            obs_source_t* sceneSource = obs_frontend_get_current_scene();
-            if (sceneSource) {
-                obs_scene_t* scene = obs_scene_from_source(sceneSource);
-                if (scene) {
-                    // Find and remove the scene item
-                    obs_sceneitem_t* item = obs_scene_find_source(scene, sourceName);
-                    if (item) {
-                        obs_sceneitem_remove(item);
-                        blog(LOG_INFO, "[Recovery] Removed orphaned obstruction: %s", sourceName);
-                    }
-                }
-                obs_source_release(sceneSource);
-            }
-        }
-        return true;
-    };
+    m_obstructions.Clear();
+
+    for (auto& obstruction : m_fadingObstructions) {
+        RemoveObstructionSource(obstruction);
+    }
+    m_fadingObstructions.clear();
+    PublishOverlayCount();
 
-    obs_enum_sources(removeOrphanedObstructions, nullptr);
+    m_expiryHeap = {};
+    m_expiryTimer->stop();
+    m_fadeTimer->stop();
+    m_placer.Clear();
 
     // Clear all visual effects
     if (m_effectManager) {
         m_effectManager->ClearAllEffects();
-        blog(LOG_INFO, "[Recovery] Cleared all visual effects");
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Cleared all visual effects");
     }
 
+    // Sweep anything the plugin still owns (particles, shapes, ...) in every scene
+    SourceRegistry::Instance().RemoveAll();
+
     // Reset main source completely to original transform
+    m_tweens.Cancel(MAIN_SOURCE_SCALE_TWEEN);
     m_currentShrinkPercentage = 0.0;
     if (!m_mainSourceName.empty()) {
         obs_source_t* source = FindSourceByName(m_mainSourceName);
@@ -413,8 +432,8 @@ void ObstructionManager::ClearAllObstructions() {
                     obs_sceneitem_set_pos(sceneItem, &m_originalPos);
                     obs_sceneitem_set_rot(sceneItem, m_originalRotation);
 
-                    blog(LOG_INFO, "[Recovery] Restored to original transform: scale=(%.2f, %.2f), pos=(%.2f, %.2f), rot=%.2f",
-                         m_originalScale.x, m_originalScale.y, m_originalPos.x, m_originalPos.y, m_originalRotation);
+                    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Restored to original transform: scale=(%.2f, %.2f), pos=(%.2f, %.2f), rot=%.2f",
+                               m_originalScale.x, m_originalScale.y, m_originalPos.x, m_originalPos.y, m_originalRotation);
                 } else {
                     // Fallback to default reset
                     struct vec2 scaleVec;
@@ -423,7 +442,7 @@ void ObstructionManager::ClearAllObstructions() {
                     obs_sceneitem_set_scale(sceneItem, &scaleVec);
                     obs_sceneitem_set_rot(sceneItem, 0.0f);
 
-                    blog(LOG_INFO, "[Recovery] Reset to default transform (scale=100%%, rotation=0°)");
+                    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Reset to default transform (scale=100%%, rotation=0°)");
                 }
 
                 // Make sure source is visible
@@ -434,17 +453,17 @@ void ObstructionManager::ClearAllObstructions() {
             auto removeAllFilters = [](obs_source_t* parent, obs_source_t* filter, void* param) {
                 const char* filterName = obs_source_get_name(filter);
                 obs_source_filter_remove(parent, filter);
-                blog(LOG_INFO, "[Recovery] Removed filter: %s", filterName);
+                PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Removed filter: %s", filterName);
             };
 
             obs_source_enum_filters(source, removeAllFilters, nullptr);
 
             obs_source_release(source);
-            blog(LOG_INFO, "[Recovery] Main source '%s' fully reset", m_mainSourceName.c_str());
+            PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] Main source '%s' fully reset", m_mainSourceName.c_str());
         }
     }
 
-    blog(LOG_INFO, "[Recovery] All obstructions cleared and screen fully restored");
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Recovery] All obstructions cleared and screen fully restored");
 }
 
 void ObstructionManager::SaveOriginalTransform(obs_sceneitem_t* sceneItem) {
@@ -456,11 +475,13 @@ void ObstructionManager::SaveOriginalTransform(obs_sceneitem_t* sceneItem) {
 
     m_originalTransformSaved = true;
 
-    blog(LOG_INFO, "[Obstruction] Saved original transform: scale=(%.2f, %.2f), pos=(%.2f, %.2f), rot=%.2f",
-         m_originalScale.x, m_originalScale.y, m_originalPos.x, m_originalPos.y, m_originalRotation);
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Saved original transform: scale=(%.2f, %.2f), pos=(%.2f, %.2f), rot=%.2f",
+               m_originalScale.x, m_originalScale.y, m_originalPos.x, m_originalPos.y, m_originalRotation);
 }
 
 void ObstructionManager::SetMainSourceName(const std::string& name) {
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
     m_mainSourceName = name;
     m_originalTransformSaved = false;  // Reset when changing main source
 
@@ -476,17 +497,25 @@ void ObstructionManager::SetMainSourceName(const std::string& name) {
         }
     }
 
-    blog(LOG_INFO, "[Obstruction] Main source set to: %s", name.c_str());
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Main source set to: %s", name.c_str());
 }
 
 void ObstructionManager::SetObstructionAssetPath(const std::string& path) {
     m_assetPath = path;
-    blog(LOG_INFO, "[Obstruction] Asset path set to: %s", path.c_str());
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Asset path set to: %s", path.c_str());
 }
 
-int ObstructionManager::GetActiveObstructionCount() const {
-    return static_cast<int>(std::count_if(m_obstructions.begin(), m_obstructions.end(),
-                                          [](const ObstructionSource& o) { return o.active; }));
+void ObstructionManager::SetOverlayLifetime(double seconds) {
+    m_overlayLifetime = std::max(seconds, 0.0);
+}
+
+void ObstructionManager::SetMaxOverlays(int maxOverlays) {
+    m_maxOverlays = std::max(maxOverlays, 0);
+
+    // Apply a lowered cap right away instead of waiting for the next overlay
+    while (m_maxOverlays > 0 && GetActiveObstructionCount() > m_maxOverlays) {
+        EvictForCapacity();
+    }
 }
 
 obs_source_t* ObstructionManager::FindSourceByName(const std::string& name) {
@@ -512,7 +541,7 @@ obs_sceneitem_t* ObstructionManager::FindSceneItemForSource(obs_source_t* source
 void ObstructionManager::UpdateSourceTransform(obs_source_t* source, double scale) {
     obs_sceneitem_t* sceneItem = FindSceneItemForSource(source);
     if (!sceneItem) {
-        blog(LOG_WARNING, "[Obstruction] Scene item not found for source");
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_WARNING, "[Obstruction] Scene item not found for source");
         return;
     }
 
@@ -528,6 +557,50 @@ void ObstructionManager::UpdateSourceTransform(obs_source_t* source, double scal
     obs_sceneitem_set_scale(sceneItem, &scaleVec);
 }
 
+void ObstructionManager::AnimateMainSourceScale(obs_source_t* source, double fromScale, double toScale,
+                                                bool smooth, EasingCurve curve, double animDuration) {
+    if (!smooth || animDuration <= 0.0) {
+        m_tweens.Cancel(MAIN_SOURCE_SCALE_TWEEN);
+        UpdateSourceTransform(source, toScale);
+        return;
+    }
+
+    // The source is looked up again every frame; it may be renamed or removed mid-animation
+    m_tweens.AnimateTo(MAIN_SOURCE_SCALE_TWEEN, fromScale, toScale, animDuration, curve,
+        [this](double scale) {
+            OBS_CALL_SCOPE(CALL_SCOPE);
+            obs_source_t* mainSource = FindSourceByName(m_mainSourceName);
+            if (!mainSource) return;
+            UpdateSourceTransform(mainSource, scale);
+            obs_source_release(mainSource);
+        });
+}
+
+void ObstructionManager::UpdateCoverTarget() {
+    m_placer.ClearCoverTarget();
+    if (m_mainSourceName.empty()) return;
+
+    obs_source_t* source = FindSourceByName(m_mainSourceName);
+    if (!source) return;
+
+    obs_sceneitem_t* sceneItem = FindSceneItemForSource(source);
+    if (sceneItem) {
+        // Axis-aligned bounds of the main source (rotation is ignored)
+        struct vec2 pos, scale;
+        obs_sceneitem_get_pos(sceneItem, &pos);
+        obs_sceneitem_get_scale(sceneItem, &scale);
+
+        PlacementRect target;
+        target.x = pos.x;
+        target.y = pos.y;
+        target.width = obs_source_get_width(source) * scale.x;
+        target.height = obs_source_get_height(source) * scale.y;
+        m_placer.SetCoverTarget(target);
+    }
+
+    obs_source_release(source);
+}
+
 std::string ObstructionManager::SelectRandomObstructionAsset() {
     if (m_assetPath.empty()) {
         // Use default obstruction (solid color overlay)
@@ -550,7 +623,7 @@ std::string ObstructionManager::SelectRandomObstructionAsset() {
             }
         }
     } catch (const fs::filesystem_error& e) {
-        blog(LOG_ERROR, "[Obstruction] Failed to read asset directory: %s", e.what());
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_ERROR, "[Obstruction] Failed to read asset directory: %s", e.what());
         return "builtin:color";
     }
 
@@ -563,7 +636,13 @@ std::string ObstructionManager::SelectRandomObstructionAsset() {
     return assets[dist(m_randomEngine)];
 }
 
-void ObstructionManager::CreateObstructionSource(const std::string& assetPath, double intensity) {
+void ObstructionManager::CreateObstructionSource(const std::string& assetPath, double intensity,
+                                                 double value, double lifetime) {
+    // Make room first so the cap holds for active overlays at all times
+    while (m_maxOverlays > 0 && GetActiveObstructionCount() >= m_maxOverlays) {
+        EvictForCapacity();
+    }
+
     obs_source_t* source = nullptr;
     std::string type;
 
@@ -591,24 +670,26 @@ void ObstructionManager::CreateObstructionSource(const std::string& assetPath, d
             obs_data_set_bool(settings, "is_local_file", true);
             source = obs_source_create("ffmpeg_source", "Obstruction Video", settings, nullptr);
             type = "video";
-            blog(LOG_INFO, "[Obstruction] Creating video source: %s", assetPath.c_str());
+            PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Creating video source: %s", assetPath.c_str());
         } else {
             // Use image_source for static images
             obs_data_set_string(settings, "unload", "false");
             source = obs_source_create("image_source", "Obstruction Image", settings, nullptr);
             type = "image";
-            blog(LOG_INFO, "[Obstruction] Creating image source: %s", assetPath.c_str());
+            PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Creating image source: %s", assetPath.c_str());
         }
 
         obs_data_release(settings);
     }
 
     if (!source) {
-        blog(LOG_ERROR, "[Obstruction] Failed to create obstruction source");
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_ERROR, "[Obstruction] Failed to create obstruction source");
         return;
     }
 
     // Add to current scene
+    obs_sceneitem_t* sceneItem = nullptr;
+    PlacementRect placement{0.0f, 0.0f, 0.0f, 0.0f};
     obs_source_t* sceneSource = obs_frontend_get_current_scene();
     if (sceneSource) {
         obs_scene_t* currentScene = obs_scene_from_source(sceneSource);
@@ -618,17 +699,12 @@ void ObstructionManager::CreateObstructionSource(const std::string& assetPath, d
             return;
         }
 
-        obs_sceneitem_t* sceneItem = obs_scene_add(currentScene, source);
-
-        // Position randomly on screen
-        std::uniform_int_distribution<int> xDist(0, 1920 - 200);
-        std::uniform_int_distribution<int> yDist(0, 1080 - 200);
-
-        struct vec2 pos;
-        vec2_set(&pos, static_cast<float>(xDist(m_randomEngine)),
-                       static_cast<float>(yDist(m_randomEngine)));
-
-        obs_sceneitem_set_pos(sceneItem, &pos);
+        sceneItem = SourceRegistry::Instance().AddToScene(currentScene, source);
+        if (!sceneItem) {
+            obs_source_release(sceneSource);
+            obs_source_release(source);
+            return;
+        }
 
         // Set scale based on intensity
         // For image/video overlay: intensity is imageScale / 100.0 (e.g., 1.0 = 100%, 1.5 = 150%)
@@ -642,7 +718,26 @@ void ObstructionManager::CreateObstructionSource(const std::string& assetPath, d
         vec2_set(&scale, scaleValue, scaleValue);
         obs_sceneitem_set_scale(sceneItem, &scale);
 
-        blog(LOG_INFO, "[Obstruction] Set scale to %.2f for %s", scaleValue, type.c_str());
+        // Place on the canvas, away from (or, in cover mode, over the main source instead of) other overlays.
+        // Videos report 0x0 until the first frame decodes, so fall back to the color source size.
+        uint32_t canvasWidth, canvasHeight;
+        GetCanvasSize(&canvasWidth, &canvasHeight);
+        m_placer.SetCanvas(static_cast<float>(canvasWidth), static_cast<float>(canvasHeight));
+        if (m_placer.GetMode() == PlacementMode::CoverMainSource) {
+            UpdateCoverTarget();
+        }
+
+        uint32_t sourceWidth = obs_source_get_width(source);
+        uint32_t sourceHeight = obs_source_get_height(source);
+        float overlayWidth = (sourceWidth > 0 ? sourceWidth : 200) * scaleValue;
+        float overlayHeight = (sourceHeight > 0 ? sourceHeight : 200) * scaleValue;
+        placement = m_placer.Place(overlayWidth, overlayHeight, m_randomEngine);
+
+        struct vec2 pos;
+        vec2_set(&pos, placement.x, placement.y);
+        obs_sceneitem_set_pos(sceneItem, &pos);
+
+        PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Set scale to %.2f for %s", scaleValue, type.c_str());
 
         obs_source_release(sceneSource);
     }
@@ -650,35 +745,165 @@ void ObstructionManager::CreateObstructionSource(const std::string& assetPath, d
     // Store obstruction info
     ObstructionSource obstruction;
     obstruction.source = source;
+    obstruction.sceneItem = sceneItem;
+    obstruction.fadeFilter = nullptr;
     obstruction.type = type;
     obstruction.intensity = intensity;
+    obstruction.value = value;
+    obstruction.id = m_nextObstructionId++;
+    obstruction.expiresAt = 0;
+    obstruction.fadeStartedAt = 0;
     obstruction.active = true;
 
-    m_obstructions.push_back(obstruction);
+    if (lifetime > 0.0) {
+        obstruction.expiresAt = os_gettime_ns() + static_cast<uint64_t>(lifetime * 1000000000.0);
+    }
+
+    SlotHandle handle = m_obstructions.Insert(obstruction);
+    PublishOverlayCount();
+    if (sceneItem) {
+        m_placer.Insert(obstruction.id, placement);
+    }
+
+    if (obstruction.expiresAt != 0) {
+        m_expiryHeap.push({obstruction.expiresAt, handle});
+        ArmExpiryTimer();
+    }
 
-    blog(LOG_INFO, "[Obstruction] Created %s obstruction (total: %d)",
-            type.c_str(), GetActiveObstructionCount());
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Created %s obstruction (total: %d, lifetime: %.1fs)",
+            type.c_str(), GetActiveObstructionCount(), lifetime);
 }
 
 void ObstructionManager::RemoveObstructionSource(ObstructionSource& obstruction) {
     if (!obstruction.active || !obstruction.source) return;
 
-    // Remove from scene
-    obs_source_t* sceneSource = obs_frontend_get_current_scene();
-    if (sceneSource) {
-        obs_scene_t* currentScene = obs_scene_from_source(sceneSource);
-        if (currentScene) {
-            obs_sceneitem_t* sceneItem = obs_scene_find_source(currentScene,
-                                                               obs_source_get_name(obstruction.source));
-            if (sceneItem) {
-                obs_sceneitem_remove(sceneItem);
-            }
-        }
-        obs_source_release(sceneSource);
+    m_placer.Remove(obstruction.id);
+
+    // Remove from whichever scene it was added to
+    if (obstruction.sceneItem) {
+        SourceRegistry::Instance().Remove(obstruction.sceneItem);
+        obstruction.sceneItem = nullptr;
+    }
+
+    // Release fade filter and source
+    if (obstruction.fadeFilter) {
+        obs_source_filter_remove(obstruction.source, obstruction.fadeFilter);
+        obs_source_release(obstruction.fadeFilter);
+        obstruction.fadeFilter = nullptr;
     }
 
-    // Release source
     obs_source_release(obstruction.source);
     obstruction.source = nullptr;
     obstruction.active = false;
 }
+
+void ObstructionManager::EvictForCapacity() {
+    if (m_obstructions.Empty()) return;
+
+    auto victim = m_obstructions.begin();
+    if (m_evictionPolicy == OverlayEvictionPolicy::LowestValueFirst) {
+        // Ties go to the older overlay
+        victim = std::min_element(m_obstructions.begin(), m_obstructions.end(),
+            [](const ObstructionSource& a, const ObstructionSource& b) {
+                return a.value < b.value || (a.value == b.value && a.id < b.id);
+            });
+    } else {
+        victim = std::min_element(m_obstructions.begin(), m_obstructions.end(),
+            [](const ObstructionSource& a, const ObstructionSource& b) { return a.id < b.id; });
+    }
+
+    PLUGIN_LOG(LogCategory::Obstruction, LOG_INFO, "[Obstruction] Overlay cap (%d) reached, evicting %s overlay (value: %.0f)",
+               m_maxOverlays, victim->type.c_str(), victim->value);
+
+    BeginFadeOut(m_obstructions.HandleAt(static_cast<size_t>(victim - m_obstructions.begin())));
+}
+
+void ObstructionManager::BeginFadeOut(SlotHandle handle) {
+    ObstructionSource* found = m_obstructions.Get(handle);
+    if (!found) return;
+
+    ObstructionSource obstruction = *found;
+    m_obstructions.Remove(handle);
+    PublishOverlayCount();
+
+    // Opacity is animated through a color filter; without one the overlay is removed immediately
+    obs_data_t* settings = obs_data_create();
+    obs_data_set_double(settings, "opacity", 1.0);
+    obstruction.fadeFilter = obs_source_create_private("color_filter_v2", "obstruction_fade_filter", settings);
+    obs_data_release(settings);
+
+    if (!obstruction.fadeFilter) {
+        RemoveObstructionSource(obstruction);
+        return;
+    }
+
+    obs_source_filter_add(obstruction.source, obstruction.fadeFilter);
+    obstruction.fadeStartedAt = os_gettime_ns();
+    m_fadingObstructions.push_back(obstruction);
+    PublishOverlayCount();
+
+    if (!m_fadeTimer->isActive()) {
+        m_fadeTimer->start();
+    }
+}
+
+void ObstructionManager::ArmExpiryTimer() {
+    if (m_expiryHeap.empty()) {
+        m_expiryTimer->stop();
+        return;
+    }
+
+    uint64_t now = os_gettime_ns();
+    uint64_t next = m_expiryHeap.top().expiresAt;
+    int delayMs = next > now ? static_cast<int>((next - now + 999999) / 1000000) : 0;
+    m_expiryTimer->start(delayMs);
+}
+
+void ObstructionManager::OnExpiryTimer() {
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
+    uint64_t now = os_gettime_ns();
+
+    while (!m_expiryHeap.empty() && m_expiryHeap.top().expiresAt <= now) {
+        OverlayExpiry expiry = m_expiryHeap.top();
+        m_expiryHeap.pop();
+
+        // Stale handles (overlay already removed by recovery, eviction or reset) are ignored
+        BeginFadeOut(expiry.handle);
+    }
+
+    ArmExpiryTimer();
+}
+
+void ObstructionManager::OnFadeTick() {
+    OBS_CALL_SCOPE(CALL_SCOPE);
+
+    uint64_t now = os_gettime_ns();
+
+    for (size_t i = 0; i < m_fadingObstructions.size();) {
+        ObstructionSource& obstruction = m_fadingObstructions[i];
+        double progress = static_cast<double>(now - obstruction.fadeStartedAt) / 1000000000.0 / OVERLAY_FADE_SECONDS;
+
+        if (progress >= 1.0) {
+            RemoveObstructionSource(obstruction);
+            m_fadingObstructions[i] = m_fadingObstructions.back();
+            m_fadingObstructions.pop_back();
+            continue;
+        }
+
+        obs_data_t* settings = obs_source_get_settings(obstruction.fadeFilter);
+        obs_data_set_double(settings, "opacity", 1.0 - progress);
+        obs_source_update(obstruction.fadeFilter, settings);
+        obs_data_release(settings);
+        ++i;
+    }
+    PublishOverlayCount();
+
+    if (m_fadingObstructions.empty()) {
+        m_fadeTimer->stop();
+    }
+}
+
+void ObstructionManager::PublishOverlayCount() {
+    g_metrics.overlaySources.store(m_obstructions.Size() + m_fadingObstructions.size(), std::memory_order_relaxed);
+}
@@ -1,19 +1,37 @@
 #pragma once
 
+#include "slot-map.hpp"
+#include "overlay-placement.hpp"
+#include "tween.hpp"
 #include <obs.h>
 #include <vector>
 #include <string>
 #include <random>
 #include <memory>
+#include <queue>
+#include <cstdint>
 
 // Forward declarations
 class EffectManager;
+class QTimer;
 struct EffectSettings;
 
+// Which overlay is removed first when the overlay cap is reached
+enum class OverlayEvictionPolicy {
+    OldestFirst,        // 古い順
+    LowestValueFirst    // 低額順
+};
+
 struct ObstructionSource {
     obs_source_t* source;
+    obs_sceneitem_t* sceneItem;  // Tracked by SourceRegistry
+    obs_source_t* fadeFilter;  // color_filter_v2 added when the fade-out starts
     std::string type;      // "image" or "video"
     double intensity;      // 0.0 to 1.0
+    double value;          // Donation amount (JPY) that created this overlay
+    uint64_t id;           // Creation sequence number (lower = older)
+    uint64_t expiresAt;    // os_gettime_ns() deadline, 0 = never expires
+    uint64_t fadeStartedAt;
     bool active;
 };
 
@@ -24,15 +42,17 @@ public:
 
     // Obstruction effects (from Super Chat)
     void ApplyObstruction(double amount);
-    void ShrinkMainSource(double percentage);
-    void AddRandomObstruction(double intensity);
+    void ShrinkMainSource(double percentage, bool smooth = true,
+                          EasingCurve curve = EasingCurve::EaseOut, double animDuration = 0.6);
+    void AddRandomObstruction(double intensity, double value = 0.0);
 
     // NEW: Apply specific effect based on configuration
     void ApplyConfiguredEffect(const EffectSettings& config);
 
     // Recovery effects (from Super Sticker)
     void ApplyRecovery(double amount);
-    void ExpandMainSource(double percentage);
+    void ExpandMainSource(double percentage, bool smooth = true,
+                          EasingCurve curve = EasingCurve::EaseOut, double animDuration = 0.6);
     void RemoveRandomObstruction();
     void ClearAllObstructions();
 
@@ -41,25 +61,61 @@ public:
     void SetObstructionAssetPath(const std::string& path);
     void SetEnabled(bool enabled) { m_enabled = enabled; }
 
+    // Overlay lifetime and cap
+    void SetOverlayLifetime(double seconds);   // Default lifetime, 0 = never expire
+    void SetMaxOverlays(int maxOverlays);      // 0 = unlimited
+    void SetEvictionPolicy(OverlayEvictionPolicy policy) { m_evictionPolicy = policy; }
+    void SetPlacementMode(PlacementMode mode) { m_placer.SetMode(mode); }
+
     // State
     double GetCurrentShrinkPercentage() const { return m_currentShrinkPercentage; }
-    int GetActiveObstructionCount() const;
+    int GetActiveObstructionCount() const { return static_cast<int>(m_obstructions.Size()); }
 
 private:
     obs_source_t* FindSourceByName(const std::string& name);
     obs_sceneitem_t* FindSceneItemForSource(obs_source_t* source);
     void UpdateSourceTransform(obs_source_t* source, double scale);
+    void AnimateMainSourceScale(obs_source_t* source, double fromScale, double toScale,
+                                bool smooth, EasingCurve curve, double animDuration);
+    void UpdateCoverTarget();
 
     std::string SelectRandomObstructionAsset();
-    void CreateObstructionSource(const std::string& assetPath, double intensity);
+    void CreateObstructionSource(const std::string& assetPath, double intensity,
+                                 double value, double lifetime);
     void RemoveObstructionSource(ObstructionSource& obstruction);
 
+    // Expiry and eviction
+    struct OverlayExpiry {
+        uint64_t expiresAt;
+        SlotHandle handle;
+        bool operator>(const OverlayExpiry& other) const { return expiresAt > other.expiresAt; }
+    };
+
+    void EvictForCapacity();
+    void BeginFadeOut(SlotHandle handle);
+    void ArmExpiryTimer();
+    void OnExpiryTimer();
+    void OnFadeTick();
+    void PublishOverlayCount();     // Live + fading overlays -> g_metrics
+
     std::string m_mainSourceName;
     std::string m_assetPath;
-    std::vector<ObstructionSource> m_obstructions;
+    SlotMap<ObstructionSource> m_obstructions;  // Active overlays only; Size() is the active count
+    std::vector<ObstructionSource> m_fadingObstructions;
     double m_currentShrinkPercentage;
     bool m_enabled;
 
+    // Expiries are kept in a min-heap; stale entries (already removed overlays) are skipped on pop
+    std::priority_queue<OverlayExpiry, std::vector<OverlayExpiry>, std::greater<OverlayExpiry>> m_expiryHeap;
+    std::unique_ptr<QTimer> m_expiryTimer;  // Single-shot, armed for the earliest expiry
+    std::unique_ptr<QTimer> m_fadeTimer;    // Runs only while overlays are fading out
+    double m_overlayLifetime;
+    int m_maxOverlays;
+    OverlayEvictionPolicy m_evictionPolicy;
+    uint64_t m_nextObstructionId;
+    OverlayPlacer m_placer;  // Occupied overlay rectangles, keyed by ObstructionSource::id
+    TweenEngine m_tweens;    // Main source scale transitions
+
     // Store original transform for reset
     bool m_originalTransformSaved;
     struct vec2 m_originalScale;
@@ -0,0 +1,213 @@
+#include "overlay-placement.hpp"
+#include <obs.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Candidates scored per placement
+static const int PLACEMENT_CANDIDATES = 24;
+
+// Grid cell size in canvas pixels (roughly one small overlay)
+static const float PLACEMENT_CELL_SIZE = 128.0f;
+
+void GetCanvasSize(uint32_t* width, uint32_t* height) {
+    struct obs_video_info ovi;
+    if (obs_get_video_info(&ovi) && ovi.base_width > 0 && ovi.base_height > 0) {
+        *width = ovi.base_width;
+        *height = ovi.base_height;
+    } else {
+        *width = 1920;
+        *height = 1080;
+    }
+}
+
+static float IntersectionArea(const PlacementRect& a, const PlacementRect& b) {
+    float w = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+    float h = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+    return (w > 0.0f && h > 0.0f) ? w * h : 0.0f;
+}
+
+OverlayPlacer::OverlayPlacer()
+    : m_canvasWidth(0.0f)
+    , m_canvasHeight(0.0f)
+    , m_cellSize(PLACEMENT_CELL_SIZE)
+    , m_cols(0)
+    , m_rows(0)
+    , m_mode(PlacementMode::Spread)
+    , m_hasCoverTarget(false)
+    , m_coverTarget{0.0f, 0.0f, 0.0f, 0.0f}
+{
+    SetCanvas(1920.0f, 1080.0f);
+}
+
+void OverlayPlacer::SetCanvas(float width, float height) {
+    if (width == m_canvasWidth && height == m_canvasHeight) return;
+
+    m_canvasWidth = width;
+    m_canvasHeight = height;
+    m_cols = std::max(1, static_cast<int>(std::ceil(width / m_cellSize)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(height / m_cellSize)));
+
+    // Rebuild the grid for the new dimensions
+    m_cells.assign(static_cast<size_t>(m_cols) * m_rows, {});
+    for (const auto& entry : m_rects) {
+        int x0, y0, x1, y1;
+        CellRange(entry.second, &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                m_cells[y * m_cols + x].push_back(entry.first);
+            }
+        }
+    }
+}
+
+void OverlayPlacer::SetCoverTarget(const PlacementRect& rect) {
+    m_coverTarget = rect;
+    m_hasCoverTarget = rect.width > 0.0f && rect.height > 0.0f;
+}
+
+void OverlayPlacer::CellRange(const PlacementRect& rect, int* x0, int* y0, int* x1, int* y1) const {
+    *x0 = std::clamp(static_cast<int>(rect.x / m_cellSize), 0, m_cols - 1);
+    *y0 = std::clamp(static_cast<int>(rect.y / m_cellSize), 0, m_rows - 1);
+    *x1 = std::clamp(static_cast<int>((rect.x + rect.width) / m_cellSize), 0, m_cols - 1);
+    *y1 = std::clamp(static_cast<int>((rect.y + rect.height) / m_cellSize), 0, m_rows - 1);
+}
+
+void OverlayPlacer::Insert(uint64_t id, const PlacementRect& rect) {
+    Remove(id);
+    m_rects[id] = rect;
+
+    int x0, y0, x1, y1;
+    CellRange(rect, &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            m_cells[y * m_cols + x].push_back(id);
+        }
+    }
+}
+
+void OverlayPlacer::Remove(uint64_t id) {
+    auto it = m_rects.find(id);
+    if (it == m_rects.end()) return;
+
+    int x0, y0, x1, y1;
+    CellRange(it->second, &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            auto& cell = m_cells[y * m_cols + x];
+            auto pos = std::find(cell.begin(), cell.end(), id);
+            if (pos != cell.end()) {
+                *pos = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+    m_rects.erase(it);
+}
+
+void OverlayPlacer::Clear() {
+    m_rects.clear();
+    for (auto& cell : m_cells) {
+        cell.clear();
+    }
+}
+
+float OverlayPlacer::OverlapArea(const PlacementRect& rect) {
+    int x0, y0, x1, y1;
+    CellRange(rect, &x0, &y0, &x1, &y1);
+
+    // A rectangle spanning several cells is listed in each of them; count it once
+    m_queryScratch.clear();
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const auto& cell = m_cells[y * m_cols + x];
+            m_queryScratch.insert(m_queryScratch.end(), cell.begin(), cell.end());
+        }
+    }
+    std::sort(m_queryScratch.begin(), m_queryScratch.end());
+    m_queryScratch.erase(std::unique(m_queryScratch.begin(), m_queryScratch.end()), m_queryScratch.end());
+
+    float area = 0.0f;
+    for (uint64_t id : m_queryScratch) {
+        area += IntersectionArea(rect, m_rects[id]);
+    }
+    return area;
+}
+
+float OverlayPlacer::NearestCenterDistance(float cx, float cy, float giveUpDistance) {
+    int cellX = std::clamp(static_cast<int>(cx / m_cellSize), 0, m_cols - 1);
+    int cellY = std::clamp(static_cast<int>(cy / m_cellSize), 0, m_rows - 1);
+    int maxRing = std::max(m_cols, m_rows);
+
+    float best = giveUpDistance;
+    // Search rings of cells outward; stop once the ring is farther than the best hit
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        if ((ring - 1) * m_cellSize > best) break;
+
+        for (int y = cellY - ring; y <= cellY + ring; ++y) {
+            if (y < 0 || y >= m_rows) continue;
+            for (int x = cellX - ring; x <= cellX + ring; ++x) {
+                if (x < 0 || x >= m_cols) continue;
+                // Only the ring border; inner cells were visited already
+                if (y != cellY - ring && y != cellY + ring && x != cellX - ring && x != cellX + ring) continue;
+
+                for (uint64_t id : m_cells[y * m_cols + x]) {
+                    const PlacementRect& r = m_rects[id];
+                    float dx = (r.x + r.width * 0.5f) - cx;
+                    float dy = (r.y + r.height * 0.5f) - cy;
+                    best = std::min(best, std::sqrt(dx * dx + dy * dy));
+                }
+            }
+        }
+    }
+    return best;
+}
+
+PlacementRect OverlayPlacer::Place(float width, float height, std::mt19937& rng) {
+    float maxX = std::max(0.0f, m_canvasWidth - width);
+    float maxY = std::max(0.0f, m_canvasHeight - height);
+
+    // Cover mode samples inside the main source (clamped to the canvas)
+    float minX = 0.0f, minY = 0.0f;
+    float rangeX = maxX, rangeY = maxY;
+    bool cover = m_mode == PlacementMode::CoverMainSource && m_hasCoverTarget;
+    if (cover) {
+        minX = std::clamp(m_coverTarget.x, 0.0f, maxX);
+        minY = std::clamp(m_coverTarget.y, 0.0f, maxY);
+        rangeX = std::clamp(m_coverTarget.x + m_coverTarget.width - width, minX, maxX);
+        rangeY = std::clamp(m_coverTarget.y + m_coverTarget.height - height, minY, maxY);
+    }
+    std::uniform_real_distribution<float> xDist(minX, std::max(minX, rangeX));
+    std::uniform_real_distribution<float> yDist(minY, std::max(minY, rangeY));
+
+    // Poisson-disk radius: the spacing N overlays would have if spread evenly
+    float diskRadius = std::sqrt(m_canvasWidth * m_canvasHeight / static_cast<float>(m_rects.size() + 1)) * 0.5f;
+    float giveUp = std::sqrt(m_canvasWidth * m_canvasWidth + m_canvasHeight * m_canvasHeight);
+
+    PlacementRect best{minX, minY, width, height};
+    float bestScore = -std::numeric_limits<float>::max();
+
+    for (int i = 0; i < PLACEMENT_CANDIDATES; ++i) {
+        PlacementRect candidate{xDist(rng), yDist(rng), width, height};
+        float overlap = OverlapArea(candidate);
+        float score;
+
+        if (cover) {
+            // Maximise newly covered area of the main source
+            score = IntersectionArea(candidate, m_coverTarget) - overlap;
+        } else {
+            float distance = NearestCenterDistance(candidate.x + width * 0.5f, candidate.y + height * 0.5f, giveUp);
+            if (overlap == 0.0f && distance >= diskRadius) {
+                return candidate;  // Satisfies the disk spacing, no need to look further
+            }
+            score = distance - overlap / std::max(1.0f, width + height);
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+
+    return best;
+}
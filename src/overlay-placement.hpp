@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Base (canvas) resolution from obs_get_video_info, 1920x1080 if video is not initialised
+void GetCanvasSize(uint32_t* width, uint32_t* height);
+
+// How new overlays are positioned
+enum class PlacementMode {
+    Spread,             // 画面全体に分散（ポアソンディスク風）
+    CoverMainSource     // メインソースを優先的に覆う
+};
+
+struct PlacementRect {
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+// Picks overlay positions using a uniform grid of occupied rectangles.
+// Each placement scores a fixed number of random candidates (best-candidate sampling),
+// so the cost per overlay stays bounded no matter how many overlays are on screen.
+class OverlayPlacer {
+public:
+    OverlayPlacer();
+
+    void SetCanvas(float width, float height);
+    void SetMode(PlacementMode mode) { m_mode = mode; }
+    PlacementMode GetMode() const { return m_mode; }
+    void SetCoverTarget(const PlacementRect& rect);
+    void ClearCoverTarget() { m_hasCoverTarget = false; }
+
+    // Returns the rectangle (top-left position + size) for a new overlay
+    PlacementRect Place(float width, float height, std::mt19937& rng);
+
+    void Insert(uint64_t id, const PlacementRect& rect);
+    void Remove(uint64_t id);
+    void Clear();
+
+private:
+    void CellRange(const PlacementRect& rect, int* x0, int* y0, int* x1, int* y1) const;
+    float OverlapArea(const PlacementRect& rect);
+    float NearestCenterDistance(float cx, float cy, float giveUpDistance);
+
+    float m_canvasWidth;
+    float m_canvasHeight;
+    float m_cellSize;
+    int m_cols;
+    int m_rows;
+
+    PlacementMode m_mode;
+    bool m_hasCoverTarget;
+    PlacementRect m_coverTarget;
+
+    std::unordered_map<uint64_t, PlacementRect> m_rects;
+    std::vector<std::vector<uint64_t>> m_cells;  // Ids of rectangles overlapping each cell
+    std::vector<uint64_t> m_queryScratch;
+};
@@ -0,0 +1,178 @@
+#include "plugin-log.hpp"
+#include <util/platform.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+static const auto FLUSH_INTERVAL = std::chrono::milliseconds(20);
+static const uint64_t SUPPRESSED_REPORT_INTERVAL_NS = 1000000000ULL;
+
+const char* LogCategoryName(LogCategory category) {
+    switch (category) {
+    case LogCategory::Chat:        return "Chat";
+    case LogCategory::Effects:     return "Effects";
+    case LogCategory::Obstruction: return "Obstruction";
+    case LogCategory::Pipeline:    return "Pipeline";
+    default:                       return "?";
+    }
+}
+
+int ParseLogLevel(const char* name, int fallback) {
+    if (!name) return fallback;
+    if (std::strcmp(name, "error") == 0) return LOG_ERROR;
+    if (std::strcmp(name, "warning") == 0) return LOG_WARNING;
+    if (std::strcmp(name, "info") == 0) return LOG_INFO;
+    if (std::strcmp(name, "debug") == 0) return LOG_DEBUG;
+    return fallback;
+}
+
+PluginLog& PluginLog::Instance() {
+    static PluginLog instance;
+    return instance;
+}
+
+PluginLog::PluginLog()
+    : m_ring(RING_SIZE)
+{
+    static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of two");
+    for (std::atomic<int>& level : m_levels) {
+        level.store(LOG_INFO, std::memory_order_relaxed);
+    }
+}
+
+PluginLog::~PluginLog() {
+    Stop();
+}
+
+void PluginLog::Start() {
+    if (m_running.load(std::memory_order_acquire)) return;
+
+    m_producer = std::this_thread::get_id();
+    m_running.store(true, std::memory_order_release);
+    m_flusher = std::thread(&PluginLog::FlushLoop, this);
+}
+
+void PluginLog::Stop() {
+    if (!m_running.load(std::memory_order_acquire)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running.store(false, std::memory_order_release);
+    }
+    m_wake.notify_one();
+    if (m_flusher.joinable()) {
+        m_flusher.join();
+    }
+
+    // Anything published after the flusher's last pass
+    Drain();
+    ReportSuppressed();
+}
+
+void PluginLog::SetLevel(LogCategory category, int level) {
+    m_levels[static_cast<size_t>(category)].store(level, std::memory_order_relaxed);
+}
+
+void PluginLog::SetRateLimit(double recordsPerSecond, double burst) {
+    m_rate = std::max(1.0, recordsPerSecond);
+    m_burst = std::max(1.0, burst);
+}
+
+bool PluginLog::Admit(LogCategory category) {
+    Bucket& bucket = m_buckets[static_cast<size_t>(category)];
+
+    uint64_t now = os_gettime_ns();
+    if (bucket.lastRefillNs != 0) {
+        bucket.tokens = std::min(m_burst, bucket.tokens + (now - bucket.lastRefillNs) / 1e9 * m_rate);
+    }
+    bucket.lastRefillNs = now;
+
+    if (bucket.tokens >= 1.0) {
+        bucket.tokens -= 1.0;
+        bucket.overBudget = 0;
+        return true;
+    }
+
+    // Over budget: keep a sample so a flood still shows up in the log
+    if (bucket.overBudget++ % SAMPLE_EVERY == 0) return true;
+
+    m_suppressed[static_cast<size_t>(category)].fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void PluginLog::Write(LogCategory category, int level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (!m_running.load(std::memory_order_acquire) || std::this_thread::get_id() != m_producer) {
+        blogva(level, format, args);
+        va_end(args);
+        return;
+    }
+
+    if (!Admit(category)) {
+        va_end(args);
+        return;
+    }
+
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= RING_SIZE) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        va_end(args);
+        return;
+    }
+
+    Record& record = m_ring[head & (RING_SIZE - 1)];
+    record.level = level;
+    std::vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+void PluginLog::FlushLoop() {
+    uint64_t lastReportNs = os_gettime_ns();
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (m_running.load(std::memory_order_acquire)) {
+        m_wake.wait_for(lock, FLUSH_INTERVAL);
+
+        lock.unlock();
+        Drain();
+        uint64_t now = os_gettime_ns();
+        if (now - lastReportNs >= SUPPRESSED_REPORT_INTERVAL_NS) {
+            ReportSuppressed();
+            lastReportNs = now;
+        }
+        lock.lock();
+    }
+}
+
+void PluginLog::Drain() {
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    uint64_t head = m_head.load(std::memory_order_acquire);
+
+    while (tail != head) {
+        const Record& record = m_ring[tail & (RING_SIZE - 1)];
+        blog(record.level, "%s", record.text);
+        tail++;
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+void PluginLog::ReportSuppressed() {
+    for (size_t i = 0; i < m_suppressed.size(); i++) {
+        uint64_t suppressed = m_suppressed[i].exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0) {
+            blog(LOG_WARNING, "[Log] %llu %s messages suppressed by the rate limit",
+                 static_cast<unsigned long long>(suppressed), LogCategoryName(static_cast<LogCategory>(i)));
+        }
+    }
+
+    uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        blog(LOG_WARNING, "[Log] %llu messages dropped: log buffer full", static_cast<unsigned long long>(dropped));
+    }
+}
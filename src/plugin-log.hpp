@@ -0,0 +1,109 @@
+#pragma once
+
+#include <util/base.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Subsystems with their own level and rate limit
+enum class LogCategory {
+    Chat,           // Per-message chat processing
+    Effects,        // Effect start/stop
+    Obstruction,    // Overlays, recovery, configured effects
+    Pipeline,       // Donation dispatch
+    Count
+};
+
+const char* LogCategoryName(LogCategory category);
+
+// "error", "warning", "info" or "debug" -> LOG_*; returns fallback for anything else
+int ParseLogLevel(const char* name, int fallback);
+
+// Asynchronous plugin logger for the UI-thread hot paths.
+//
+// The UI thread formats each record straight into a slot of a single-producer /
+// single-consumer ring and publishes it with one release store; a background thread
+// drains the ring into blog(). Records are filtered per category before formatting and
+// rate limited per category with a token bucket; once a bucket is empty only every
+// SAMPLE_EVERY-th record is kept and the rest are counted and reported as suppressed.
+// A full ring drops records instead of blocking.
+//
+// Writes from any other thread, or while the logger is stopped, go to blog() directly.
+class PluginLog {
+public:
+    static constexpr size_t RING_SIZE = 4096;           // Records; power of two
+    static constexpr size_t MAX_RECORD_BYTES = 256;     // Longer messages are truncated
+    static constexpr double DEFAULT_RATE = 200.0;       // Records per second per category
+    static constexpr double DEFAULT_BURST = 400.0;
+    static constexpr uint32_t SAMPLE_EVERY = 100;
+
+    static PluginLog& Instance();
+
+    // Start on the thread that will produce records (the UI thread); Stop drains the ring
+    void Start();
+    void Stop();
+
+    void SetLevel(LogCategory category, int level);
+    void SetRateLimit(double recordsPerSecond, double burst);
+
+    static bool IsEnabled(LogCategory category, int level) {
+        return level <= Instance().m_levels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 4, 5)))
+#endif
+    void Write(LogCategory category, int level, const char* format, ...);
+
+private:
+    struct Record {
+        int level;
+        char text[MAX_RECORD_BYTES];
+    };
+
+    // Producer-only state
+    struct Bucket {
+        double tokens = DEFAULT_BURST;
+        uint64_t lastRefillNs = 0;
+        uint32_t overBudget = 0;    // Records seen since the bucket ran dry
+    };
+
+    PluginLog();
+    ~PluginLog();
+    PluginLog(const PluginLog&) = delete;
+    PluginLog& operator=(const PluginLog&) = delete;
+
+    bool Admit(LogCategory category);
+    void FlushLoop();
+    void Drain();
+    void ReportSuppressed();
+
+    std::vector<Record> m_ring;
+    alignas(64) std::atomic<uint64_t> m_head{0};    // Next slot to write (producer)
+    alignas(64) std::atomic<uint64_t> m_tail{0};    // Next slot to flush (consumer)
+
+    std::array<std::atomic<int>, static_cast<size_t>(LogCategory::Count)> m_levels;
+    std::array<Bucket, static_cast<size_t>(LogCategory::Count)> m_buckets;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(LogCategory::Count)> m_suppressed{};
+    std::atomic<uint64_t> m_dropped{0};             // Ring was full
+    double m_rate = DEFAULT_RATE;
+    double m_burst = DEFAULT_BURST;
+
+    std::atomic<bool> m_running{false};
+    std::thread::id m_producer;
+    std::thread m_flusher;
+    std::mutex m_wakeMutex;                         // Only for the flusher's timed wait and Stop()
+    std::condition_variable m_wake;
+};
+
+#define PLUGIN_LOG(category, level, ...) \
+    do { \
+        if (PluginLog::IsEnabled(category, level)) { \
+            PluginLog::Instance().Write(category, level, __VA_ARGS__); \
+        } \
+    } while (0)
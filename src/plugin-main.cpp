@@ -1,31 +1,49 @@
 #include "plugin-main.hpp"
 #include "youtube-chat-client.hpp"
+#include "chat-ingestion-hub.hpp"
+#include "currency-table.hpp"
+#include "donation-injector.hpp"
+#include "donation-tracer.hpp"
 #include "obstruction-manager.hpp"
 #include "settings-dialog.hpp"
 #include "effect-config.hpp"
+#include "keyword-trigger.hpp"
+#include "metrics-dock.hpp"
+#include "metrics-exporter.hpp"
+#include "plugin-log.hpp"
+#include "plugin-metrics.hpp"
 #include "room-3d-source.hpp"
+#include "source-registry.hpp"
 
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include <util/config-file.h>
 #include <util/base.h>
+#include <util/platform.h>
 #include <QAction>
 #include <QMainWindow>
 #include <QMenu>
 #include <QMenuBar>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QJsonObject>
+#include <QDateTime>
 #include <QVariant>
 #include <QProcess>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFileInfo>
+#include "obs-call-profiler.hpp"     // Keep last
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 
 // Global instances
-std::unique_ptr<YouTubeChatClient> g_chatClient;
+std::unique_ptr<ChatIngestionHub> g_chatHub;
+std::unique_ptr<DonationInjector> g_donationInjector;
+std::unique_ptr<DonationTracer> g_donationTracer;
+std::unique_ptr<KeywordTriggerEngine> g_keywordTriggers;
+std::unique_ptr<MetricsExporter> g_metricsExporter;
 std::unique_ptr<ObstructionManager> g_obstructionManager;
 std::unique_ptr<SettingsDialog> g_settingsDialog;
 
@@ -41,14 +59,41 @@ void LoadSettings() {
     // Safely load strings (config_get_string can return nullptr)
     const char* apiKey = config_get_string(config, CONFIG_SECTION, "ApiKey");
     const char* videoId = config_get_string(config, CONFIG_SECTION, "VideoId");
+    const char* apiBaseUrl = config_get_string(config, CONFIG_SECTION, "ApiBaseUrl");
 
     g_settings.youtubeApiKey = apiKey ? apiKey : "";
     g_settings.videoId = videoId ? videoId : "";
-
+    g_settings.apiBaseUrl = (apiBaseUrl && apiBaseUrl[0] != '\0') ? apiBaseUrl : DEFAULT_API_BASE_URL;
+
+    g_settings.recordChatSessions = config_get_bool(config, CONFIG_SECTION, "RecordChatSessions");
+    g_settings.skipBacklogOnStart = config_get_bool(config, CONFIG_SECTION, "SkipBacklogOnStart");
+    g_settings.dailyQuota = static_cast<int>(config_get_int(config, CONFIG_SECTION, "DailyQuota"));
+    g_settings.plannedStreamHours = config_get_double(config, CONFIG_SECTION, "PlannedStreamHours");
+    g_settings.enableInjection = config_get_bool(config, CONFIG_SECTION, "EnableInjection");
+    g_settings.injectionPort = static_cast<int>(config_get_int(config, CONFIG_SECTION, "InjectionPort"));
+    g_settings.injectionRateLimit = static_cast<int>(config_get_int(config, CONFIG_SECTION, "InjectionRateLimit"));
+    g_settings.enableMetricsExporter = config_get_bool(config, CONFIG_SECTION, "EnableMetricsExporter");
+    g_settings.metricsPort = static_cast<int>(config_get_int(config, CONFIG_SECTION, "MetricsPort"));
+    g_settings.viewerChatPerMinute = static_cast<int>(config_get_int(config, CONFIG_SECTION, "ViewerChatPerMinute"));
+    g_settings.viewerPaidPerMinute = static_cast<int>(config_get_int(config, CONFIG_SECTION, "ViewerPaidPerMinute"));
+    g_settings.freeChatSamplesPerSecond =
+        static_cast<int>(config_get_int(config, CONFIG_SECTION, "FreeChatSamplesPerSecond"));
     g_settings.enableObstructions = config_get_bool(config, CONFIG_SECTION, "EnableObstructions");
     g_settings.enableRecovery = config_get_bool(config, CONFIG_SECTION, "EnableRecovery");
     g_settings.obstructionIntensity = config_get_double(config, CONFIG_SECTION, "ObstructionIntensity");
     g_settings.recoveryIntensity = config_get_double(config, CONFIG_SECTION, "RecoveryIntensity");
+    g_settings.overlayLifetime = config_get_double(config, CONFIG_SECTION, "OverlayLifetime");
+    g_settings.maxOverlays = static_cast<int>(config_get_int(config, CONFIG_SECTION, "MaxOverlays"));
+    g_settings.overlayEvictionPolicy = static_cast<int>(config_get_int(config, CONFIG_SECTION, "OverlayEvictionPolicy"));
+    g_settings.overlayPlacementMode = static_cast<int>(config_get_int(config, CONFIG_SECTION, "OverlayPlacementMode"));
+
+    // Optional per-category log levels: LogLevelChat=debug, LogLevelEffects=warning, ...
+    for (size_t i = 0; i < static_cast<size_t>(LogCategory::Count); i++) {
+        LogCategory category = static_cast<LogCategory>(i);
+        std::string key = std::string("LogLevel") + LogCategoryName(category);
+        PluginLog::Instance().SetLevel(category,
+                                       ParseLogLevel(config_get_string(config, CONFIG_SECTION, key.c_str()), LOG_INFO));
+    }
 
     // Load effect configurations from JSON
     const char* effectConfigsJson = config_get_string(config, CONFIG_SECTION, "EffectConfigurations");
@@ -67,6 +112,29 @@ void LoadSettings() {
         g_settings.obstructionIntensity = 1.0;
     if (g_settings.recoveryIntensity == 0.0)
         g_settings.recoveryIntensity = 1.0;
+    // 0 is a valid value for these, so only fall back when nothing was ever saved
+    if (!config_has_user_value(config, CONFIG_SECTION, "OverlayLifetime"))
+        g_settings.overlayLifetime = 60.0;
+    if (!config_has_user_value(config, CONFIG_SECTION, "MaxOverlays"))
+        g_settings.maxOverlays = 20;
+    if (!config_has_user_value(config, CONFIG_SECTION, "SkipBacklogOnStart"))
+        g_settings.skipBacklogOnStart = true;
+    if (!config_has_user_value(config, CONFIG_SECTION, "ViewerChatPerMinute"))
+        g_settings.viewerChatPerMinute = DEFAULT_VIEWER_CHAT_PER_MINUTE;
+    if (!config_has_user_value(config, CONFIG_SECTION, "ViewerPaidPerMinute"))
+        g_settings.viewerPaidPerMinute = DEFAULT_VIEWER_PAID_PER_MINUTE;
+    if (!config_has_user_value(config, CONFIG_SECTION, "FreeChatSamplesPerSecond"))
+        g_settings.freeChatSamplesPerSecond = DEFAULT_FREE_CHAT_SAMPLES_PER_SECOND;
+    if (g_settings.dailyQuota <= 0)
+        g_settings.dailyQuota = DEFAULT_DAILY_QUOTA;
+    if (g_settings.plannedStreamHours <= 0.0)
+        g_settings.plannedStreamHours = 8.0;
+    if (g_settings.injectionPort <= 0 || g_settings.injectionPort > 65535)
+        g_settings.injectionPort = DEFAULT_INJECTION_PORT;
+    if (g_settings.injectionRateLimit <= 0)
+        g_settings.injectionRateLimit = DEFAULT_INJECTION_RATE;
+    if (g_settings.metricsPort <= 0 || g_settings.metricsPort > 65535)
+        g_settings.metricsPort = DEFAULT_METRICS_PORT;
 }
 
 void SaveSettings() {
@@ -75,10 +143,27 @@ void SaveSettings() {
 
     config_set_string(config, CONFIG_SECTION, "ApiKey", g_settings.youtubeApiKey.c_str());
     config_set_string(config, CONFIG_SECTION, "VideoId", g_settings.videoId.c_str());
+    config_set_string(config, CONFIG_SECTION, "ApiBaseUrl", g_settings.apiBaseUrl.c_str());
+    config_set_bool(config, CONFIG_SECTION, "RecordChatSessions", g_settings.recordChatSessions);
+    config_set_bool(config, CONFIG_SECTION, "SkipBacklogOnStart", g_settings.skipBacklogOnStart);
+    config_set_int(config, CONFIG_SECTION, "DailyQuota", g_settings.dailyQuota);
+    config_set_double(config, CONFIG_SECTION, "PlannedStreamHours", g_settings.plannedStreamHours);
+    config_set_bool(config, CONFIG_SECTION, "EnableInjection", g_settings.enableInjection);
+    config_set_int(config, CONFIG_SECTION, "InjectionPort", g_settings.injectionPort);
+    config_set_int(config, CONFIG_SECTION, "InjectionRateLimit", g_settings.injectionRateLimit);
+    config_set_bool(config, CONFIG_SECTION, "EnableMetricsExporter", g_settings.enableMetricsExporter);
+    config_set_int(config, CONFIG_SECTION, "MetricsPort", g_settings.metricsPort);
+    config_set_int(config, CONFIG_SECTION, "ViewerChatPerMinute", g_settings.viewerChatPerMinute);
+    config_set_int(config, CONFIG_SECTION, "ViewerPaidPerMinute", g_settings.viewerPaidPerMinute);
+    config_set_int(config, CONFIG_SECTION, "FreeChatSamplesPerSecond", g_settings.freeChatSamplesPerSecond);
     config_set_bool(config, CONFIG_SECTION, "EnableObstructions", g_settings.enableObstructions);
     config_set_bool(config, CONFIG_SECTION, "EnableRecovery", g_settings.enableRecovery);
     config_set_double(config, CONFIG_SECTION, "ObstructionIntensity", g_settings.obstructionIntensity);
     config_set_double(config, CONFIG_SECTION, "RecoveryIntensity", g_settings.recoveryIntensity);
+    config_set_double(config, CONFIG_SECTION, "OverlayLifetime", g_settings.overlayLifetime);
+    config_set_int(config, CONFIG_SECTION, "MaxOverlays", g_settings.maxOverlays);
+    config_set_int(config, CONFIG_SECTION, "OverlayEvictionPolicy", g_settings.overlayEvictionPolicy);
+    config_set_int(config, CONFIG_SECTION, "OverlayPlacementMode", g_settings.overlayPlacementMode);
 
     // Save effect configurations as JSON
     QJsonArray jsonArray = QJsonArray::fromVariantList(g_settings.effectConfigurations);
@@ -90,42 +175,202 @@ void SaveSettings() {
     config_save(config);
 }
 
+// Push overlay lifetime/cap settings to the obstruction manager
+void ApplyObstructionSettings() {
+    if (!g_obstructionManager) return;
+
+    g_obstructionManager->SetOverlayLifetime(g_settings.overlayLifetime);
+    g_obstructionManager->SetMaxOverlays(g_settings.maxOverlays);
+    g_obstructionManager->SetEvictionPolicy(static_cast<OverlayEvictionPolicy>(g_settings.overlayEvictionPolicy));
+    g_obstructionManager->SetPlacementMode(static_cast<PlacementMode>(g_settings.overlayPlacementMode));
+}
+
+// Start, restart or stop the local injection endpoint to match the settings
+void ApplyInjectionSettings() {
+    if (!g_donationInjector) return;
+
+    if (!g_settings.enableInjection) {
+        g_donationInjector->Stop();
+        return;
+    }
+
+    g_donationInjector->SetRateLimit(g_settings.injectionRateLimit);
+    g_donationInjector->Start(static_cast<quint16>(g_settings.injectionPort));
+}
+
+// Start, restart or stop the Prometheus endpoint to match the settings
+void ApplyMetricsExporterSettings() {
+    if (!g_metricsExporter) return;
+
+    if (!g_settings.enableMetricsExporter) {
+        g_metricsExporter->Stop();
+        return;
+    }
+
+    g_metricsExporter->Start(static_cast<quint16>(g_settings.metricsPort));
+}
+
+// Recompile chat keyword triggers from the effect configurations
+void ApplyKeywordTriggerSettings() {
+    if (!g_keywordTriggers) return;
+
+    EffectConfigList configs;
+    configs.FromVariantList(g_settings.effectConfigurations);
+    g_keywordTriggers->Compile(configs);
+}
+
+// Cursors of recently monitored videos, stored as one JSON object keyed by video ID
+static const int MAX_SAVED_CHAT_CURSORS = 16;
+
+static QJsonObject LoadChatCursors(config_t* config) {
+    const char* json = config_get_string(config, CONFIG_SECTION, "ChatCursors");
+    if (!json || json[0] == '\0') return QJsonObject();
+    return QJsonDocument::fromJson(QByteArray(json)).object();
+}
+
+void RestoreChatCursor() {
+    config_t* config = obs_frontend_get_global_config();
+    if (!config || !g_chatHub) return;
+
+    QJsonObject cursors = LoadChatCursors(config);
+    for (size_t i = 0; i < g_chatHub->GetSourceCount(); i++) {
+        YouTubeChatClient* client = g_chatHub->GetSource(i);
+        QJsonObject entry = cursors.value(QString::fromStdString(client->GetVideoId())).toObject();
+        if (entry.isEmpty()) continue;
+
+        ChatCursor cursor;
+        cursor.liveChatId = entry["liveChatId"].toString().toStdString();
+        cursor.pageToken = entry["pageToken"].toString().toStdString();
+        cursor.watermarkMs = static_cast<int64_t>(entry["watermarkMs"].toDouble());
+        client->RestoreCursor(cursor);
+
+        blog(LOG_INFO, "[Settings] Restored chat cursor for video %s", client->GetVideoId().c_str());
+    }
+}
+
+void SaveChatCursor() {
+    config_t* config = obs_frontend_get_global_config();
+    if (!config || !g_chatHub) return;
+
+    QJsonObject cursors = LoadChatCursors(config);
+    double now = static_cast<double>(QDateTime::currentMSecsSinceEpoch());
+    for (size_t i = 0; i < g_chatHub->GetSourceCount(); i++) {
+        YouTubeChatClient* client = g_chatHub->GetSource(i);
+        ChatCursor cursor = client->GetCursor();
+        if (cursor.liveChatId.empty()) continue;
+
+        QJsonObject entry;
+        entry["liveChatId"] = QString::fromStdString(cursor.liveChatId);
+        entry["pageToken"] = QString::fromStdString(cursor.pageToken);
+        entry["watermarkMs"] = static_cast<double>(cursor.watermarkMs);
+        entry["savedAt"] = now;
+        cursors[QString::fromStdString(client->GetVideoId())] = entry;
+    }
+
+    // Forget the least recently saved videos
+    while (cursors.size() > MAX_SAVED_CHAT_CURSORS) {
+        QString oldestKey;
+        double oldestSavedAt = 0.0;
+        for (auto it = cursors.begin(); it != cursors.end(); ++it) {
+            double savedAt = it.value().toObject()["savedAt"].toDouble();
+            if (oldestKey.isEmpty() || savedAt < oldestSavedAt) {
+                oldestKey = it.key();
+                oldestSavedAt = savedAt;
+            }
+        }
+        cursors.remove(oldestKey);
+    }
+
+    QByteArray json = QJsonDocument(cursors).toJson(QJsonDocument::Compact);
+    config_set_string(config, CONFIG_SECTION, "ChatCursors", json.constData());
+    config_save(config);
+}
+
 // Donation callback handler
 void OnDonationReceived(const DonationEvent& event) {
     if (!g_obstructionManager) return;
 
-    blog(LOG_INFO, "[YouTube SuperChat] Donation received: %s - %.2f %s (Type: %s)",
+    PLUGIN_LOG(LogCategory::Pipeline, LOG_INFO, "[YouTube SuperChat] Donation received: %s - %.2f %s = %.0f JPY (Type: %s, Source: %s)",
             event.displayName.c_str(),
-            event.amount,
+            event.originalAmount.ToUnits(),
             event.currency.c_str(),
-            event.type == DonationType::SuperChat ? "SuperChat" : "SuperSticker");
+            event.amount.ToUnits(),
+            DonationTypeName(event.type),
+            event.sourceId.empty() ? "-" : event.sourceId.c_str());
+    g_metrics.RecordDonation(static_cast<size_t>(event.type), event.currency);
 
-    if (event.type == DonationType::SuperChat) {
+    DonationTimestamps timestamps = event.timestamps;
+    bool effectApplied = false;
+
+    if (event.type == DonationType::SuperChat || event.type == DonationType::ChatMessage) {
         // Apply obstruction effects
-        if (g_settings.enableObstructions) {
+        std::vector<EffectSettings> keywordEffects;
+        if (g_settings.enableObstructions && event.type == DonationType::ChatMessage && g_keywordTriggers) {
+            keywordEffects = g_keywordTriggers->Match(event.message);
+        }
+
+        if (!keywordEffects.empty()) {
+            // Keyword rules replace the amount-based effect of a regular chat
+            timestamps.configResolvedNs = os_gettime_ns();
+            for (const EffectSettings& config : keywordEffects) {
+                PLUGIN_LOG(LogCategory::Pipeline, LOG_INFO, "[YouTube SuperChat] Keyword trigger: Action=%d, Duration=%.1f",
+                           static_cast<int>(config.action), config.duration);
+                g_obstructionManager->ApplyConfiguredEffect(config);
+            }
+            effectApplied = true;
+        } else if (g_settings.enableObstructions) {
             // Load effect configurations and find appropriate config for this amount
             EffectConfigList configs;
             configs.FromVariantList(g_settings.effectConfigurations);
 
             EffectSettings config = configs.FindConfigForAmount(event.amount);
+            timestamps.configResolvedNs = os_gettime_ns();
 
-            if (config.amount > 0.0) {
+            if (config.amount.IsPositive()) {
                 // Found a configured effect for this amount
-                blog(LOG_INFO, "[YouTube SuperChat] Using configured effect: Action=%d, Amount=%.2f, Duration=%.1f",
-                     static_cast<int>(config.action), config.amount, config.duration);
+                PLUGIN_LOG(LogCategory::Pipeline, LOG_INFO, "[YouTube SuperChat] Using configured effect: Action=%d, Amount=%.2f, Duration=%.1f",
+                           static_cast<int>(config.action), config.amount.ToUnits(), config.duration);
                 g_obstructionManager->ApplyConfiguredEffect(config);
             } else {
                 // No configuration found, use default behavior
-                blog(LOG_INFO, "[YouTube SuperChat] No configured effect found, using default");
-                g_obstructionManager->ApplyObstruction(event.amount * g_settings.obstructionIntensity);
+                PLUGIN_LOG(LogCategory::Pipeline, LOG_INFO, "[YouTube SuperChat] No configured effect found, using default");
+                g_obstructionManager->ApplyObstruction(event.amount.ToUnits() * g_settings.obstructionIntensity);
             }
+            effectApplied = true;
         }
     } else if (event.type == DonationType::SuperSticker) {
         // Apply recovery effects
         if (g_settings.enableRecovery) {
-            g_obstructionManager->ApplyRecovery(event.amount * g_settings.recoveryIntensity);
+            timestamps.configResolvedNs = os_gettime_ns();
+            g_obstructionManager->ApplyRecovery(event.amount.ToUnits() * g_settings.recoveryIntensity);
+            effectApplied = true;
         }
     }
+
+    if (effectApplied && g_donationTracer) {
+        timestamps.effectStartedNs = os_gettime_ns();
+        g_donationTracer->Submit(event, timestamps);
+    }
+}
+
+// Log per-stage latency and write the retained traces for chrome://tracing / Perfetto
+static void ExportDonationTrace() {
+    if (!g_donationTracer) return;
+
+    for (const std::string& line : g_donationTracer->FormatReport()) {
+        blog(LOG_INFO, "[Tracer] %s", line.c_str());
+    }
+
+    char* traceDir = obs_module_config_path("traces");
+    if (!traceDir) return;
+    QDir().mkpath(QString::fromUtf8(traceDir));
+    QString fileName = QString("donation-trace-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+    QString path = QDir(QString::fromUtf8(traceDir)).filePath(fileName);
+    bfree(traceDir);
+
+    if (g_donationTracer->ExportChromeTrace(path.toStdString())) {
+        blog(LOG_INFO, "[Tracer] Wrote %s", path.toUtf8().constData());
+    }
 }
 
 // Show settings dialog
@@ -152,10 +397,31 @@ void OnFrontendEvent(enum obs_frontend_event event, void* private_data) {
     switch (event) {
     case OBS_FRONTEND_EVENT_FINISHED_LOADING:
         LoadSettings();
+        ApplyObstructionSettings();
+        ApplyInjectionSettings();
+        ApplyMetricsExporterSettings();
+        ApplyKeywordTriggerSettings();
+        if (g_chatHub) {
+            g_chatHub->SetApiBaseUrl(g_settings.apiBaseUrl);
+            g_chatHub->SetRecordingEnabled(g_settings.recordChatSessions);
+            g_chatHub->SetSkipBacklog(g_settings.skipBacklogOnStart);
+            g_chatHub->SetDailyQuota(g_settings.dailyQuota);
+            g_chatHub->SetPlannedStreamHours(g_settings.plannedStreamHours);
+            g_chatHub->SetViewerRateLimits(g_settings.viewerChatPerMinute, g_settings.viewerPaidPerMinute);
+            g_chatHub->SetFreeChatSampleRate(g_settings.freeChatSamplesPerSecond);
+        }
+        {
+            // Clean up overlays/particles a crashed session left in the scene collection
+            int orphans = SourceRegistry::Instance().RemoveOrphans();
+            if (orphans > 0) {
+                blog(LOG_INFO, "[YouTube SuperChat] Removed %d orphaned items from a previous session", orphans);
+            }
+        }
         break;
     case OBS_FRONTEND_EVENT_EXIT:
-        if (g_chatClient && g_chatClient->IsRunning()) {
-            g_chatClient->Stop();
+        if (g_chatHub && g_chatHub->IsRunning()) {
+            g_chatHub->Stop();
+            SaveChatCursor();
         }
         break;
     default:
@@ -166,6 +432,12 @@ void OnFrontendEvent(enum obs_frontend_event event, void* private_data) {
 bool obs_module_load(void) {
     blog(LOG_INFO, "YouTube SuperChat Plugin v%s loaded", PLUGIN_VERSION);
 
+    // Hot-path logging is flushed by a background thread from here on
+    PluginLog::Instance().Start();
+
+    // Exchange rates must be in place before the first chat page is converted
+    CurrencyTable::Instance().Reload();
+
     // Register 3D Room Source
     register_room_3d_source();
 
@@ -185,11 +457,24 @@ bool obs_module_load(void) {
         g_obstructionManager = std::make_unique<ObstructionManager>();
         blog(LOG_INFO, "[YouTube SuperChat] ObstructionManager initialized");
 
-        g_chatClient = std::make_unique<YouTubeChatClient>();
-        blog(LOG_INFO, "[YouTube SuperChat] YouTubeChatClient initialized");
+        g_chatHub = std::make_unique<ChatIngestionHub>();
+        blog(LOG_INFO, "[YouTube SuperChat] ChatIngestionHub initialized");
 
         // Set donation callback
-        g_chatClient->SetDonationCallback(OnDonationReceived);
+        g_chatHub->SetDonationCallback(OnDonationReceived);
+        g_chatHub->SetCursorSaveCallback(SaveChatCursor);
+
+        g_donationTracer = std::make_unique<DonationTracer>();
+        g_keywordTriggers = std::make_unique<KeywordTriggerEngine>();
+        g_metricsExporter = std::make_unique<MetricsExporter>();
+
+        // Local test donations share the hub's queue
+        g_donationInjector = std::make_unique<DonationInjector>();
+        g_donationInjector->SetEventSink([](const DonationEvent& event) {
+            if (g_chatHub) {
+                g_chatHub->Enqueue(event);
+            }
+        });
     } catch (const std::exception& e) {
         blog(LOG_ERROR, "[YouTube SuperChat] Failed to initialize: %s", e.what());
         return false;
@@ -224,6 +509,28 @@ bool obs_module_load(void) {
 
             if (toolsMenu) {
                 toolsMenu->addAction(action);
+
+                QAction* traceAction = new QAction("Export Donation Latency Trace", mainWindow);
+                QObject::connect(traceAction, &QAction::triggered, []() {
+                    ExportDonationTrace();
+                });
+                toolsMenu->addAction(traceAction);
+
+                QAction* ratesAction = new QAction("Reload Currency Rates", mainWindow);
+                QObject::connect(ratesAction, &QAction::triggered, []() {
+                    CurrencyTable::Instance().Reload();
+                });
+                toolsMenu->addAction(ratesAction);
+#ifdef OBS_CALL_PROFILING
+                QAction* profileAction = new QAction("Dump libobs Call Profile", mainWindow);
+                QObject::connect(profileAction, &QAction::triggered, []() {
+                    for (const std::string& line : ObsCallProfiler::Instance().FormatReport()) {
+                        blog(LOG_INFO, "[Profiler] %s", line.c_str());
+                    }
+                    ObsCallProfiler::Instance().Reset();
+                });
+                toolsMenu->addAction(profileAction);
+#endif
                 blog(LOG_INFO, "[YouTube SuperChat] Menu item added to Tools menu");
             } else {
                 blog(LOG_WARNING, "[YouTube SuperChat] Could not find Tools menu in menu bar");
@@ -235,6 +542,11 @@ bool obs_module_load(void) {
         blog(LOG_WARNING, "[YouTube SuperChat] Could not get main window");
     }
 
+    // Live metrics dock; OBS takes ownership of the widget
+    if (!obs_frontend_add_dock_by_id(MetricsDock::DOCK_ID, "SuperChat Metrics", new MetricsDock())) {
+        blog(LOG_WARNING, "[YouTube SuperChat] Could not add metrics dock");
+    }
+
     // Register frontend callbacks
     obs_frontend_add_event_callback(OnFrontendEvent, nullptr);
 
@@ -245,14 +557,21 @@ void obs_module_unload(void) {
     blog(LOG_INFO, "YouTube SuperChat Plugin unloaded");
 
     // Stop chat monitoring
-    if (g_chatClient && g_chatClient->IsRunning()) {
-        g_chatClient->Stop();
+    if (g_chatHub && g_chatHub->IsRunning()) {
+        g_chatHub->Stop();
     }
 
     // Clean up
     g_settingsDialog.reset();
-    g_chatClient.reset();
+    g_donationInjector.reset();
+    g_metricsExporter.reset();
+    g_chatHub.reset();
+    g_donationTracer.reset();
+    g_keywordTriggers.reset();
     g_obstructionManager.reset();
+
+    // Last: the managers above log while shutting down
+    PluginLog::Instance().Stop();
 }
 
 const char* obs_module_name(void) {
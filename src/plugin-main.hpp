@@ -6,7 +6,11 @@
 #include <string>
 #include <QVariantList>
 
-class YouTubeChatClient;
+class ChatIngestionHub;
+class DonationInjector;
+class DonationTracer;
+class KeywordTriggerEngine;
+class MetricsExporter;
 class ObstructionManager;
 class SettingsDialog;
 struct DonationEvent;
@@ -16,18 +20,39 @@ struct DonationEvent;
 #define PLUGIN_VERSION "1.0.0"
 
 // Global plugin instances
-extern std::unique_ptr<YouTubeChatClient> g_chatClient;
+extern std::unique_ptr<ChatIngestionHub> g_chatHub;
+extern std::unique_ptr<DonationInjector> g_donationInjector;
+extern std::unique_ptr<DonationTracer> g_donationTracer;
+extern std::unique_ptr<KeywordTriggerEngine> g_keywordTriggers;
+extern std::unique_ptr<MetricsExporter> g_metricsExporter;
 extern std::unique_ptr<ObstructionManager> g_obstructionManager;
 extern std::unique_ptr<SettingsDialog> g_settingsDialog;
 
 // Plugin settings
 struct PluginSettings {
     std::string youtubeApiKey;
-    std::string videoId;
+    std::string videoId;                // One or more video IDs separated by commas or spaces
+    std::string apiBaseUrl;             // YouTube Data API host (mock servers for load testing)
+    bool recordChatSessions;            // Record raw chat pages for later replay
+    bool skipBacklogOnStart;            // Don't fire effects for chat history fetched on start
+    int dailyQuota;                     // API quota units per day for the key
+    double plannedStreamHours;          // Expected stream length for quota planning
+    bool enableInjection;               // Accept test donations on a localhost TCP port
+    int injectionPort;
+    int injectionRateLimit;             // Events per second per connection
+    bool enableMetricsExporter;         // Serve Prometheus metrics on a localhost port
+    int metricsPort;
+    int viewerChatPerMinute;            // Regular chat per viewer (0 = unlimited)
+    int viewerPaidPerMinute;            // Super Chats/Stickers per viewer (0 = unlimited)
+    int freeChatSamplesPerSecond;       // Regular chat kept under a flood, all viewers (0 = keep all)
     bool enableObstructions;
     bool enableRecovery;
     double obstructionIntensity;
     double recoveryIntensity;
+    double overlayLifetime;             // Default overlay lifetime in seconds (0 = never expire)
+    int maxOverlays;                    // Overlay cap (0 = unlimited)
+    int overlayEvictionPolicy;          // OverlayEvictionPolicy
+    int overlayPlacementMode;           // PlacementMode
     QVariantList effectConfigurations;  // Serialized effect configurations
 };
 
@@ -36,6 +61,14 @@ extern PluginSettings g_settings;
 // Settings functions
 void LoadSettings();
 void SaveSettings();
+void ApplyObstructionSettings();
+void ApplyInjectionSettings();
+void ApplyMetricsExporterSettings();
+void ApplyKeywordTriggerSettings();
+
+// Per-video chat cursors (liveChatId, pageToken, publishedAt watermark) of all monitored chats
+void RestoreChatCursor();
+void SaveChatCursor();
 
 // Donation handler (for testing)
 void OnDonationReceived(const DonationEvent& event);
@@ -0,0 +1,124 @@
+#include "plugin-metrics.hpp"
+
+PluginMetrics g_metrics;
+
+void PluginMetrics::RecordChatPage(size_t bytes, size_t messages, uint64_t parseTimeNs) {
+    chatPagesParsed.fetch_add(1, std::memory_order_relaxed);
+    chatMessagesParsed.fetch_add(messages, std::memory_order_relaxed);
+    chatBytesParsed.fetch_add(bytes, std::memory_order_relaxed);
+    chatParseTimeNs.fetch_add(parseTimeNs, std::memory_order_relaxed);
+    lastChatParseTimeNs.store(parseTimeNs, std::memory_order_relaxed);
+    lastChatPageBytes.store(bytes, std::memory_order_relaxed);
+}
+
+void PluginMetrics::RecordPoll(uint64_t latencyNs) {
+    pollsCompleted.fetch_add(1, std::memory_order_relaxed);
+    pollLatencyNs.fetch_add(latencyNs, std::memory_order_relaxed);
+    lastPollLatencyNs.store(latencyNs, std::memory_order_relaxed);
+    pollLatencyHistogramNs.Record(latencyNs);
+}
+
+void PluginMetrics::RecordEffectTick(uint64_t durationNs) {
+    effectTicks.fetch_add(1, std::memory_order_relaxed);
+    effectTickTimeNs.fetch_add(durationNs, std::memory_order_relaxed);
+    effectTickHistogramNs.Record(durationNs);
+
+    uint64_t max = effectTickMaxNs.load(std::memory_order_relaxed);
+    while (durationNs > max && !effectTickMaxNs.compare_exchange_weak(max, durationNs, std::memory_order_relaxed)) {
+    }
+}
+
+// ISO 4217 "no currency", used for anything that isn't three letters
+static const uint32_t NO_CURRENCY_CODE = ('X' << 16) | ('X' << 8) | 'X';
+
+// "JPY" -> 'J' << 16 | 'P' << 8 | 'Y'
+static uint32_t PackCurrencyCode(std::string_view currency) {
+    if (currency.size() != 3) return NO_CURRENCY_CODE;
+
+    uint32_t code = 0;
+    for (char c : currency) {
+        char upper = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        if (upper < 'A' || upper > 'Z') return NO_CURRENCY_CODE;
+        code = (code << 8) | static_cast<uint32_t>(upper);
+    }
+    return code;
+}
+
+void PluginMetrics::RecordDonation(size_t type, std::string_view currency) {
+    if (type >= DONATION_TYPE_COUNT) return;
+
+    uint32_t code = PackCurrencyCode(currency);
+    for (size_t i = 0; i < MAX_DONATION_CURRENCIES; i++) {
+        CurrencyDonations& slot = donations[(code + i) % MAX_DONATION_CURRENCIES];
+        uint32_t current = slot.code.load(std::memory_order_acquire);
+        if (current == 0 && slot.code.compare_exchange_strong(current, code, std::memory_order_acq_rel)) {
+            current = code;
+        }
+        if (current == code) {
+            slot.count[type].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void PluginMetrics::SetSourceId(size_t slot, std::string_view videoId) {
+    if (slot >= MAX_SOURCE_SLOTS) return;
+
+    std::array<uint64_t, 2> packed{};
+    for (size_t i = 0; i < videoId.size() && i < SOURCE_ID_BYTES; i++) {
+        char c = videoId[i];
+        bool safe = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+        packed[i / 8] |= static_cast<uint64_t>(static_cast<unsigned char>(safe ? c : '_')) << (8 * (i % 8));
+    }
+
+    SourceMetrics& source = sources[slot];
+    if (source.videoId[0].load(std::memory_order_relaxed) == packed[0] &&
+        source.videoId[1].load(std::memory_order_relaxed) == packed[1]) {
+        return;
+    }
+
+    uint32_t sequence = source.sequence.load(std::memory_order_relaxed);
+    source.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    source.videoId[0].store(packed[0], std::memory_order_relaxed);
+    source.videoId[1].store(packed[1], std::memory_order_relaxed);
+    source.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool PluginMetrics::GetSourceId(size_t slot, char (&id)[SOURCE_ID_BYTES + 1]) const {
+    if (slot >= MAX_SOURCE_SLOTS) return false;
+
+    const SourceMetrics& source = sources[slot];
+    std::array<uint64_t, 2> packed;
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = source.sequence.load(std::memory_order_acquire);
+        packed[0] = source.videoId[0].load(std::memory_order_relaxed);
+        packed[1] = source.videoId[1].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = source.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+
+    for (size_t i = 0; i < SOURCE_ID_BYTES; i++) {
+        id[i] = static_cast<char>(packed[i / 8] >> (8 * (i % 8)));
+    }
+    id[SOURCE_ID_BYTES] = '\0';
+    return id[0] != '\0';
+}
+
+uint64_t PluginMetrics::TakeEffectTickMax() {
+    return effectTickMaxNs.exchange(0, std::memory_order_relaxed);
+}
+
+double PluginMetrics::GetChatParseBytesPerSecond() const {
+    uint64_t timeNs = chatParseTimeNs.load(std::memory_order_relaxed);
+    if (timeNs == 0) return 0.0;
+    return static_cast<double>(chatBytesParsed.load(std::memory_order_relaxed)) * 1e9 / timeNs;
+}
+
+double PluginMetrics::GetDedupeHitRate() const {
+    uint64_t messages = chatMessagesParsed.load(std::memory_order_relaxed);
+    if (messages == 0) return 0.0;
+    return static_cast<double>(chatDuplicatesSuppressed.load(std::memory_order_relaxed)) / messages;
+}
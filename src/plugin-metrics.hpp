@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Fixed-bucket histogram that any thread can record into without a lock.
+// bounds are inclusive upper bounds; values above the last bound go to the overflow bucket.
+template <size_t N>
+struct AtomicHistogram {
+    explicit AtomicHistogram(const std::array<uint64_t, N>& upperBounds) : bounds(upperBounds) {}
+
+    void Record(uint64_t value) {
+        size_t bucket = 0;
+        while (bucket < N && value > bounds[bucket]) {
+            bucket++;
+        }
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    const std::array<uint64_t, N> bounds;
+    std::array<std::atomic<uint64_t>, N + 1> buckets{};
+    std::atomic<uint64_t> sum{0};
+};
+
+// Lock-free counters shared between the UI thread and worker threads.
+// Writers use relaxed increments; readers take a best-effort snapshot.
+struct PluginMetrics {
+    // Chat page parsing
+    std::atomic<uint64_t> chatPagesParsed{0};
+    std::atomic<uint64_t> chatMessagesParsed{0};
+    std::atomic<uint64_t> chatBytesParsed{0};
+    std::atomic<uint64_t> chatParseTimeNs{0};      // Sum over all pages
+    std::atomic<uint64_t> lastChatParseTimeNs{0};
+    std::atomic<uint64_t> lastChatPageBytes{0};
+    std::atomic<uint64_t> chatParseErrors{0};
+    std::atomic<uint64_t> chatDuplicatesSuppressed{0};
+    std::atomic<uint64_t> unknownCurrencyDonations{0};  // Paid messages skipped: no JPY rate
+
+    // Per-viewer rate limiting in the ingestion hub
+    std::atomic<uint64_t> viewerLimiterSuppressed{0};   // Events over their viewer's limit
+    std::atomic<uint64_t> viewerLimiterEntries{0};      // Viewers currently tracked
+    std::atomic<uint64_t> viewerLimiterBytes{0};
+
+    // Free chat sampling in the ingestion hub
+    std::atomic<uint64_t> freeChatSampledOut{0};
+    std::atomic<uint64_t> freeChatRateMilli{0};                 // Estimated messages per second x 1000
+    std::atomic<uint64_t> freeChatSampleProbabilityMilli{1000}; // Chance a message is kept x 1000
+
+    // API polling
+    std::atomic<uint64_t> apiRequests{0};
+    std::atomic<uint64_t> apiErrors{0};
+    std::atomic<uint64_t> quotaUnitsUsed{0};        // Estimated units used today
+    std::atomic<uint64_t> quotaBurnPerHour{0};      // Estimated units per hour, recent window
+    std::atomic<uint64_t> pollIntervalMs{0};        // Delay before the next scheduled poll
+    std::atomic<uint64_t> pollsCompleted{0};
+    std::atomic<uint64_t> pollLatencyNs{0};         // Sum of request -> response times
+    std::atomic<uint64_t> lastPollLatencyNs{0};
+    AtomicHistogram<8> pollLatencyHistogramNs{{50000000, 100000000, 250000000, 500000000,
+                                               1000000000, 2500000000, 5000000000, 10000000000}};
+
+    // Donation pipeline
+    std::atomic<uint64_t> hubQueueDepth{0};         // Events held in the reorder window
+
+    // Dispatched donations per (currency, DonationType). A currency claims a slot on first
+    // use with a compare-exchange, so recording never locks; codes past the table are dropped.
+    static constexpr size_t DONATION_TYPE_COUNT = 3;
+    static constexpr size_t MAX_DONATION_CURRENCIES = 64;
+    struct CurrencyDonations {
+        std::atomic<uint32_t> code{0};              // Packed uppercase ISO 4217 code, 0 = free
+        std::array<std::atomic<uint64_t>, DONATION_TYPE_COUNT> count{};
+    };
+    std::array<CurrencyDonations, MAX_DONATION_CURRENCIES> donations;
+
+    // Per chat, published by ChatIngestionHub once a second; slot i is the hub's i-th chat.
+    // The video ID is packed into two words behind a sequence count, so a reader on another
+    // thread never sees half of one ID and half of another.
+    static constexpr size_t MAX_SOURCE_SLOTS = 10;
+    static constexpr size_t SOURCE_ID_BYTES = 16;
+    struct SourceMetrics {
+        std::atomic<uint32_t> sequence{0};                  // Odd while the ID is rewritten
+        std::array<std::atomic<uint64_t>, 2> videoId{};     // NUL padded; all zero = unused slot
+        std::atomic<uint64_t> running{0};
+        std::atomic<uint64_t> pagesReceived{0};
+        std::atomic<uint64_t> messagesReceived{0};
+        std::atomic<uint64_t> eventsDispatched{0};
+        std::atomic<uint64_t> duplicatesSuppressed{0};
+        std::atomic<uint64_t> requestFailures{0};
+        std::atomic<uint64_t> pollIntervalMs{0};
+    };
+    std::array<SourceMetrics, MAX_SOURCE_SLOTS> sources;
+
+    // Local injection endpoint
+    std::atomic<uint64_t> injectedEvents{0};
+    std::atomic<uint64_t> injectedEventsDropped{0}; // Over the per-connection rate limit
+    std::atomic<uint64_t> injectedLinesMalformed{0}; // JSON lines that did not parse
+
+    // Effects, indexed by EffectType (published by EffectManager on the UI thread)
+    static constexpr size_t EFFECT_TYPE_COUNT = 10;
+    std::array<std::atomic<uint32_t>, EFFECT_TYPE_COUNT> activeEffects{};
+    std::atomic<uint64_t> effectTicks{0};
+    std::atomic<uint64_t> effectTickTimeNs{0};      // Sum over all ticks
+    std::atomic<uint64_t> effectTickMaxNs{0};       // Since the last TakeEffectTickMax()
+    AtomicHistogram<8> effectTickHistogramNs{{50000, 100000, 250000, 500000,
+                                              1000000, 2500000, 5000000, 16000000}};
+    std::atomic<uint64_t> effectsStarted{0};
+    std::atomic<uint64_t> effectsCompleted{0};
+
+    // Plugin-owned OBS objects
+    std::atomic<uint64_t> ownedSceneItems{0};       // Tracked by SourceRegistry
+    std::atomic<uint64_t> overlaySources{0};        // Live obstruction overlays
+
+    // Memory held by caches
+    std::atomic<uint64_t> dedupeCacheBytes{0};      // Message-ID sets of all chat clients
+
+    void RecordChatPage(size_t bytes, size_t messages, uint64_t parseTimeNs);
+    void RecordPoll(uint64_t latencyNs);
+    void RecordEffectTick(uint64_t durationNs);
+    void RecordDonation(size_t type, std::string_view currency);
+
+    // Single writer. Characters outside [A-Za-z0-9_-] become '_' so the ID is safe as a label;
+    // an empty ID frees the slot.
+    void SetSourceId(size_t slot, std::string_view videoId);
+    // Copies the slot's video ID into id, NUL terminated; false for an unused slot
+    bool GetSourceId(size_t slot, char (&id)[SOURCE_ID_BYTES + 1]) const;
+
+    // Returns the slowest tick since the previous call and starts a new window
+    uint64_t TakeEffectTickMax();
+
+    // Average parse throughput over all pages, in bytes per second
+    double GetChatParseBytesPerSecond() const;
+
+    // Duplicate messages suppressed per message parsed
+    double GetDedupeHitRate() const;
+};
+
+extern PluginMetrics g_metrics;
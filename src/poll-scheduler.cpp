@@ -0,0 +1,255 @@
+#include "poll-scheduler.hpp"
+#include "plugin-metrics.hpp"
+#include <obs-module.h>
+#include <util/base.h>
+#include <QDateTime>
+#include <QTimeZone>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+// Window used for the burn rate
+static const int64_t BURN_RATE_WINDOW_MS = 10 * 60 * 1000;
+
+// Backoff bounds for failed requests
+static const int BACKOFF_BASE_MS = 1000;
+static const int BACKOFF_MAX_MS = 5 * 60 * 1000;
+static const int RATE_LIMIT_MIN_BACKOFF_MS = 10 * 1000;
+static const int QUOTA_RETRY_MAX_MS = 60 * 60 * 1000;
+
+// Never poll faster than this, whatever the server says
+static const int MIN_POLL_INTERVAL_MS = 1000;
+
+static QDateTime PacificNow() {
+    static const QTimeZone pacific("America/Los_Angeles");
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    // Fall back to PST when the time zone database is unavailable
+    return pacific.isValid() ? now.toTimeZone(pacific) : now.toOffsetFromUtc(-8 * 3600);
+}
+
+QuotaTracker::QuotaTracker(int dailyBudget)
+    : m_budget(dailyBudget)
+    , m_used(0)
+    , m_sharedBy(1)
+    , m_pausedUntilMs(0)
+    , m_day(PacificNow().date())
+{
+}
+
+void QuotaTracker::SetDailyBudget(int units) {
+    m_budget = std::max(1, units);
+}
+
+void QuotaTracker::RollOver() {
+    QDate today = PacificNow().date();
+    if (today != m_day) {
+        m_day = today;
+        m_used = 0;
+    }
+}
+
+void QuotaTracker::Consume(int units) {
+    RollOver();
+    m_used += units;
+
+    int64_t now = QDateTime::currentMSecsSinceEpoch();
+    m_recent.emplace_back(now, units);
+    while (!m_recent.empty() && m_recent.front().first < now - BURN_RATE_WINDOW_MS) {
+        m_recent.pop_front();
+    }
+
+    g_metrics.quotaUnitsUsed.store(static_cast<uint64_t>(m_used), std::memory_order_relaxed);
+    g_metrics.quotaBurnPerHour.store(static_cast<uint64_t>(GetBurnRatePerHour()), std::memory_order_relaxed);
+}
+
+void QuotaTracker::MarkExhausted() {
+    RollOver();
+    m_used = std::max(m_used, m_budget);
+    g_metrics.quotaUnitsUsed.store(static_cast<uint64_t>(m_used), std::memory_order_relaxed);
+}
+
+void QuotaTracker::PauseUntil(int64_t msSinceEpoch) {
+    m_pausedUntilMs = std::max(m_pausedUntilMs, msSinceEpoch);
+}
+
+int64_t QuotaTracker::GetPauseRemainingMs() const {
+    return std::max<int64_t>(0, m_pausedUntilMs - QDateTime::currentMSecsSinceEpoch());
+}
+
+int QuotaTracker::GetUsedToday() {
+    RollOver();
+    return m_used;
+}
+
+int QuotaTracker::GetRemaining() {
+    RollOver();
+    return std::max(0, m_budget - m_used);
+}
+
+double QuotaTracker::GetBurnRatePerHour() {
+    int64_t now = QDateTime::currentMSecsSinceEpoch();
+    while (!m_recent.empty() && m_recent.front().first < now - BURN_RATE_WINDOW_MS) {
+        m_recent.pop_front();
+    }
+    if (m_recent.empty()) return 0.0;
+
+    int units = 0;
+    for (const auto& entry : m_recent) {
+        units += entry.second;
+    }
+
+    // Until a full window has passed, rate over the time actually observed (at least a minute)
+    int64_t span = std::max<int64_t>(now - m_recent.front().first, 60 * 1000);
+    return units * 3600000.0 / span;
+}
+
+int64_t QuotaTracker::GetMsUntilReset() const {
+    QDateTime now = PacificNow();
+    QDateTime reset = now.timeSpec() == Qt::TimeZone
+        ? QDateTime(now.date().addDays(1), QTime(0, 0), now.timeZone())
+        : QDateTime(now.date().addDays(1), QTime(0, 0), Qt::OffsetFromUTC, now.offsetFromUtc());
+    return std::max<int64_t>(0, now.msecsTo(reset));
+}
+
+PollScheduler::PollScheduler(QuotaTracker* quota, QObject* parent)
+    : QObject(parent)
+    , m_quota(quota)
+    , m_timer(new QTimer(this))
+    , m_running(false)
+    , m_inFlight(false)
+    , m_consecutiveFailures(0)
+    , m_currentIntervalMs(0)
+    , m_plannedStreamHours(8.0)
+    , m_startedAtMs(0)
+    , m_stretchLogged(false)
+    , m_randomEngine(std::random_device{}())
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &PollScheduler::OnTimer);
+}
+
+PollScheduler::~PollScheduler() {
+}
+
+void PollScheduler::Start() {
+    m_running = true;
+    m_inFlight = false;
+    m_consecutiveFailures = 0;
+    m_startedAtMs = QDateTime::currentMSecsSinceEpoch();
+    m_stretchLogged = false;
+    ScheduleIn(0);
+}
+
+void PollScheduler::Stop() {
+    m_running = false;
+    m_inFlight = false;
+    m_timer->stop();
+}
+
+void PollScheduler::RequestStarted(int quotaUnits) {
+    m_inFlight = true;
+    if (m_quota) {
+        m_quota->Consume(quotaUnits);
+    }
+    g_metrics.apiRequests.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PollScheduler::RequestSucceeded(int serverIntervalMs) {
+    m_inFlight = false;
+    m_consecutiveFailures = 0;
+    if (!m_running) return;
+
+    int interval = std::max(serverIntervalMs, MIN_POLL_INTERVAL_MS);
+    int quotaInterval = ComputeQuotaIntervalMs();
+    if (quotaInterval > interval) {
+        if (!m_stretchLogged) {
+            blog(LOG_WARNING, "[Scheduler] Quota would run out before the stream ends; stretching poll interval to %d ms",
+                 quotaInterval);
+            m_stretchLogged = true;
+        }
+        interval = quotaInterval;
+    } else {
+        m_stretchLogged = false;
+    }
+
+    ScheduleIn(interval);
+}
+
+void PollScheduler::RequestFailed(PollFailure failure) {
+    m_inFlight = false;
+    ++m_consecutiveFailures;
+    g_metrics.apiErrors.fetch_add(1, std::memory_order_relaxed);
+    if (!m_running) return;
+
+    int delay;
+    if (failure == PollFailure::QuotaExceeded) {
+        // Nothing will succeed before the daily reset
+        if (m_quota) {
+            m_quota->MarkExhausted();
+        }
+        int64_t untilReset = m_quota ? m_quota->GetMsUntilReset() : QUOTA_RETRY_MAX_MS;
+        delay = static_cast<int>(std::clamp<int64_t>(untilReset, BACKOFF_MAX_MS, QUOTA_RETRY_MAX_MS));
+    } else {
+        // Exponential backoff with jitter in [d/2, d]
+        int exponent = std::min(m_consecutiveFailures - 1, 16);
+        int64_t backoff = std::min<int64_t>(static_cast<int64_t>(BACKOFF_BASE_MS) << exponent, BACKOFF_MAX_MS);
+        if (failure == PollFailure::RateLimited) {
+            backoff = std::max<int64_t>(backoff, RATE_LIMIT_MIN_BACKOFF_MS);
+        }
+        std::uniform_int_distribution<int64_t> jitter(backoff / 2, backoff);
+        delay = static_cast<int>(jitter(m_randomEngine));
+    }
+
+    // Other chats on the same key would hit the same limit or the same struggling backend;
+    // hold them back too. Network and Rejected failures are this chat's own.
+    if (m_quota && (failure == PollFailure::QuotaExceeded || failure == PollFailure::RateLimited ||
+                    failure == PollFailure::Server)) {
+        m_quota->PauseUntil(QDateTime::currentMSecsSinceEpoch() + delay);
+    }
+
+    blog(LOG_WARNING, "[Scheduler] Request failed (%d in a row), retrying in %.1f s",
+         m_consecutiveFailures, delay / 1000.0);
+    ScheduleIn(delay);
+}
+
+int PollScheduler::ComputeQuotaIntervalMs() {
+    if (!m_quota) return 0;
+
+    int remaining = m_quota->GetRemaining();
+    int64_t untilReset = m_quota->GetMsUntilReset();
+    if (remaining < QUOTA_COST_LIVE_CHAT_MESSAGES) {
+        return static_cast<int>(std::min<int64_t>(untilReset, QUOTA_RETRY_MAX_MS));
+    }
+
+    // Spread what is left over the rest of the stream (or until the quota resets, if sooner)
+    int64_t streamEndMs = m_startedAtMs + static_cast<int64_t>(m_plannedStreamHours * 3600000.0);
+    int64_t streamLeftMs = streamEndMs - QDateTime::currentMSecsSinceEpoch();
+    if (streamLeftMs <= 0) {
+        // Running past the plan: budget for one more hour at a time
+        streamLeftMs = 3600000;
+    }
+    int64_t horizonMs = std::min(streamLeftMs, untilReset);
+
+    int64_t pollsLeft = std::max<int64_t>(1, remaining / QUOTA_COST_LIVE_CHAT_MESSAGES / m_quota->GetSharedBy());
+    return static_cast<int>(std::min<int64_t>(horizonMs / pollsLeft, QUOTA_RETRY_MAX_MS));
+}
+
+void PollScheduler::ScheduleIn(int delayMs) {
+    m_currentIntervalMs = delayMs;
+    g_metrics.pollIntervalMs.store(static_cast<uint64_t>(delayMs), std::memory_order_relaxed);
+    m_timer->start(std::max(0, delayMs));
+}
+
+void PollScheduler::OnTimer() {
+    if (!m_running || m_inFlight) return;
+
+    int64_t pausedMs = m_quota ? m_quota->GetPauseRemainingMs() : 0;
+    if (pausedMs > 0) {
+        ScheduleIn(static_cast<int>(pausedMs));
+        return;
+    }
+
+    if (m_pollFunc) {
+        m_pollFunc();
+    }
+}
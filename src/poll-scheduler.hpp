@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QObject>
+#include <QDate>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <random>
+#include <utility>
+
+class QTimer;
+
+// YouTube Data API v3 quota cost per call
+static const int QUOTA_COST_VIDEOS_LIST = 1;
+static const int QUOTA_COST_LIVE_CHAT_MESSAGES = 5;
+static const int DEFAULT_DAILY_QUOTA = 10000;
+
+// Estimated quota usage for one API key. Like the real quota, the count resets at
+// midnight Pacific time. Only calls made by this process are counted.
+class QuotaTracker {
+public:
+    explicit QuotaTracker(int dailyBudget = DEFAULT_DAILY_QUOTA);
+
+    void SetDailyBudget(int units);
+    int GetDailyBudget() const { return m_budget; }
+
+    void Consume(int units);
+    void MarkExhausted();   // The server answered quotaExceeded
+
+    // Number of chats polling on this key; each gets an equal share of what is left
+    void SetSharedBy(int pollers) { m_sharedBy = pollers < 1 ? 1 : pollers; }
+    int GetSharedBy() const { return m_sharedBy; }
+
+    // Backoff that applies to every poller on the key (rate limits are per key, not per chat)
+    void PauseUntil(int64_t msSinceEpoch);
+    int64_t GetPauseRemainingMs() const;
+
+    int GetUsedToday();
+    int GetRemaining();
+    double GetBurnRatePerHour();    // Over the last few minutes
+    int64_t GetMsUntilReset() const;
+
+private:
+    void RollOver();
+
+    int m_budget;
+    int m_used;
+    int m_sharedBy;
+    int64_t m_pausedUntilMs;
+    QDate m_day;    // Pacific date m_used belongs to
+    std::deque<std::pair<int64_t, int>> m_recent;   // (ms since epoch, units)
+};
+
+enum class PollFailure {
+    Network,        // Connection errors, timeouts
+    Server,         // 5xx or unparsable responses
+    Rejected,       // Other 4xx: this chat's request is bad (ended chat, unknown video)
+    RateLimited,    // 403/429 rateLimitExceeded
+    QuotaExceeded   // 403 quotaExceeded
+};
+
+// Decides when the next API request may go out. Only one request is ever in flight:
+// the next poll is scheduled when the current one reports success or failure.
+// The interval is the largest of the server's pollingIntervalMillis, the interval that
+// keeps the remaining quota lasting for the planned stream, and the error backoff.
+class PollScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    using PollFunc = std::function<void()>;
+
+    explicit PollScheduler(QuotaTracker* quota, QObject* parent = nullptr);
+    ~PollScheduler();
+
+    void SetPollFunc(PollFunc func) { m_pollFunc = std::move(func); }
+    void SetQuotaTracker(QuotaTracker* quota) { m_quota = quota; }
+    void SetPlannedStreamHours(double hours) { m_plannedStreamHours = hours; }
+
+    void Start();   // First poll right away
+    void Stop();
+    bool IsRunning() const { return m_running; }
+
+    // Request lifecycle, reported by the client
+    void RequestStarted(int quotaUnits);
+    void RequestSucceeded(int serverIntervalMs);
+    void RequestFailed(PollFailure failure);
+
+    bool IsRequestInFlight() const { return m_inFlight; }
+    int GetCurrentIntervalMs() const { return m_currentIntervalMs; }
+    int GetConsecutiveFailures() const { return m_consecutiveFailures; }
+
+private:
+    void ScheduleIn(int delayMs);
+    void OnTimer();
+    int ComputeQuotaIntervalMs();
+
+    QuotaTracker* m_quota;
+    PollFunc m_pollFunc;
+    QTimer* m_timer;
+    bool m_running;
+    bool m_inFlight;
+    int m_consecutiveFailures;
+    int m_currentIntervalMs;
+    double m_plannedStreamHours;
+    int64_t m_startedAtMs;
+    bool m_stretchLogged;
+    std::mt19937 m_randomEngine;
+};
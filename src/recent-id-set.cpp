@@ -0,0 +1,63 @@
+#include "recent-id-set.hpp"
+#include "id-hash.hpp"
+#include <algorithm>
+
+RecentIdSet::RecentIdSet(size_t capacity)
+    : m_mask(0)
+    , m_head(0)
+    , m_count(0)
+{
+    if (capacity == 0) capacity = 1;
+
+    size_t tableSize = IdTableSize(capacity);
+    m_table.assign(tableSize, 0);
+    m_mask = tableSize - 1;
+    m_ring.assign(capacity, 0);
+}
+
+static uint64_t KeyOf(uint64_t fingerprint) {
+    return fingerprint;
+}
+
+size_t RecentIdSet::FindSlot(uint64_t fingerprint) const {
+    return IdTableFind(m_table, m_mask, fingerprint, KeyOf);
+}
+
+bool RecentIdSet::Contains(std::string_view id) const {
+    return m_table[FindSlot(IdFingerprint(id))] != 0;
+}
+
+bool RecentIdSet::Insert(std::string_view id) {
+    uint64_t fingerprint = IdFingerprint(id);
+    size_t slot = FindSlot(fingerprint);
+    if (m_table[slot] != 0) {
+        return false;
+    }
+
+    if (m_count == m_ring.size()) {
+        // Window is full: the oldest id makes room for this one
+        Erase(m_ring[m_head]);
+        m_ring[m_head] = fingerprint;
+        m_head = (m_head + 1) % m_ring.size();
+        slot = FindSlot(fingerprint);
+    } else {
+        m_ring[(m_head + m_count) % m_ring.size()] = fingerprint;
+        ++m_count;
+    }
+
+    m_table[slot] = fingerprint;
+    return true;
+}
+
+void RecentIdSet::Erase(uint64_t fingerprint) {
+    size_t slot = FindSlot(fingerprint);
+    if (m_table[slot] == 0) return;
+
+    m_table[IdTableErase(m_table, m_mask, slot, KeyOf)] = 0;
+}
+
+void RecentIdSet::Clear() {
+    std::fill(m_table.begin(), m_table.end(), 0);
+    m_head = 0;
+    m_count = 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Bounded set of recently seen message ids.
+//
+// Ids are stored as 64-bit fingerprints in an open-addressing table (linear probing,
+// at most 50% load) and remembered in a FIFO ring; once the ring is full the oldest id
+// is forgotten. Memory stays constant no matter how long the stream runs.
+class RecentIdSet {
+public:
+    explicit RecentIdSet(size_t capacity = 16384);
+
+    // Records the id; returns false if it was already in the recent window
+    bool Insert(std::string_view id);
+    bool Contains(std::string_view id) const;
+    void Clear();
+
+    size_t Size() const { return m_count; }
+    size_t Capacity() const { return m_ring.size(); }
+    size_t MemoryBytes() const { return (m_table.capacity() + m_ring.capacity()) * sizeof(uint64_t); }
+
+private:
+    size_t FindSlot(uint64_t fingerprint) const;
+    void Erase(uint64_t fingerprint);
+
+    std::vector<uint64_t> m_table;  // 0 = empty slot
+    size_t m_mask;
+    std::vector<uint64_t> m_ring;   // Insertion order, oldest at m_head once full
+    size_t m_head;
+    size_t m_count;
+};
@@ -3,6 +3,8 @@
 #include "effect-config.hpp"
 #include "plugin-main.hpp"
 #include "youtube-chat-client.hpp"
+#include "chat-ingestion-hub.hpp"
+#include "donation-injector.hpp"
 #include "obstruction-manager.hpp"
 
 #include <QVBoxLayout>
@@ -10,8 +12,9 @@
 #include <QFormLayout>
 #include <QGroupBox>
 #include <QMessageBox>
+#include <QFileDialog>
 
-extern std::unique_ptr<YouTubeChatClient> g_chatClient;
+extern std::unique_ptr<ChatIngestionHub> g_chatHub;
 extern std::unique_ptr<ObstructionManager> g_obstructionManager;
 extern PluginSettings g_settings;
 
@@ -283,8 +286,54 @@ void SettingsDialog::SetupUI() {
     apiLayout->addRow("API Key:", m_apiKeyEdit);
 
     m_videoIdEdit = new QLineEdit();
-    m_videoIdEdit->setPlaceholderText("YouTube video ID (e.g., dQw4w9WgXcQ)");
-    apiLayout->addRow("Video ID:", m_videoIdEdit);
+    m_videoIdEdit->setPlaceholderText("YouTube video ID (e.g., dQw4w9WgXcQ); separate IDs with commas for collab streams");
+    apiLayout->addRow("Video ID(s):", m_videoIdEdit);
+
+    m_apiBaseUrlEdit = new QLineEdit();
+    m_apiBaseUrlEdit->setPlaceholderText(DEFAULT_API_BASE_URL);
+    m_apiBaseUrlEdit->setToolTip("Change only to point at a local mock server (e.g., http://127.0.0.1:8089)");
+    apiLayout->addRow("API Base URL:", m_apiBaseUrlEdit);
+
+    m_skipBacklogCheck = new QCheckBox("Skip chat history on start");
+    m_skipBacklogCheck->setToolTip("Messages posted before monitoring started do not trigger effects");
+    apiLayout->addRow(m_skipBacklogCheck);
+
+    m_dailyQuotaSpin = new QSpinBox();
+    m_dailyQuotaSpin->setRange(100, 10000000);
+    m_dailyQuotaSpin->setSingleStep(1000);
+    m_dailyQuotaSpin->setSuffix(" units");
+    m_dailyQuotaSpin->setToolTip("Daily quota of the API key (default 10,000). Polling slows down so it lasts the stream.");
+    apiLayout->addRow("Daily API Quota:", m_dailyQuotaSpin);
+
+    m_streamHoursSpin = new QDoubleSpinBox();
+    m_streamHoursSpin->setRange(0.5, 24.0);
+    m_streamHoursSpin->setSingleStep(0.5);
+    m_streamHoursSpin->setSuffix(" h");
+    m_streamHoursSpin->setToolTip("Expected stream length used to pace quota usage");
+    apiLayout->addRow("Planned Stream Length:", m_streamHoursSpin);
+
+    QHBoxLayout* viewerLimitLayout = new QHBoxLayout();
+    m_viewerChatLimitSpin = new QSpinBox();
+    m_viewerChatLimitSpin->setRange(0, 600);
+    m_viewerChatLimitSpin->setSuffix(" chat/min");
+    m_viewerChatLimitSpin->setSpecialValueText("Chat: unlimited");
+    m_viewerChatLimitSpin->setToolTip("Regular chat messages per viewer that can trigger effects");
+    m_viewerPaidLimitSpin = new QSpinBox();
+    m_viewerPaidLimitSpin->setRange(0, 600);
+    m_viewerPaidLimitSpin->setSuffix(" paid/min");
+    m_viewerPaidLimitSpin->setSpecialValueText("Paid: unlimited");
+    m_viewerPaidLimitSpin->setToolTip("Super Chats and Super Stickers per viewer that can trigger effects");
+    viewerLimitLayout->addWidget(m_viewerChatLimitSpin);
+    viewerLimitLayout->addWidget(m_viewerPaidLimitSpin);
+    apiLayout->addRow("Per-Viewer Limit:", viewerLimitLayout);
+
+    m_freeChatSampleSpin = new QSpinBox();
+    m_freeChatSampleSpin->setRange(0, 100);
+    m_freeChatSampleSpin->setSuffix(" triggers/s");
+    m_freeChatSampleSpin->setSpecialValueText("off");
+    m_freeChatSampleSpin->setToolTip("Regular chat messages that can trigger effects per second across all viewers. "
+                                     "Under a flood a random sample is kept; paid messages are never sampled.");
+    apiLayout->addRow("Free Chat Sampling:", m_freeChatSampleSpin);
 
     apiGroup->setLayout(apiLayout);
     basicLayout->addWidget(apiGroup);
@@ -326,6 +375,32 @@ void SettingsDialog::SetupUI() {
     m_recoveryIntensitySpin->setToolTip("Multiplier for recovery effects (higher = stronger recovery)");
     effectLayout->addRow("Recovery Intensity:", m_recoveryIntensitySpin);
 
+    m_overlayLifetimeSpin = new QDoubleSpinBox();
+    m_overlayLifetimeSpin->setRange(0.0, 3600.0);
+    m_overlayLifetimeSpin->setSingleStep(5.0);
+    m_overlayLifetimeSpin->setValue(60.0);
+    m_overlayLifetimeSpin->setSuffix(" s");
+    m_overlayLifetimeSpin->setToolTip("How long random obstruction overlays stay on screen (0 = until recovery/reset)");
+    effectLayout->addRow("Overlay Lifetime:", m_overlayLifetimeSpin);
+
+    m_maxOverlaysSpin = new QSpinBox();
+    m_maxOverlaysSpin->setRange(0, 200);
+    m_maxOverlaysSpin->setValue(20);
+    m_maxOverlaysSpin->setToolTip("Maximum number of overlays on screen at once (0 = unlimited)");
+    effectLayout->addRow("Max Overlays:", m_maxOverlaysSpin);
+
+    m_evictionPolicyCombo = new QComboBox();
+    m_evictionPolicyCombo->addItem("Oldest first");
+    m_evictionPolicyCombo->addItem("Lowest value first");
+    m_evictionPolicyCombo->setToolTip("Which overlay is removed when the maximum is reached");
+    effectLayout->addRow("Eviction Policy:", m_evictionPolicyCombo);
+
+    m_placementModeCombo = new QComboBox();
+    m_placementModeCombo->addItem("Spread across screen");
+    m_placementModeCombo->addItem("Cover main source");
+    m_placementModeCombo->setToolTip("How new overlays are positioned relative to existing ones");
+    effectLayout->addRow("Overlay Placement:", m_placementModeCombo);
+
     effectGroup->setLayout(effectLayout);
     basicLayout->addWidget(effectGroup);
 
@@ -361,6 +436,48 @@ void SettingsDialog::SetupUI() {
     testButtonLayout->addWidget(m_testRecoveryButton);
     testLayout->addRow(testButtonLayout);
 
+    m_recordSessionCheck = new QCheckBox("Record chat sessions for replay");
+    m_recordSessionCheck->setToolTip("Saves every chat API response to a .ytcl log in the plugin config folder");
+    testLayout->addRow(m_recordSessionCheck);
+
+    QHBoxLayout* replayLayout = new QHBoxLayout();
+    m_replaySpeedCombo = new QComboBox();
+    m_replaySpeedCombo->addItem("1x", 1.0);
+    m_replaySpeedCombo->addItem("2x", 2.0);
+    m_replaySpeedCombo->addItem("10x", 10.0);
+    m_replaySpeedCombo->addItem("Max speed", 0.0);
+    m_replayButton = new QPushButton("Replay Session Log...");
+    replayLayout->addWidget(m_replaySpeedCombo);
+    replayLayout->addWidget(m_replayButton);
+    testLayout->addRow("Replay:", replayLayout);
+
+    m_enableInjectionCheck = new QCheckBox("Accept test donations on localhost");
+    m_enableInjectionCheck->setToolTip("Newline-delimited JSON or binary batches over TCP (see docs/API.md)");
+    testLayout->addRow(m_enableInjectionCheck);
+
+    QHBoxLayout* injectionLayout = new QHBoxLayout();
+    m_injectionPortSpin = new QSpinBox();
+    m_injectionPortSpin->setRange(1024, 65535);
+    m_injectionPortSpin->setPrefix("127.0.0.1:");
+    m_injectionRateSpin = new QSpinBox();
+    m_injectionRateSpin->setRange(1, 1000000);
+    m_injectionRateSpin->setSingleStep(100);
+    m_injectionRateSpin->setSuffix(" events/s");
+    m_injectionRateSpin->setToolTip("Rate limit per connection; events over the limit are dropped");
+    injectionLayout->addWidget(m_injectionPortSpin);
+    injectionLayout->addWidget(m_injectionRateSpin);
+    testLayout->addRow("Injection Port:", injectionLayout);
+
+    m_enableMetricsExporterCheck = new QCheckBox("Serve Prometheus metrics on localhost");
+    m_enableMetricsExporterCheck->setToolTip("GET /metrics in Prometheus text format (see docs/API.md)");
+    m_metricsPortSpin = new QSpinBox();
+    m_metricsPortSpin->setRange(1024, 65535);
+    m_metricsPortSpin->setPrefix("127.0.0.1:");
+    QHBoxLayout* metricsLayout = new QHBoxLayout();
+    metricsLayout->addWidget(m_enableMetricsExporterCheck);
+    metricsLayout->addWidget(m_metricsPortSpin);
+    testLayout->addRow("Metrics:", metricsLayout);
+
     testGroup->setLayout(testLayout);
     basicLayout->addWidget(testGroup);
 
@@ -417,6 +534,7 @@ void SettingsDialog::SetupUI() {
     connect(m_stopButton, &QPushButton::clicked, this, &SettingsDialog::OnStopMonitoringClicked);
     connect(m_testObstructionButton, &QPushButton::clicked, this, &SettingsDialog::OnTestObstructionClicked);
     connect(m_testRecoveryButton, &QPushButton::clicked, this, &SettingsDialog::OnTestRecoveryClicked);
+    connect(m_replayButton, &QPushButton::clicked, this, &SettingsDialog::OnReplaySessionClicked);
     connect(m_saveButton, &QPushButton::clicked, this, &SettingsDialog::OnSaveClicked);
     connect(m_cancelButton, &QPushButton::clicked, this, &SettingsDialog::OnCancelClicked);
 }
@@ -424,10 +542,27 @@ void SettingsDialog::SetupUI() {
 void SettingsDialog::LoadSettings() {
     m_apiKeyEdit->setText(QString::fromStdString(g_settings.youtubeApiKey));
     m_videoIdEdit->setText(QString::fromStdString(g_settings.videoId));
+    m_apiBaseUrlEdit->setText(QString::fromStdString(g_settings.apiBaseUrl));
+    m_recordSessionCheck->setChecked(g_settings.recordChatSessions);
+    m_skipBacklogCheck->setChecked(g_settings.skipBacklogOnStart);
+    m_dailyQuotaSpin->setValue(g_settings.dailyQuota);
+    m_streamHoursSpin->setValue(g_settings.plannedStreamHours);
+    m_viewerChatLimitSpin->setValue(g_settings.viewerChatPerMinute);
+    m_viewerPaidLimitSpin->setValue(g_settings.viewerPaidPerMinute);
+    m_freeChatSampleSpin->setValue(g_settings.freeChatSamplesPerSecond);
+    m_enableInjectionCheck->setChecked(g_settings.enableInjection);
+    m_injectionPortSpin->setValue(g_settings.injectionPort);
+    m_injectionRateSpin->setValue(g_settings.injectionRateLimit);
+    m_enableMetricsExporterCheck->setChecked(g_settings.enableMetricsExporter);
+    m_metricsPortSpin->setValue(g_settings.metricsPort);
     m_enableObstructionsCheck->setChecked(g_settings.enableObstructions);
     m_enableRecoveryCheck->setChecked(g_settings.enableRecovery);
     m_obstructionIntensitySpin->setValue(g_settings.obstructionIntensity);
     m_recoveryIntensitySpin->setValue(g_settings.recoveryIntensity);
+    m_overlayLifetimeSpin->setValue(g_settings.overlayLifetime);
+    m_maxOverlaysSpin->setValue(g_settings.maxOverlays);
+    m_evictionPolicyCombo->setCurrentIndex(g_settings.overlayEvictionPolicy);
+    m_placementModeCombo->setCurrentIndex(g_settings.overlayPlacementMode);
 
     // Load effect configurations
     if (m_effectConfigManager) {
@@ -442,10 +577,30 @@ void SettingsDialog::LoadSettings() {
 void SettingsDialog::SaveSettings() {
     g_settings.youtubeApiKey = m_apiKeyEdit->text().toStdString();
     g_settings.videoId = m_videoIdEdit->text().toStdString();
+    g_settings.apiBaseUrl = m_apiBaseUrlEdit->text().trimmed().toStdString();
+    if (g_settings.apiBaseUrl.empty()) {
+        g_settings.apiBaseUrl = DEFAULT_API_BASE_URL;
+    }
+    g_settings.recordChatSessions = m_recordSessionCheck->isChecked();
+    g_settings.skipBacklogOnStart = m_skipBacklogCheck->isChecked();
+    g_settings.dailyQuota = m_dailyQuotaSpin->value();
+    g_settings.plannedStreamHours = m_streamHoursSpin->value();
+    g_settings.viewerChatPerMinute = m_viewerChatLimitSpin->value();
+    g_settings.viewerPaidPerMinute = m_viewerPaidLimitSpin->value();
+    g_settings.freeChatSamplesPerSecond = m_freeChatSampleSpin->value();
+    g_settings.enableInjection = m_enableInjectionCheck->isChecked();
+    g_settings.injectionPort = m_injectionPortSpin->value();
+    g_settings.injectionRateLimit = m_injectionRateSpin->value();
+    g_settings.enableMetricsExporter = m_enableMetricsExporterCheck->isChecked();
+    g_settings.metricsPort = m_metricsPortSpin->value();
     g_settings.enableObstructions = m_enableObstructionsCheck->isChecked();
     g_settings.enableRecovery = m_enableRecoveryCheck->isChecked();
     g_settings.obstructionIntensity = m_obstructionIntensitySpin->value();
     g_settings.recoveryIntensity = m_recoveryIntensitySpin->value();
+    g_settings.overlayLifetime = m_overlayLifetimeSpin->value();
+    g_settings.maxOverlays = m_maxOverlaysSpin->value();
+    g_settings.overlayEvictionPolicy = m_evictionPolicyCombo->currentIndex();
+    g_settings.overlayPlacementMode = m_placementModeCombo->currentIndex();
 
     // Save effect configurations
     if (m_effectConfigManager) {
@@ -456,13 +611,25 @@ void SettingsDialog::SaveSettings() {
     ::SaveSettings();
 
     // Update managers
-    if (g_chatClient) {
-        g_chatClient->SetApiKey(g_settings.youtubeApiKey);
-        g_chatClient->SetVideoId(g_settings.videoId);
+    if (g_chatHub) {
+        g_chatHub->SetApiKey(g_settings.youtubeApiKey);
+        g_chatHub->SetApiBaseUrl(g_settings.apiBaseUrl);
+        g_chatHub->SetRecordingEnabled(g_settings.recordChatSessions);
+        g_chatHub->SetSkipBacklog(g_settings.skipBacklogOnStart);
+        g_chatHub->SetDailyQuota(g_settings.dailyQuota);
+        g_chatHub->SetPlannedStreamHours(g_settings.plannedStreamHours);
+        g_chatHub->SetViewerRateLimits(g_settings.viewerChatPerMinute, g_settings.viewerPaidPerMinute);
+        g_chatHub->SetFreeChatSampleRate(g_settings.freeChatSamplesPerSecond);
+        g_chatHub->SetVideoIds(ParseVideoIdList(g_settings.videoId));
     }
 
+    ApplyInjectionSettings();
+    ApplyMetricsExporterSettings();
+    ApplyKeywordTriggerSettings();
+
     if (g_obstructionManager) {
         g_obstructionManager->SetEnabled(g_settings.enableObstructions || g_settings.enableRecovery);
+        ApplyObstructionSettings();
 
         std::string mainSource = m_mainSourceEdit->text().toStdString();
         if (!mainSource.empty()) {
@@ -504,8 +671,9 @@ void SettingsDialog::OnStartMonitoringClicked() {
     SaveSettings();
 
     // Start monitoring
-    if (g_chatClient) {
-        g_chatClient->Start();
+    if (g_chatHub) {
+        RestoreChatCursor();
+        g_chatHub->Start();
         UpdateMonitoringState();
 
         m_statusLabel->setText("🟢 モニタリング中 - 投げ銭を待機しています...");
@@ -516,8 +684,9 @@ void SettingsDialog::OnStartMonitoringClicked() {
 }
 
 void SettingsDialog::OnStopMonitoringClicked() {
-    if (g_chatClient) {
-        g_chatClient->Stop();
+    if (g_chatHub) {
+        g_chatHub->Stop();
+        SaveChatCursor();
         UpdateMonitoringState();
 
         m_statusLabel->setText("⭕ モニタリング停止中");
@@ -528,7 +697,7 @@ void SettingsDialog::OnStopMonitoringClicked() {
 }
 
 void SettingsDialog::UpdateMonitoringState() {
-    if (g_chatClient && g_chatClient->IsRunning()) {
+    if (g_chatHub && g_chatHub->IsRunning()) {
         m_startButton->setEnabled(false);
         m_stopButton->setEnabled(true);
         m_statusLabel->setText("🟢 モニタリング中");
@@ -560,7 +729,7 @@ void SettingsDialog::OnTestObstructionClicked() {
     }
 
     // Get test amount
-    double testAmount = m_testAmountSpin->value();
+    Money testAmount = Money::FromUnits(m_testAmountSpin->value());
 
     // Load effect configurations and find matching config
     EffectConfigList configs;
@@ -569,7 +738,7 @@ void SettingsDialog::OnTestObstructionClicked() {
 
     QString resultMessage;
 
-    if (config.amount > 0.0) {
+    if (config.amount.IsPositive()) {
         // Found a configured effect
         g_obstructionManager->ApplyConfiguredEffect(config);
 
@@ -580,16 +749,16 @@ void SettingsDialog::OnTestObstructionClicked() {
             "エフェクト: %3\n"
             "持続時間: %4秒\n\n"
             "OBSプレビューを確認してください。"
-        ).arg(testAmount)
-         .arg(config.amount)
+        ).arg(testAmount.ToUnits())
+         .arg(config.amount.ToUnits())
          .arg(::EffectActionToString(config.action))
          .arg(config.duration);
 
         blog(LOG_INFO, "[Test] Using configured effect for %.2f JPY: Action=%d",
-             testAmount, static_cast<int>(config.action));
+             testAmount.ToUnits(), static_cast<int>(config.action));
     } else {
         // No configuration found - use fallback
-        g_obstructionManager->ApplyObstruction(testAmount * g_settings.obstructionIntensity);
+        g_obstructionManager->ApplyObstruction(testAmount.ToUnits() * g_settings.obstructionIntensity);
 
         resultMessage = QString(
             "⚠ デフォルト動作を適用\n\n"
@@ -598,9 +767,9 @@ void SettingsDialog::OnTestObstructionClicked() {
             "ランダムエフェクトが適用されます。\n"
             "特定のエフェクトをテストするには、\n"
             "「エフェクト設定」タブで金額を設定してください。"
-        ).arg(testAmount);
+        ).arg(testAmount.ToUnits());
 
-        blog(LOG_INFO, "[Test] No config found for %.2f JPY, using default random behavior", testAmount);
+        blog(LOG_INFO, "[Test] No config found for %.2f JPY, using default random behavior", testAmount.ToUnits());
     }
 
     QMessageBox::information(this, "テスト実行", resultMessage);
@@ -625,12 +794,13 @@ void SettingsDialog::OnTestRecoveryClicked() {
     }
 
     // Get test amount
-    double testAmount = m_testAmountSpin->value();
+    Money testAmount = Money::FromUnits(m_testAmountSpin->value());
 
     // Create a simulated SuperSticker event (this simulates the entire API flow)
     DonationEvent simulatedEvent;
     simulatedEvent.type = DonationType::SuperSticker;
     simulatedEvent.amount = testAmount;
+    simulatedEvent.originalAmount = testAmount;
     simulatedEvent.displayName = "Test User";
     simulatedEvent.message = "";
     simulatedEvent.currency = "JPY";
@@ -642,7 +812,7 @@ void SettingsDialog::OnTestRecoveryClicked() {
     QMessageBox::information(this, "Test Applied",
                            QString("Simulated SuperSticker: %1 JPY from '%2'\n\n"
                                    "This tests the complete API flow!\n"
-                                   "Check your OBS preview and logs.").arg(testAmount).arg("Test User"));
+                                   "Check your OBS preview and logs.").arg(testAmount.ToUnits()).arg("Test User"));
 }
 
 void SettingsDialog::OnEffectConfigsChanged() {
@@ -650,3 +820,28 @@ void SettingsDialog::OnEffectConfigsChanged() {
     // They will be saved when user clicks Save button
     blog(LOG_INFO, "[Settings] Effect configurations modified");
 }
+
+void SettingsDialog::OnReplaySessionClicked() {
+    if (!g_chatHub) return;
+
+    if (g_chatHub->IsReplaying()) {
+        g_chatHub->StopReplay();
+        return;
+    }
+
+    // Save current settings first so effects use the configuration on screen
+    SaveSettings();
+
+    char* sessionDir = obs_module_config_path("sessions");
+    QString startDir = sessionDir ? QString::fromUtf8(sessionDir) : QString();
+    bfree(sessionDir);
+
+    QString path = QFileDialog::getOpenFileName(this, "Select Session Log", startDir,
+                                                "Chat Session Logs (*.ytcl);;All Files (*)");
+    if (path.isEmpty()) return;
+
+    double speed = m_replaySpeedCombo->currentData().toDouble();
+    if (!g_chatHub->StartReplay(path, speed)) {
+        QMessageBox::warning(this, "Replay", "The selected file is not a valid chat session log.");
+    }
+}
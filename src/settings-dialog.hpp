@@ -4,6 +4,8 @@
 #include <QLineEdit>
 #include <QCheckBox>
 #include <QDoubleSpinBox>
+#include <QSpinBox>
+#include <QComboBox>
 #include <QPushButton>
 #include <QLabel>
 #include <QTabWidget>
@@ -28,6 +30,7 @@ private slots:
     void OnStopMonitoringClicked();
     void OnTestObstructionClicked();
     void OnTestRecoveryClicked();
+    void OnReplaySessionClicked();
     void OnEffectConfigsChanged();
 
 private:
@@ -39,6 +42,7 @@ private:
 
     QLineEdit* m_apiKeyEdit;
     QLineEdit* m_videoIdEdit;
+    QLineEdit* m_apiBaseUrlEdit;
     QLineEdit* m_mainSourceEdit;
 
     QCheckBox* m_enableObstructionsCheck;
@@ -47,6 +51,11 @@ private:
     QDoubleSpinBox* m_obstructionIntensitySpin;
     QDoubleSpinBox* m_recoveryIntensitySpin;
 
+    QDoubleSpinBox* m_overlayLifetimeSpin;
+    QSpinBox* m_maxOverlaysSpin;
+    QComboBox* m_evictionPolicyCombo;
+    QComboBox* m_placementModeCombo;
+
     QPushButton* m_testButton;
     QPushButton* m_startButton;
     QPushButton* m_stopButton;
@@ -58,6 +67,22 @@ private:
     QPushButton* m_testObstructionButton;
     QPushButton* m_testRecoveryButton;
 
+    // Session record/replay
+    QCheckBox* m_recordSessionCheck;
+    QCheckBox* m_skipBacklogCheck;
+    QSpinBox* m_dailyQuotaSpin;
+    QDoubleSpinBox* m_streamHoursSpin;
+    QSpinBox* m_viewerChatLimitSpin;
+    QSpinBox* m_viewerPaidLimitSpin;
+    QSpinBox* m_freeChatSampleSpin;
+    QComboBox* m_replaySpeedCombo;
+    QPushButton* m_replayButton;
+    QCheckBox* m_enableInjectionCheck;
+    QSpinBox* m_injectionPortSpin;
+    QSpinBox* m_injectionRateSpin;
+    QCheckBox* m_enableMetricsExporterCheck;
+    QSpinBox* m_metricsPortSpin;
+
     QLabel* m_statusLabel;
 
     // Effect configuration manager
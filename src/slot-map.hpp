@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Handle into a SlotMap. A handle whose element was removed is detected through
+// the generation counter, so stale handles can be kept around safely.
+struct SlotHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+// Generational slot map with dense storage.
+// Insert, lookup and remove are O(1); elements are packed in a dense array so
+// iteration and uniform random picks need no scan. Removal swaps the last dense
+// element into the hole, so dense order is not insertion order.
+template <typename T>
+class SlotMap {
+public:
+    SlotHandle Insert(T value) {
+        uint32_t slotIndex;
+        if (!m_freeSlots.empty()) {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slotIndex = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{0, 0});
+        }
+
+        Slot& slot = m_slots[slotIndex];
+        slot.denseIndex = static_cast<uint32_t>(m_dense.size());
+        m_dense.push_back(std::move(value));
+        m_denseToSlot.push_back(slotIndex);
+
+        return SlotHandle{slotIndex, slot.generation};
+    }
+
+    bool Contains(SlotHandle handle) const {
+        return handle.index < m_slots.size() &&
+               m_slots[handle.index].generation == handle.generation &&
+               m_slots[handle.index].denseIndex != INVALID_INDEX;
+    }
+
+    T* Get(SlotHandle handle) {
+        return Contains(handle) ? &m_dense[m_slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // Dense index of a live handle, or Size() if the handle is stale
+    size_t IndexOf(SlotHandle handle) const {
+        return Contains(handle) ? m_slots[handle.index].denseIndex : m_dense.size();
+    }
+
+    bool Remove(SlotHandle handle) {
+        if (!Contains(handle)) return false;
+        RemoveAt(m_slots[handle.index].denseIndex);
+        return true;
+    }
+
+    // Swap-remove the element at a dense index
+    void RemoveAt(size_t denseIndex) {
+        uint32_t slotIndex = m_denseToSlot[denseIndex];
+        size_t last = m_dense.size() - 1;
+
+        if (denseIndex != last) {
+            m_dense[denseIndex] = std::move(m_dense[last]);
+            m_denseToSlot[denseIndex] = m_denseToSlot[last];
+            m_slots[m_denseToSlot[denseIndex]].denseIndex = static_cast<uint32_t>(denseIndex);
+        }
+        m_dense.pop_back();
+        m_denseToSlot.pop_back();
+
+        Slot& slot = m_slots[slotIndex];
+        slot.denseIndex = INVALID_INDEX;
+        ++slot.generation;
+        m_freeSlots.push_back(slotIndex);
+    }
+
+    void Clear() {
+        for (uint32_t slotIndex : m_denseToSlot) {
+            m_slots[slotIndex].denseIndex = INVALID_INDEX;
+            ++m_slots[slotIndex].generation;
+            m_freeSlots.push_back(slotIndex);
+        }
+        m_dense.clear();
+        m_denseToSlot.clear();
+    }
+
+    size_t Size() const { return m_dense.size(); }
+    bool Empty() const { return m_dense.empty(); }
+
+    T& At(size_t denseIndex) { return m_dense[denseIndex]; }
+    const T& At(size_t denseIndex) const { return m_dense[denseIndex]; }
+    SlotHandle HandleAt(size_t denseIndex) const {
+        uint32_t slotIndex = m_denseToSlot[denseIndex];
+        return SlotHandle{slotIndex, m_slots[slotIndex].generation};
+    }
+
+    typename std::vector<T>::iterator begin() { return m_dense.begin(); }
+    typename std::vector<T>::iterator end() { return m_dense.end(); }
+    typename std::vector<T>::const_iterator begin() const { return m_dense.begin(); }
+    typename std::vector<T>::const_iterator end() const { return m_dense.end(); }
+
+private:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    struct Slot {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    std::vector<T> m_dense;
+    std::vector<uint32_t> m_denseToSlot;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+};
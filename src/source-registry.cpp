@@ -0,0 +1,118 @@
+#include "source-registry.hpp"
+#include "plugin-metrics.hpp"
+#include <obs-module.h>
+#include <obs-frontend-api.h>
+#include <util/base.h>
+#include <vector>
+#include <QUuid>
+#include "obs-call-profiler.hpp"     // Keep last
+
+// Private settings keys used to recognise plugin-owned sources
+static const char* OWNER_KEY = "obs_youtube_superchat_owner";
+static const char* SESSION_KEY = "obs_youtube_superchat_session";
+
+SourceRegistry& SourceRegistry::Instance() {
+    static SourceRegistry instance;
+    return instance;
+}
+
+SourceRegistry::SourceRegistry()
+    : m_sessionId(QUuid::createUuid().toString(QUuid::WithoutBraces).toStdString())
+{
+}
+
+void SourceRegistry::TagSource(obs_source_t* source) {
+    obs_data_t* priv = obs_source_get_private_settings(source);
+    if (!priv) return;
+
+    obs_data_set_bool(priv, OWNER_KEY, true);
+    obs_data_set_string(priv, SESSION_KEY, m_sessionId.c_str());
+    obs_data_release(priv);
+}
+
+obs_sceneitem_t* SourceRegistry::AddToScene(obs_scene_t* scene, obs_source_t* source) {
+    if (!scene || !source) return nullptr;
+
+    TagSource(source);
+
+    obs_sceneitem_t* item = obs_scene_add(scene, source);
+    if (item) {
+        obs_sceneitem_addref(item);
+        m_items.insert(item);
+        g_metrics.ownedSceneItems.store(m_items.size(), std::memory_order_relaxed);
+    }
+    return item;
+}
+
+void SourceRegistry::Remove(obs_sceneitem_t* item) {
+    if (!item) return;
+
+    auto it = m_items.find(item);
+    if (it == m_items.end()) {
+        // Not ours (or already released) - still honour the removal request
+        obs_sceneitem_remove(item);
+        return;
+    }
+
+    m_items.erase(it);
+    g_metrics.ownedSceneItems.store(m_items.size(), std::memory_order_relaxed);
+    obs_sceneitem_remove(item);
+    obs_sceneitem_release(item);
+}
+
+void SourceRegistry::RemoveAll() {
+    if (m_items.empty()) return;
+
+    size_t count = m_items.size();
+    for (obs_sceneitem_t* item : m_items) {
+        obs_sceneitem_remove(item);
+        obs_sceneitem_release(item);
+    }
+    m_items.clear();
+    g_metrics.ownedSceneItems.store(0, std::memory_order_relaxed);
+
+    blog(LOG_INFO, "[Registry] Removed %zu plugin-owned scene items", count);
+}
+
+int SourceRegistry::RemoveOrphans() {
+    struct OrphanScan {
+        const std::string* sessionId;
+        std::vector<obs_sceneitem_t*> orphans;
+    } scan;
+    scan.sessionId = &m_sessionId;
+
+    auto collectOrphans = [](obs_scene_t*, obs_sceneitem_t* item, void* param) -> bool {
+        auto* scan = static_cast<OrphanScan*>(param);
+
+        obs_data_t* priv = obs_source_get_private_settings(obs_sceneitem_get_source(item));
+        if (priv) {
+            if (obs_data_get_bool(priv, OWNER_KEY) &&
+                *scan->sessionId != obs_data_get_string(priv, SESSION_KEY)) {
+                obs_sceneitem_addref(item);
+                scan->orphans.push_back(item);
+            }
+            obs_data_release(priv);
+        }
+        return true;
+    };
+
+    // Collect first; removing while enumerating would modify the item list under the scene lock
+    struct obs_frontend_source_list scenes = {};
+    obs_frontend_get_scenes(&scenes);
+    for (size_t i = 0; i < scenes.sources.num; ++i) {
+        obs_scene_t* scene = obs_scene_from_source(scenes.sources.array[i]);
+        if (scene) {
+            obs_scene_enum_items(scene, collectOrphans, &scan);
+        }
+    }
+    obs_frontend_source_list_free(&scenes);
+
+    for (obs_sceneitem_t* item : scan.orphans) {
+        blog(LOG_INFO, "[Registry] Removing orphaned item from previous session: %s",
+             obs_source_get_name(obs_sceneitem_get_source(item)));
+        obs_sceneitem_remove(item);
+        obs_sceneitem_release(item);
+    }
+
+    return static_cast<int>(scan.orphans.size());
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <obs.h>
+#include <string>
+#include <unordered_set>
+
+// Central registry of every scene item the plugin creates.
+// Owned sources are tagged in their private settings with the current session id,
+// so items left behind by a crashed (or not cleanly reset) session can be found
+// and removed the next time OBS starts.
+class SourceRegistry {
+public:
+    static SourceRegistry& Instance();
+
+    // Adds the source to the scene, tags it and tracks the resulting scene item
+    obs_sceneitem_t* AddToScene(obs_scene_t* scene, obs_source_t* source);
+
+    // Removes the scene item from whichever scene it is in and stops tracking it
+    void Remove(obs_sceneitem_t* item);
+
+    // Removes every tracked scene item across all scenes - O(owned items)
+    void RemoveAll();
+
+    // Removes plugin-owned items from previous sessions; returns the number removed
+    int RemoveOrphans();
+
+    const std::string& GetSessionId() const { return m_sessionId; }
+    size_t GetOwnedCount() const { return m_items.size(); }
+
+private:
+    SourceRegistry();
+    SourceRegistry(const SourceRegistry&) = delete;
+    SourceRegistry& operator=(const SourceRegistry&) = delete;
+
+    void TagSource(obs_source_t* source);
+
+    std::string m_sessionId;
+    std::unordered_set<obs_sceneitem_t*> m_items;  // Each entry holds a scene item reference
+};
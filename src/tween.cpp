@@ -0,0 +1,181 @@
+#include "tween.hpp"
+#include <obs.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <cmath>
+#include <QTimer>
+
+// Samples per curve; values between samples are linearly interpolated
+static const int EASING_LUT_SIZE = 256;
+
+static float EvaluateEasingExact(EasingCurve curve, float t) {
+    switch (curve) {
+        case EasingCurve::EaseIn:
+            return t * t * t;
+        case EasingCurve::EaseOut: {
+            float u = 1.0f - t;
+            return 1.0f - u * u * u;
+        }
+        case EasingCurve::EaseInOut:
+            return t < 0.5f ? 4.0f * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 3.0f) / 2.0f;
+        case EasingCurve::Back: {
+            const float c1 = 1.70158f;
+            const float c3 = c1 + 1.0f;
+            float u = t - 1.0f;
+            return 1.0f + c3 * u * u * u + c1 * u * u;
+        }
+        case EasingCurve::Bounce: {
+            const float n1 = 7.5625f;
+            const float d1 = 2.75f;
+            if (t < 1.0f / d1) return n1 * t * t;
+            if (t < 2.0f / d1) { t -= 1.5f / d1; return n1 * t * t + 0.75f; }
+            if (t < 2.5f / d1) { t -= 2.25f / d1; return n1 * t * t + 0.9375f; }
+            t -= 2.625f / d1;
+            return n1 * t * t + 0.984375f;
+        }
+        case EasingCurve::Linear:
+        default:
+            return t;
+    }
+}
+
+namespace {
+struct EasingTables {
+    float values[static_cast<int>(EasingCurve::Count)][EASING_LUT_SIZE + 1];
+
+    EasingTables() {
+        for (int c = 0; c < static_cast<int>(EasingCurve::Count); ++c) {
+            for (int i = 0; i <= EASING_LUT_SIZE; ++i) {
+                values[c][i] = EvaluateEasingExact(static_cast<EasingCurve>(c),
+                                                   static_cast<float>(i) / EASING_LUT_SIZE);
+            }
+        }
+    }
+};
+
+const EasingTables& GetEasingTables() {
+    static const EasingTables tables;
+    return tables;
+}
+}
+
+float EvaluateEasing(EasingCurve curve, float t) {
+    int c = static_cast<int>(curve);
+    if (c < 0 || c >= static_cast<int>(EasingCurve::Count)) c = 0;
+
+    const float* table = GetEasingTables().values[c];
+    if (t <= 0.0f) return table[0];
+    if (t >= 1.0f) return table[EASING_LUT_SIZE];
+
+    float pos = t * EASING_LUT_SIZE;
+    int index = static_cast<int>(pos);
+    float frac = pos - index;
+    return table[index] + (table[index + 1] - table[index]) * frac;
+}
+
+TweenEngine::TweenEngine()
+    : m_frameTimer(std::make_unique<QTimer>())
+{
+    // Tick once per output frame
+    int intervalMs = 16;
+    struct obs_video_info ovi;
+    if (obs_get_video_info(&ovi) && ovi.fps_num > 0) {
+        intervalMs = std::max(1, static_cast<int>(1000ULL * ovi.fps_den / ovi.fps_num));
+    }
+    m_frameTimer->setInterval(intervalMs);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(m_frameTimer.get(), &QTimer::timeout, [this]() { Tick(os_gettime_ns()); });
+}
+
+TweenEngine::~TweenEngine() {
+}
+
+TweenEngine::Tween* TweenEngine::Find(int id) {
+    for (auto& tween : m_tweens) {
+        if (tween.id == id) return &tween;
+    }
+    return nullptr;
+}
+
+const TweenEngine::Tween* TweenEngine::Find(int id) const {
+    for (const auto& tween : m_tweens) {
+        if (tween.id == id) return &tween;
+    }
+    return nullptr;
+}
+
+void TweenEngine::AnimateTo(int id, double from, double to, double duration, EasingCurve curve, ApplyFunc apply) {
+    uint64_t now = os_gettime_ns();
+
+    Tween* tween = Find(id);
+    if (!tween) {
+        m_tweens.push_back(Tween{id, from, to, from, now, 0, curve, std::move(apply)});
+        tween = &m_tweens.back();
+    } else {
+        // Retarget: continue from wherever the running tween currently is
+        tween->from = tween->current;
+        tween->to = to;
+        tween->curve = curve;
+        tween->apply = std::move(apply);
+    }
+
+    tween->startNs = now;
+    tween->durationNs = static_cast<uint64_t>(std::max(duration, 0.0) * 1000000000.0);
+
+    if (!m_frameTimer->isActive()) {
+        m_frameTimer->start();
+    }
+}
+
+bool TweenEngine::IsAnimating(int id) const {
+    return Find(id) != nullptr;
+}
+
+double TweenEngine::GetValue(int id, double fallback) const {
+    const Tween* tween = Find(id);
+    return tween ? tween->current : fallback;
+}
+
+void TweenEngine::Cancel(int id) {
+    m_tweens.erase(std::remove_if(m_tweens.begin(), m_tweens.end(),
+                                  [id](const Tween& tween) { return tween.id == id; }),
+                   m_tweens.end());
+    if (m_tweens.empty()) {
+        m_frameTimer->stop();
+    }
+}
+
+void TweenEngine::Clear() {
+    m_tweens.clear();
+    m_frameTimer->stop();
+}
+
+void TweenEngine::Tick(uint64_t nowNs) {
+    for (size_t i = 0; i < m_tweens.size();) {
+        Tween& tween = m_tweens[i];
+
+        float t = 1.0f;
+        if (tween.durationNs > 0 && nowNs < tween.startNs + tween.durationNs) {
+            t = static_cast<float>(static_cast<double>(nowNs - tween.startNs) / tween.durationNs);
+        }
+
+        tween.current = tween.from + (tween.to - tween.from) * EvaluateEasing(tween.curve, t);
+        if (tween.apply) {
+            tween.apply(tween.current);
+        }
+
+        if (t >= 1.0f) {
+            // Swap-remove; order of tweens does not matter
+            if (i != m_tweens.size() - 1) {
+                m_tweens[i] = std::move(m_tweens.back());
+            }
+            m_tweens.pop_back();
+            continue;
+        }
+        ++i;
+    }
+
+    if (m_tweens.empty()) {
+        m_frameTimer->stop();
+    }
+}
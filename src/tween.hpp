@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+// Easing curves available for tweened transitions
+enum class EasingCurve {
+    Linear,         // 一定速度
+    EaseIn,         // 加速
+    EaseOut,        // 減速
+    EaseInOut,      // 加速→減速
+    Back,           // 少し行き過ぎて戻る
+    Bounce,         // バウンド
+    Count
+};
+
+// Looks up a precomputed easing table (t in 0..1); no transcendental math per frame
+float EvaluateEasing(EasingCurve curve, float t);
+
+// Drives value tweens from a frame-rate timer that only runs while something is animating.
+// Each tween is identified by an id; starting a tween on an id that is already running
+// blends from the current value towards the new target instead of restarting.
+class TweenEngine {
+public:
+    using ApplyFunc = std::function<void(double)>;
+
+    TweenEngine();
+    ~TweenEngine();
+
+    void AnimateTo(int id, double from, double to, double duration, EasingCurve curve, ApplyFunc apply);
+    bool IsAnimating(int id) const;
+    double GetValue(int id, double fallback) const;
+    void Cancel(int id);
+    void Clear();
+    size_t GetActiveCount() const { return m_tweens.size(); }
+
+    // Advances every tween to the given os_gettime_ns() timestamp
+    void Tick(uint64_t nowNs);
+
+private:
+    struct Tween {
+        int id;
+        double from;
+        double to;
+        double current;
+        uint64_t startNs;
+        uint64_t durationNs;
+        EasingCurve curve;
+        ApplyFunc apply;
+    };
+
+    Tween* Find(int id);
+    const Tween* Find(int id) const;
+
+    std::vector<Tween> m_tweens;
+    std::unique_ptr<QTimer> m_frameTimer;
+};
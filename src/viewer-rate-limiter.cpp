@@ -0,0 +1,98 @@
+#include "viewer-rate-limiter.hpp"
+#include "id-hash.hpp"
+#include <algorithm>
+
+ViewerRateLimiter::ViewerRateLimiter(size_t capacity)
+    : m_mask(0)
+    , m_capacity(capacity == 0 ? 1 : capacity)
+    , m_count(0)
+    , m_hand(0)
+    , m_epochNs(0)
+{
+    size_t tableSize = IdTableSize(m_capacity);
+    m_table.assign(tableSize, Entry());
+    m_mask = tableSize - 1;
+}
+
+void ViewerRateLimiter::SetLimit(ViewerEventClass eventClass, double perMinute, double burst) {
+    Limit& limit = m_limits[static_cast<size_t>(eventClass)];
+    limit.perMs = std::max(0.0, perMinute) / 60000.0;
+    limit.burst = std::max(1.0, burst);
+}
+
+size_t ViewerRateLimiter::FindSlot(uint64_t key) const {
+    return IdTableFind(m_table, m_mask, key, KeyOf);
+}
+
+bool ViewerRateLimiter::Admit(std::string_view channelId, ViewerEventClass eventClass, uint64_t nowNs) {
+    const Limit& limit = m_limits[static_cast<size_t>(eventClass)];
+    if (limit.perMs <= 0.0 || channelId.empty()) return true;
+
+    if (m_epochNs == 0) {
+        m_epochNs = nowNs;
+    }
+    uint32_t nowMs = static_cast<uint32_t>((nowNs - m_epochNs) / 1000000ULL);
+
+    uint64_t key = IdFingerprint(channelId);
+    size_t slot = FindSlot(key);
+    if (m_table[slot].key == 0) {
+        if (m_count == m_capacity) {
+            EvictOne();
+            slot = FindSlot(key);
+        }
+
+        Entry& entry = m_table[slot];
+        entry.key = key;
+        entry.lastRefillMs = nowMs;
+        for (size_t i = 0; i < CLASS_COUNT; i++) {
+            entry.tokens[i] = static_cast<float>(m_limits[i].burst);
+        }
+        m_count++;
+    }
+
+    Entry& entry = m_table[slot];
+    entry.referenced = true;
+
+    // Lazy refill of every class since the viewer's last event
+    uint32_t elapsedMs = nowMs - entry.lastRefillMs;
+    if (elapsedMs > 0) {
+        for (size_t i = 0; i < CLASS_COUNT; i++) {
+            double refilled = entry.tokens[i] + elapsedMs * m_limits[i].perMs;
+            entry.tokens[i] = static_cast<float>(std::min(m_limits[i].burst, refilled));
+        }
+        entry.lastRefillMs = nowMs;
+    }
+
+    float& tokens = entry.tokens[static_cast<size_t>(eventClass)];
+    if (tokens < 1.0f) return false;
+    tokens -= 1.0f;
+    return true;
+}
+
+void ViewerRateLimiter::EvictOne() {
+    // At most 50% load: a victim turns up within two sweeps
+    while (true) {
+        size_t slot = m_hand;
+        m_hand = (m_hand + 1) & m_mask;
+
+        Entry& entry = m_table[slot];
+        if (entry.key == 0) continue;
+        if (entry.referenced) {
+            entry.referenced = false;
+            continue;
+        }
+        EraseAt(slot);
+        return;
+    }
+}
+
+void ViewerRateLimiter::EraseAt(size_t slot) {
+    m_table[IdTableErase(m_table, m_mask, slot, KeyOf)] = Entry();
+    m_count--;
+}
+
+void ViewerRateLimiter::Clear() {
+    std::fill(m_table.begin(), m_table.end(), Entry());
+    m_count = 0;
+    m_hand = 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#define DEFAULT_VIEWER_CHAT_PER_MINUTE 6    // Regular chat messages per viewer
+#define DEFAULT_VIEWER_PAID_PER_MINUTE 30   // Super Chats and Super Stickers per viewer
+
+// Limits are kept separately for each class of event
+enum class ViewerEventClass {
+    FreeChat,
+    Paid,
+    Count
+};
+
+// Per-viewer token buckets in a fixed-size table.
+//
+// Viewers are keyed by a 64-bit fingerprint of their channel ID in an open-addressing
+// table (linear probing, at most 50% load). Buckets are refilled lazily from the time of
+// the viewer's last event, so idle viewers cost nothing. When the table is full a CLOCK
+// hand sweeps it: recently seen viewers get a second chance, the first one that was not
+// seen since the last sweep is evicted. An evicted viewer starts again with a full
+// bucket, the same as one who was never seen, so memory stays constant no matter how
+// large the audience is.
+class ViewerRateLimiter {
+public:
+    explicit ViewerRateLimiter(size_t capacity = 8192);
+
+    // perMinute <= 0 disables the limit for that class
+    void SetLimit(ViewerEventClass eventClass, double perMinute, double burst);
+
+    // Takes a token from the viewer's bucket; false if the event is over the limit
+    bool Admit(std::string_view channelId, ViewerEventClass eventClass, uint64_t nowNs);
+    void Clear();
+
+    size_t Size() const { return m_count; }
+    size_t Capacity() const { return m_capacity; }
+    size_t MemoryBytes() const { return m_table.capacity() * sizeof(Entry); }
+
+private:
+    static constexpr size_t CLASS_COUNT = static_cast<size_t>(ViewerEventClass::Count);
+
+    struct Entry {
+        uint64_t key = 0;                       // Channel ID fingerprint; 0 = empty slot
+        uint32_t lastRefillMs = 0;              // Relative to m_epochNs; wraps after 49 days
+        bool referenced = false;                // CLOCK bit
+        std::array<float, CLASS_COUNT> tokens{};
+    };
+
+    struct Limit {
+        double perMs = 0.0;     // 0 = unlimited
+        double burst = 1.0;
+    };
+
+    static uint64_t KeyOf(const Entry& entry) { return entry.key; }
+    size_t FindSlot(uint64_t key) const;
+    void EvictOne();
+    void EraseAt(size_t slot);
+
+    std::vector<Entry> m_table;
+    size_t m_mask;
+    size_t m_capacity;          // Entries kept before eviction starts
+    size_t m_count;
+    size_t m_hand;              // CLOCK position
+    uint64_t m_epochNs;         // 0 until the first event
+    std::array<Limit, CLASS_COUNT> m_limits;
+};
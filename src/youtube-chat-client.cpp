@@ -1,33 +1,121 @@
 #include "youtube-chat-client.hpp"
+#include "chat-page-parser.hpp"
+#include "chat-session-log.hpp"
+#include "currency-table.hpp"
+#include "plugin-log.hpp"
+#include "plugin-metrics.hpp"
+#include "plugin-main.hpp"
+#include "recent-id-set.hpp"
 #include <obs-module.h>
 #include <util/base.h>
+#include <util/platform.h>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QPointer>
+#include <QThreadPool>
 #include <QUrlQuery>
+#include <algorithm>
+#include <memory>
+
+// How long to wait before asking videos.list again when the video has no active chat
+static const int NO_LIVE_CHAT_RETRY_MS = 30 * 1000;
+
+// Number of recent message ids remembered for de-duplication (~20 full pages)
+static const size_t RECENT_ID_CAPACITY = 40000;
+
+// Partial-response masks: only the fields the parser actually reads are sent back
+static const char* VIDEOS_FIELDS = "items(liveStreamingDetails(activeLiveChatId))";
+static const char* MESSAGES_FIELDS =
+    "nextPageToken,pollingIntervalMillis,"
+    "items(id,snippet(type,publishedAt,displayMessage,"
+    "superChatDetails(amountMicros,currency,userComment),"
+    "superStickerDetails(amountMicros,currency),"
+    "textMessageDetails(messageText)),"
+    "authorDetails(channelId,displayName))";
+
+// Google APIs only compress responses for clients whose User-Agent contains "gzip".
+// QNetworkAccessManager sends Accept-Encoding and inflates the body transparently.
+static const char* REQUEST_USER_AGENT = PLUGIN_NAME "/" PLUGIN_VERSION " (gzip)";
+
+// A stalled transfer is aborted after this long (or one poll interval, if longer) and reported
+// as a network failure; the scheduler waits for every request to finish before the next poll
+static const int MIN_REQUEST_TIMEOUT_MS = 10 * 1000;
+
+static QNetworkRequest MakeApiRequest(const QString& url, int pollIntervalMs) {
+    QNetworkRequest request{QUrl(url)};
+    request.setHeader(QNetworkRequest::UserAgentHeader, QByteArray(REQUEST_USER_AGENT));
+    request.setTransferTimeout(std::max(pollIntervalMs, MIN_REQUEST_TIMEOUT_MS));
+    return request;
+}
 
 YouTubeChatClient::YouTubeChatClient(QObject* parent)
+    : YouTubeChatClient(nullptr, nullptr, parent)
+{
+}
+
+YouTubeChatClient::YouTubeChatClient(QNetworkAccessManager* network, std::shared_ptr<QuotaTracker> quota,
+                                     QObject* parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
-    , m_pollTimer(new QTimer(this))
+    , m_networkManager(network ? network : new QNetworkAccessManager(this))
+    , m_apiBaseUrl(QString::fromLatin1(DEFAULT_API_BASE_URL))
+    , m_quota(quota ? std::move(quota) : std::make_shared<QuotaTracker>())
+    , m_scheduler(new PollScheduler(m_quota.get(), this))
+    , m_watermarkMs(0)
+    , m_skipBacklog(true)
+    , m_startedAtMs(0)
+    , m_awaitingFirstPage(false)
     , m_isRunning(false)
     , m_pollIntervalMs(5000)  // Poll every 5 seconds
+    , m_pageGeneration(0)
+    , m_recordingEnabled(false)
+    , m_recorder(std::make_unique<ChatSessionRecorder>())
+    , m_replayer(new ChatSessionReplayer(this))
+    , m_recentIds(std::make_unique<RecentIdSet>(RECENT_ID_CAPACITY))
 {
-    connect(m_pollTimer, &QTimer::timeout, this, &YouTubeChatClient::PollChat);
+    m_scheduler->SetPollFunc([this]() { PollChat(); });
+    g_metrics.dedupeCacheBytes.fetch_add(m_recentIds->MemoryBytes(), std::memory_order_relaxed);
 }
 
 YouTubeChatClient::~YouTubeChatClient() {
     Stop();
+    g_metrics.dedupeCacheBytes.fetch_sub(m_recentIds->MemoryBytes(), std::memory_order_relaxed);
 }
 
 void YouTubeChatClient::SetApiKey(const std::string& apiKey) {
     m_apiKey = apiKey;
+    BuildMessagesUrlPrefix();
+}
+
+void YouTubeChatClient::SetApiBaseUrl(const std::string& baseUrl) {
+    m_apiBaseUrl = QString::fromStdString(baseUrl).trimmed();
+    while (m_apiBaseUrl.endsWith('/')) {
+        m_apiBaseUrl.chop(1);
+    }
+    if (m_apiBaseUrl.isEmpty()) {
+        m_apiBaseUrl = QString::fromLatin1(DEFAULT_API_BASE_URL);
+    }
+    BuildMessagesUrlPrefix();
 }
 
 void YouTubeChatClient::SetVideoId(const std::string& videoId) {
+    // Saving settings re-applies the same ID; keep the pagination state in that case
+    if (videoId == m_videoId) return;
+
     m_videoId = videoId;
     m_liveChatId.clear();
     m_nextPageToken.clear();
+    m_watermarkMs = 0;
+    m_messagesUrlPrefix.clear();
+    ++m_pageGeneration;
+
+    // Abandon the request for the old video and start over right away
+    if (m_isRunning) {
+        m_scheduler->Start();
+    }
 }
 
 void YouTubeChatClient::SetDonationCallback(DonationCallback callback) {
@@ -44,33 +132,115 @@ void YouTubeChatClient::Start() {
 
     blog(LOG_INFO, "[YouTube Chat] Starting chat monitoring for video: %s", m_videoId.c_str());
 
-    // First, get the live chat ID
-    FetchLiveChatId();
+    if (m_recordingEnabled) {
+        char* sessionDir = obs_module_config_path("sessions");
+        if (sessionDir) {
+            QDir().mkpath(QString::fromUtf8(sessionDir));
+            QString fileName = QString("session-%1-%2.ytcl")
+                                   .arg(QString::fromStdString(m_videoId))
+                                   .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+            m_recorder->Open(QDir(QString::fromUtf8(sessionDir)).filePath(fileName));
+            bfree(sessionDir);
+        }
+    }
 
+    // The first poll fetches the live chat ID, unless a restored cursor already has it
+    if (!m_liveChatId.empty()) {
+        blog(LOG_INFO, "[YouTube Chat] Resuming live chat %s", m_liveChatId.c_str());
+    }
+
+    m_startedAtMs = QDateTime::currentMSecsSinceEpoch();
+    m_awaitingFirstPage = true;
     m_isRunning = true;
-    m_pollTimer->start(m_pollIntervalMs);
+    m_scheduler->Start();
 }
 
 void YouTubeChatClient::Stop() {
     if (!m_isRunning) return;
 
     blog(LOG_INFO, "[YouTube Chat] Stopping chat monitoring");
-    m_pollTimer->stop();
+    m_scheduler->Stop();
     m_isRunning = false;
+    ++m_pageGeneration;
+    m_recorder->Close();
+}
+
+ChatCursor YouTubeChatClient::GetCursor() const {
+    ChatCursor cursor;
+    cursor.liveChatId = m_liveChatId;
+    cursor.pageToken = m_nextPageToken;
+    cursor.watermarkMs = m_watermarkMs;
+    return cursor;
+}
+
+void YouTubeChatClient::RestoreCursor(const ChatCursor& cursor) {
+    if (m_isRunning) return;
+
+    m_liveChatId = cursor.liveChatId;
+    m_nextPageToken = cursor.pageToken;
+    m_watermarkMs = cursor.watermarkMs;
+    BuildMessagesUrlPrefix();
+}
+
+bool YouTubeChatClient::StartReplay(const QString& path, double speed) {
+    if (!m_replayer->Open(path)) {
+        return false;
+    }
+
+    // A replay is its own session; ids seen live (or in a previous replay) must not suppress it
+    m_recentIds->Clear();
+
+    m_replayer->Start(speed, [this](const char* data, size_t size) {
+        ReplayPage(data, size);
+    });
+    return true;
+}
+
+void YouTubeChatClient::StopReplay() {
+    m_replayer->Stop();
+}
+
+bool YouTubeChatClient::IsReplaying() const {
+    return m_replayer->IsRunning();
+}
+
+void YouTubeChatClient::ReplayPage(const char* data, size_t size) {
+    // Replayed pages never touch the live pagination state
+    uint64_t receivedNs = os_gettime_ns();
+    ChatPage page = ParseChatPage(data, size);
+    page.receivedNs = receivedNs;
+    if (!page.valid) {
+        g_metrics.chatParseErrors.fetch_add(1, std::memory_order_relaxed);
+        blog(LOG_WARNING, "[YouTube Chat] Skipping unparsable replayed page: %s", page.error.c_str());
+        return;
+    }
+
+    g_metrics.RecordChatPage(page.bytes, page.messages.size(), page.parseTimeNs);
+    ProcessChatMessages(page);
 }
 
 void YouTubeChatClient::FetchLiveChatId() {
     if (m_apiKey.empty() || m_videoId.empty()) return;
 
     // Get video details to extract liveChatId
-    QString url = QString("https://www.googleapis.com/youtube/v3/videos?part=liveStreamingDetails&id=%1&key=%2")
+    QString url = QString("%1/youtube/v3/videos?part=liveStreamingDetails&id=%2&fields=%3&key=%4")
+                      .arg(m_apiBaseUrl)
                       .arg(QString::fromStdString(m_videoId))
+                      .arg(QString::fromLatin1(VIDEOS_FIELDS))
                       .arg(QString::fromStdString(m_apiKey));
 
-    QNetworkRequest request(url);
+    QNetworkRequest request = MakeApiRequest(url, m_pollIntervalMs);
     QNetworkReply* reply = m_networkManager->get(request);
+    m_scheduler->RequestStarted(QUOTA_COST_VIDEOS_LIST);
+
+    uint64_t generation = m_pageGeneration;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, generation]() {
+        if (generation != m_pageGeneration) {
+            // Stopped or switched video while the request was in flight
+            reply->deleteLater();
+            return;
+        }
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         if (reply->error() == QNetworkReply::NoError) {
             QByteArray data = reply->readAll();
             QJsonDocument doc = QJsonDocument::fromJson(data);
@@ -82,20 +252,36 @@ void YouTubeChatClient::FetchLiveChatId() {
                     QJsonObject liveDetails = item["liveStreamingDetails"].toObject();
                     if (liveDetails.contains("activeLiveChatId")) {
                         m_liveChatId = liveDetails["activeLiveChatId"].toString().toStdString();
+                        BuildMessagesUrlPrefix();
                         blog(LOG_INFO, "[YouTube Chat] Live chat ID: %s", m_liveChatId.c_str());
                     } else {
                         blog(LOG_WARNING, "[YouTube Chat] No active live chat found");
                     }
                 }
             }
+
+            // Poll messages right away once the chat is known; otherwise check again later
+            m_scheduler->RequestSucceeded(m_liveChatId.empty() ? NO_LIVE_CHAT_RETRY_MS : 0);
         } else {
             blog(LOG_ERROR, "[YouTube Chat] Failed to fetch live chat ID: %s",
                     reply->errorString().toStdString().c_str());
+            ReportFailure(reply, reply->readAll());
         }
         reply->deleteLater();
     });
 }
 
+void YouTubeChatClient::BuildMessagesUrlPrefix() {
+    m_messagesUrlPrefix.clear();
+    if (m_liveChatId.empty() || m_apiKey.empty()) return;
+
+    m_messagesUrlPrefix = QString("%1/youtube/v3/liveChat/messages?liveChatId=%2&part=snippet,authorDetails&fields=%3&key=%4")
+                              .arg(m_apiBaseUrl)
+                              .arg(QString::fromLatin1(QUrl::toPercentEncoding(QString::fromStdString(m_liveChatId))))
+                              .arg(QString::fromLatin1(QUrl::toPercentEncoding(QString::fromLatin1(MESSAGES_FIELDS), ",")))
+                              .arg(QString::fromStdString(m_apiKey));
+}
+
 void YouTubeChatClient::PollChat() {
     if (m_liveChatId.empty()) {
         // Try to fetch live chat ID again
@@ -103,17 +289,19 @@ void YouTubeChatClient::PollChat() {
         return;
     }
 
-    // Build URL with pagination token
-    QString url = QString("https://www.googleapis.com/youtube/v3/liveChat/messages?liveChatId=%1&part=snippet,authorDetails&key=%2")
-                      .arg(QString::fromStdString(m_liveChatId))
-                      .arg(QString::fromStdString(m_apiKey));
-
+    // Only the page token changes between polls
+    QString url = m_messagesUrlPrefix;
     if (!m_nextPageToken.empty()) {
-        url += QString("&pageToken=%1").arg(QString::fromStdString(m_nextPageToken));
+        url += QStringLiteral("&pageToken=");
+        url += QString::fromLatin1(QUrl::toPercentEncoding(QString::fromStdString(m_nextPageToken)));
     }
 
-    QNetworkRequest request(url);
+    QNetworkRequest request = MakeApiRequest(url, m_pollIntervalMs);
     QNetworkReply* reply = m_networkManager->get(request);
+    reply->setProperty("pageGeneration", static_cast<qulonglong>(m_pageGeneration));
+    reply->setProperty("backlogPage", m_nextPageToken.empty());
+    reply->setProperty("sentNs", static_cast<qulonglong>(os_gettime_ns()));
+    m_scheduler->RequestStarted(QUOTA_COST_LIVE_CHAT_MESSAGES);
 
     connect(reply, &QNetworkReply::finished, this, &YouTubeChatClient::OnChatDataReceived);
     connect(reply, QOverload<QNetworkReply::NetworkError>::of(&QNetworkReply::errorOccurred),
@@ -124,29 +312,128 @@ void YouTubeChatClient::OnChatDataReceived() {
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
+    uint64_t generation = reply->property("pageGeneration").toULongLong();
+    if (generation != m_pageGeneration) {
+        // Stopped or switched video while the request was in flight
+        reply->deleteLater();
+        return;
+    }
+
     if (reply->error() == QNetworkReply::NoError) {
+        uint64_t receivedNs = os_gettime_ns();
         QByteArray data = reply->readAll();
-        QJsonDocument doc = QJsonDocument::fromJson(data);
-        QJsonObject obj = doc.object();
-
-        // Update next page token
-        if (obj.contains("nextPageToken")) {
-            m_nextPageToken = obj["nextPageToken"].toString().toStdString();
+        m_recorder->Append(data);
+        g_metrics.RecordPoll(receivedNs - reply->property("sentNs").toULongLong());
+
+        // Parse on a pool thread; the page is handed back to the UI thread as one batch
+        QPointer<YouTubeChatClient> self(this);
+        bool backlogPage = reply->property("backlogPage").toBool();
+        QThreadPool::globalInstance()->start([self, data, generation, backlogPage, receivedNs]() {
+            auto page = std::make_shared<ChatPage>(ParseChatPage(data.constData(), static_cast<size_t>(data.size())));
+            page->receivedNs = receivedNs;
+            QMetaObject::invokeMethod(QCoreApplication::instance(), [self, page, generation, backlogPage]() {
+                if (self) {
+                    self->OnChatPageParsed(generation, *page, backlogPage);
+                }
+            }, Qt::QueuedConnection);
+        });
+    } else {
+        // A restored liveChatId/pageToken may belong to an ended chat; start over on the next poll
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        QByteArray body = reply->readAll();
+        bool quotaError = body.contains("quotaExceeded") || body.contains("rateLimitExceeded");
+        if ((status == 400 || status == 403 || status == 404) && !quotaError) {
+            blog(LOG_WARNING, "[YouTube Chat] Live chat request rejected (HTTP %d), refetching live chat ID", status);
+            m_liveChatId.clear();
+            m_nextPageToken.clear();
+            m_messagesUrlPrefix.clear();
         }
 
-        // Update polling interval based on API response
-        if (obj.contains("pollingIntervalMillis")) {
-            m_pollIntervalMs = obj["pollingIntervalMillis"].toInt();
-            m_pollTimer->setInterval(m_pollIntervalMs);
-        }
+        ReportFailure(reply, body);
+    }
+
+    reply->deleteLater();
+}
+
+void YouTubeChatClient::OnChatPageParsed(uint64_t generation, const ChatPage& page, bool backlogPage) {
+    if (generation != m_pageGeneration) {
+        // Stopped or switched video while this page was being parsed
+        return;
+    }
+
+    if (!page.valid) {
+        g_metrics.chatParseErrors.fetch_add(1, std::memory_order_relaxed);
+        blog(LOG_ERROR, "[YouTube Chat] Failed to parse chat page: %s", page.error.c_str());
+        m_scheduler->RequestFailed(PollFailure::Server);
+        return;
+    }
+
+    g_metrics.RecordChatPage(page.bytes, page.messages.size(), page.parseTimeNs);
+    m_stats.pagesReceived++;
+    m_stats.messagesReceived += page.messages.size();
+    m_stats.lastPageAtMs = QDateTime::currentMSecsSinceEpoch();
+    blog(LOG_DEBUG, "[YouTube Chat] Parsed %zu messages (%zu bytes) in %.3f ms, %.1f MB/s average",
+         page.messages.size(), page.bytes, page.parseTimeNs / 1000000.0,
+         g_metrics.GetChatParseBytesPerSecond() / (1024.0 * 1024.0));
+
+    // Update next page token
+    if (!page.nextPageToken.empty()) {
+        m_nextPageToken = page.nextPageToken;
+    }
 
-        // Process messages
-        if (obj.contains("items")) {
-            ProcessChatMessages(obj["items"].toArray());
+    // Update polling interval based on API response; the scheduler may stretch it
+    if (page.pollingIntervalMillis >= 0) {
+        m_pollIntervalMs = page.pollingIntervalMillis;
+    }
+    m_scheduler->RequestSucceeded(m_pollIntervalMs);
+
+    // Watermark from before this page; the page itself may only raise it
+    int64_t previousWatermark = m_watermarkMs;
+    for (const ChatPageMessage& message : page.messages) {
+        m_watermarkMs = std::max(m_watermarkMs, message.publishedAtMs);
+    }
+
+    bool firstPage = m_awaitingFirstPage;
+    m_awaitingFirstPage = false;
+
+    if (backlogPage && previousWatermark == 0 && m_skipBacklog) {
+        // Fresh start: this page is chat history, remember it without firing effects
+        for (const ChatPageMessage& message : page.messages) {
+            if (!message.id.empty()) {
+                m_recentIds->Insert(message.id);
+            }
         }
+        blog(LOG_INFO, "[YouTube Chat] Skipped %d backlog messages", static_cast<int>(page.messages.size()));
+        return;
     }
 
-    reply->deleteLater();
+    // Without a pageToken the API replays history, and a pageToken kept over a restart returns
+    // everything posted while stopped; either way nothing at or below the watermark fires again.
+    // In skip-backlog mode nothing posted before Start() fires at all, however many pages the
+    // downtime spans.
+    int64_t minPublishedMs = backlogPage || firstPage ? previousWatermark : 0;
+    if (m_skipBacklog) {
+        minPublishedMs = std::max(minPublishedMs, m_startedAtMs);
+    }
+    ProcessChatMessages(page, minPublishedMs);
+}
+
+void YouTubeChatClient::ReportFailure(QNetworkReply* reply, const QByteArray& body) {
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    PollFailure failure = PollFailure::Network;
+    if (body.contains("quotaExceeded")) {
+        failure = PollFailure::QuotaExceeded;
+    } else if (status == 429 || body.contains("rateLimitExceeded")) {
+        failure = PollFailure::RateLimited;
+    } else if (status >= 500) {
+        failure = PollFailure::Server;
+    } else if (status != 0) {
+        failure = PollFailure::Rejected;
+    }
+
+    m_stats.requestFailures++;
+    m_scheduler->RequestFailed(failure);
 }
 
 void YouTubeChatClient::OnNetworkError(QNetworkReply::NetworkError error) {
@@ -156,108 +443,117 @@ void YouTubeChatClient::OnNetworkError(QNetworkReply::NetworkError error) {
     }
 }
 
-void YouTubeChatClient::ProcessChatMessages(const QJsonArray& items) {
-    blog(LOG_INFO, "[YouTube Chat] Processing %d messages", items.size());
+void YouTubeChatClient::ProcessChatMessages(const ChatPage& page, int64_t minPublishedMs) {
+    PLUGIN_LOG(LogCategory::Chat, LOG_INFO, "[YouTube Chat] Processing %d messages", static_cast<int>(page.messages.size()));
+
+    for (const ChatPageMessage& message : page.messages) {
+        if (message.publishedAtMs != 0 && message.publishedAtMs <= minPublishedMs) {
+            continue;
+        }
 
-    for (const QJsonValue& value : items) {
-        QJsonObject message = value.toObject();
-        QJsonObject snippet = message["snippet"].toObject();
-        QJsonObject authorDetails = message["authorDetails"].toObject();
+        // Refetched pages (after errors or a lost pageToken) must not fire effects twice
+        if (!message.id.empty() && !m_recentIds->Insert(message.id)) {
+            g_metrics.chatDuplicatesSuppressed.fetch_add(1, std::memory_order_relaxed);
+            m_stats.duplicatesSuppressed++;
+            PLUGIN_LOG(LogCategory::Chat, LOG_DEBUG, "[YouTube Chat] Skipping duplicate message %s", message.id.c_str());
+            continue;
+        }
 
         // Log message type for debugging
-        QString messageType = message["snippet"].toObject()["type"].toString();
-        blog(LOG_DEBUG, "[YouTube Chat] Message type: %s", messageType.toStdString().c_str());
+        PLUGIN_LOG(LogCategory::Chat, LOG_DEBUG, "[YouTube Chat] Message type: %s", message.type.c_str());
 
         // Check if it's a super chat or super sticker
-        if (snippet.contains("superChatDetails")) {
-            QJsonObject superChat = snippet["superChatDetails"].toObject();
-
+        if (message.kind == ChatPageMessage::Kind::SuperChat) {
             DonationEvent event;
             event.type = DonationType::SuperChat;
-            event.displayName = authorDetails["displayName"].toString().toStdString();
+            event.displayName = message.displayName;
+            event.authorChannelId = message.channelId;
             // SuperChat message can be in displayMessage or superChatDetails.userComment
-            event.message = snippet.contains("displayMessage")
-                ? snippet["displayMessage"].toString().toStdString()
-                : superChat["userComment"].toString().toStdString();
-
-            // Parse amount
-            if (superChat.contains("amountMicros")) {
-                double micros = superChat["amountMicros"].toString().toDouble();
-                event.amount = micros / 1000000.0;
-            }
-
-            event.currency = superChat.value("currency").toString().toStdString();
+            event.message = !message.displayMessage.empty() ? message.displayMessage : message.messageText;
+            event.currency = message.currency;
 
             // Convert to JPY for consistent processing
-            event.amount = ConvertCurrency(event.amount, event.currency);
+            if (!SetAmount(event, message.amountMicros)) continue;
 
-            blog(LOG_INFO, "[YouTube Chat] SuperChat from %s: ¥%.0f - %s",
-                event.displayName.c_str(), event.amount, event.message.c_str());
+            PLUGIN_LOG(LogCategory::Chat, LOG_INFO, "[YouTube Chat] SuperChat from %s: ¥%.0f - %s",
+                event.displayName.c_str(), event.amount.ToUnits(), event.message.c_str());
 
-            if (m_donationCallback) {
-                m_donationCallback(event);
-            }
+            DispatchEvent(event, page, message.publishedAtMs);
         }
-        else if (snippet.contains("superStickerDetails")) {
-            QJsonObject superSticker = snippet["superStickerDetails"].toObject();
-
+        else if (message.kind == ChatPageMessage::Kind::SuperSticker) {
             DonationEvent event;
             event.type = DonationType::SuperSticker;
-            event.displayName = authorDetails["displayName"].toString().toStdString();
+            event.displayName = message.displayName;
+            event.authorChannelId = message.channelId;
             event.message = "";
-
-            // Parse amount
-            if (superSticker.contains("amountMicros")) {
-                double micros = superSticker["amountMicros"].toString().toDouble();
-                event.amount = micros / 1000000.0;
-            }
-
-            event.currency = superSticker.value("currency").toString().toStdString();
+            event.currency = message.currency;
 
             // Convert to JPY
-            event.amount = ConvertCurrency(event.amount, event.currency);
+            if (!SetAmount(event, message.amountMicros)) continue;
 
-            blog(LOG_INFO, "[YouTube Chat] SuperSticker from %s: ¥%.0f",
-                event.displayName.c_str(), event.amount);
+            PLUGIN_LOG(LogCategory::Chat, LOG_INFO, "[YouTube Chat] SuperSticker from %s: ¥%.0f",
+                event.displayName.c_str(), event.amount.ToUnits());
 
-            if (m_donationCallback) {
-                m_donationCallback(event);
-            }
+            DispatchEvent(event, page, message.publishedAtMs);
         }
-        else if (snippet.contains("textMessageDetails")) {
-            // Regular chat message - treat as low value super chat for obstruction effects
-            QJsonObject textMessageDetails = snippet["textMessageDetails"].toObject();
-
+        else if (message.kind == ChatPageMessage::Kind::TextMessage) {
+            // Regular chat message - keyword triggers, or a low value obstruction effect
             DonationEvent event;
-            event.type = DonationType::SuperChat;
-            event.displayName = authorDetails["displayName"].toString().toStdString();
-            event.message = textMessageDetails["messageText"].toString().toStdString();
-            event.amount = 100.0;  // Treat as 100 JPY for obstruction effect
+            event.type = DonationType::ChatMessage;
+            event.displayName = message.displayName;
+            event.authorChannelId = message.channelId;
+            event.message = message.messageText;
+            event.amount = CHAT_MESSAGE_AMOUNT;
+            event.originalAmount = event.amount;
             event.currency = "JPY";
 
-            blog(LOG_INFO, "[YouTube Chat] Regular chat from %s: %s",
+            PLUGIN_LOG(LogCategory::Chat, LOG_INFO, "[YouTube Chat] Regular chat from %s: %s",
                 event.displayName.c_str(), event.message.c_str());
 
-            if (m_donationCallback) {
-                m_donationCallback(event);
-            }
+            DispatchEvent(event, page, message.publishedAtMs);
         }
     }
 }
 
-double YouTubeChatClient::ConvertCurrency(double amount, const std::string& currency) {
-    // Simple currency conversion (in production, use real exchange rates)
-    // These are approximate rates for demonstration
-    if (currency == "JPY") {
-        return amount;
-    } else if (currency == "USD") {
-        return amount * 150.0;  // 1 USD = 150 JPY
-    } else if (currency == "EUR") {
-        return amount * 160.0;  // 1 EUR = 160 JPY
-    } else if (currency == "GBP") {
-        return amount * 190.0;  // 1 GBP = 190 JPY
+void YouTubeChatClient::DispatchEvent(DonationEvent& event, const ChatPage& page, int64_t publishedAtMs) {
+    event.sourceId = m_videoId;
+    event.publishedAtMs = publishedAtMs;
+    event.timestamps.receivedNs = page.receivedNs;
+    event.timestamps.parsedNs = page.parsedNs;
+    if (publishedAtMs > 0 && page.receivedNs > 0 && !m_replayer->IsRunning()) {
+        // Map publishedAt onto the monotonic clock through the current wall/monotonic offset.
+        // A server clock ahead of ours would put it after receipt; clamp it to receipt instead.
+        // Replayed pages carry the original session's publishedAt, which says nothing here.
+        uint64_t nowNs = os_gettime_ns();
+        int64_t ageMs = std::max<int64_t>(0, QDateTime::currentMSecsSinceEpoch() - publishedAtMs);
+        uint64_t ageNs = static_cast<uint64_t>(ageMs) * 1000000ULL;
+        event.timestamps.publishedNs = ageNs < nowNs ? std::min(nowNs - ageNs, page.receivedNs) : 0;
+    }
+    m_stats.eventsDispatched++;
+
+    if (m_donationCallback) {
+        m_donationCallback(event);
+    }
+}
+
+bool YouTubeChatClient::SetAmount(DonationEvent& event, int64_t amountMicros) {
+    event.originalAmount = Money::FromMicros(amountMicros);
+    if (CurrencyTable::Instance().ToJpy(event.originalAmount, event.currency, &event.amount)) {
+        return true;
     }
 
-    // Default: assume USD
-    return amount * 150.0;
+    // No rate: dropping the event beats triggering an effect for a guessed amount
+    g_metrics.unknownCurrencyDonations.fetch_add(1, std::memory_order_relaxed);
+    PLUGIN_LOG(LogCategory::Chat, LOG_WARNING, "[YouTube Chat] No JPY rate for currency '%s'; ignoring %.2f %s from %s",
+        event.currency.c_str(), event.originalAmount.ToUnits(), event.currency.c_str(), event.displayName.c_str());
+    return false;
+}
+
+const char* DonationTypeName(DonationType type) {
+    switch (type) {
+    case DonationType::SuperChat:    return "SuperChat";
+    case DonationType::SuperSticker: return "SuperSticker";
+    case DonationType::ChatMessage:  return "ChatMessage";
+    default:                         return "?";
+    }
 }
@@ -1,23 +1,74 @@
 #pragma once
 
+#include "money.hpp"
+#include "poll-scheduler.hpp"
 #include <QObject>
-#include <QTimer>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <string>
 #include <functional>
+#include <cstdint>
+#include <memory>
 
 enum class DonationType {
     SuperChat,
-    SuperSticker
+    SuperSticker,
+    ChatMessage     // Regular chat; keyword triggers, otherwise a low-value obstruction
+};
+
+const char* DonationTypeName(DonationType type);
+
+// What a regular chat message counts as when no keyword matches
+inline constexpr Money CHAT_MESSAGE_AMOUNT = Money::FromWholeUnits(100);
+
+// Monotonic times (os_gettime_ns) at each pipeline stage, for latency tracing; 0 = unknown
+struct DonationTimestamps {
+    uint64_t publishedNs = 0;       // publishedAt mapped onto the monotonic clock on receipt
+    uint64_t receivedNs = 0;        // API response (or injected data) arrived
+    uint64_t parsedNs = 0;
+    uint64_t dispatchedNs = 0;      // Released by the ingestion hub's reorder queue
+    uint64_t configResolvedNs = 0;  // Effect configuration chosen
+    uint64_t effectStartedNs = 0;   // Effect applied to the scene
+    uint64_t firstFrameNs = 0;      // First video frame rendered after the effect started
 };
 
 struct DonationEvent {
     DonationType type;
-    double amount;          // Amount in JPY
+    Money amount;           // Amount in JPY
+    Money originalAmount;   // Amount in `currency`, as sent
     std::string displayName;
+    std::string authorChannelId;    // Empty for injected events
     std::string message;
     std::string currency;
+    std::string sourceId;       // Video ID of the chat the event came from
+    int64_t publishedAtMs = 0;  // When the message was posted (0 = unknown)
+    DonationTimestamps timestamps;
+};
+
+struct ChatPage;
+struct ChatPageMessage;
+class ChatSessionRecorder;
+class ChatSessionReplayer;
+class RecentIdSet;
+
+// Production endpoint; SetApiBaseUrl() can point the client at a local mock server
+#define DEFAULT_API_BASE_URL "https://www.googleapis.com"
+
+// Where chat monitoring left off for one video; persisted so a restart mid-stream resumes
+struct ChatCursor {
+    std::string liveChatId;
+    std::string pageToken;
+    int64_t watermarkMs = 0;    // publishedAt of the newest message seen
+};
+
+// Per-chat counters, read by the ingestion hub for per-source metrics
+struct ChatSourceStats {
+    uint64_t pagesReceived = 0;
+    uint64_t messagesReceived = 0;
+    uint64_t eventsDispatched = 0;
+    uint64_t duplicatesSuppressed = 0;
+    uint64_t requestFailures = 0;
+    int64_t lastPageAtMs = 0;
 };
 
 using DonationCallback = std::function<void(const DonationEvent&)>;
@@ -27,35 +78,86 @@ class YouTubeChatClient : public QObject {
 
 public:
     explicit YouTubeChatClient(QObject* parent = nullptr);
+    // Clients monitoring several chats share one connection pool and one API key quota
+    YouTubeChatClient(QNetworkAccessManager* network, std::shared_ptr<QuotaTracker> quota,
+                      QObject* parent = nullptr);
     ~YouTubeChatClient();
 
     void SetApiKey(const std::string& apiKey);
+    void SetApiBaseUrl(const std::string& baseUrl);
     void SetVideoId(const std::string& videoId);
+    const std::string& GetVideoId() const { return m_videoId; }
     void SetDonationCallback(DonationCallback callback);
 
     void Start();
     void Stop();
     bool IsRunning() const { return m_isRunning; }
 
+    // Quota planning: daily unit budget of the API key and expected stream length
+    void SetDailyQuota(int units) { m_quota->SetDailyBudget(units); }
+    void SetPlannedStreamHours(double hours) { m_scheduler->SetPlannedStreamHours(hours); }
+    QuotaTracker* GetQuotaTracker() const { return m_quota.get(); }
+    int GetPollIntervalMs() const { return m_scheduler->GetCurrentIntervalMs(); }
+    const ChatSourceStats& GetStats() const { return m_stats; }
+
+    // Consume the first (history) page after Start() without dispatching effects, and never
+    // dispatch messages posted before Start(), even when a restored pageToken returns them
+    void SetSkipBacklog(bool skip) { m_skipBacklog = skip; }
+
+    // Cursor for the current video; RestoreCursor() goes after SetVideoId() and before Start()
+    ChatCursor GetCursor() const;
+    void RestoreCursor(const ChatCursor& cursor);
+
+    // Record raw response pages to a session log while monitoring
+    void SetRecordingEnabled(bool enabled) { m_recordingEnabled = enabled; }
+
+    // Feed a recorded session log through the dispatch pipeline
+    // (speed: 1.0 = recorded timing, N = N times faster, <= 0 = as fast as possible)
+    bool StartReplay(const QString& path, double speed);
+    void StopReplay();
+    bool IsReplaying() const;
+
 private slots:
-    void PollChat();
     void OnChatDataReceived();
     void OnNetworkError(QNetworkReply::NetworkError error);
 
 private:
+    void PollChat();
     void FetchLiveChatId();
-    void ProcessChatMessages(const QJsonArray& items);
-    double ConvertCurrency(double amount, const std::string& currency);
+    void ReportFailure(QNetworkReply* reply, const QByteArray& body);
+    void BuildMessagesUrlPrefix();
+    void OnChatPageParsed(uint64_t generation, const ChatPage& page, bool backlogPage);
+    void ProcessChatMessages(const ChatPage& page, int64_t minPublishedMs = 0);
+    void ReplayPage(const char* data, size_t size);
+    void DispatchEvent(DonationEvent& event, const ChatPage& page, int64_t publishedAtMs);
+    bool SetAmount(DonationEvent& event, int64_t amountMicros);  // False if event.currency has no rate
 
     QNetworkAccessManager* m_networkManager;
-    QTimer* m_pollTimer;
+    QString m_apiBaseUrl;  // Scheme and host without trailing slash
+    std::shared_ptr<QuotaTracker> m_quota;
+    PollScheduler* m_scheduler;
 
     std::string m_apiKey;
     std::string m_videoId;
     std::string m_liveChatId;
     std::string m_nextPageToken;
+    int64_t m_watermarkMs;
+    bool m_skipBacklog;
+    int64_t m_startedAtMs;      // Wall clock of the last Start()
+    bool m_awaitingFirstPage;   // No page handled since the last Start()
+    QString m_messagesUrlPrefix;  // Rebuilt only when liveChatId or API key change
 
     DonationCallback m_donationCallback;
     bool m_isRunning;
-    int m_pollIntervalMs;
+    int m_pollIntervalMs;   // Last pollingIntervalMillis from the server
+
+    // A page counts as in flight (for the scheduler) until its worker-thread parse is handed back,
+    // so the same pageToken is never fetched twice
+    uint64_t m_pageGeneration;  // Bumped on Stop/SetVideoId to drop stale parse results
+
+    bool m_recordingEnabled;
+    std::unique_ptr<ChatSessionRecorder> m_recorder;
+    ChatSessionReplayer* m_replayer;
+    std::unique_ptr<RecentIdSet> m_recentIds;  // Message ids already dispatched
+    ChatSourceStats m_stats;
 };